@@ -0,0 +1,123 @@
+#pragma once
+#include "matrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @file bool_matrix.h
+/// @brief Macierz logiczna upakowana po 64 elementy w slowie
+///
+/// Wiersz zajmuje ceil(cols / 64) slow uint64_t; bit j % 64 slowa j / 64
+/// to element (i, j). Bity za ostatnia kolumna sa zawsze zerami, dzieki
+/// czemu operacje na calych slowach (AND, OR, XOR, popcount) nie wymagaja
+/// osobnej obslugi konca wiersza. Macierz zajmuje 64 razy mniej pamieci
+/// niz matrix o tych samych wymiarach.
+
+/// @class bool_matrix
+/// @brief Macierz wartosci logicznych, bit na element
+class bool_matrix {
+public:
+    /// @brief Typ slowa przechowujacego 64 elementy
+    using word = std::uint64_t;
+
+    /// @brief Liczba elementow w slowie
+    static constexpr std::size_t word_bits = 64;
+
+    /// @brief Konstruktor domyslny - macierz 0x0
+    bool_matrix() = default;
+
+    /// @brief Macierz rows x cols wypelniona falszem
+    bool_matrix(std::size_t r, std::size_t c)
+        : rows(r), cols(c), slowa((c + word_bits - 1) / word_bits), dane(r * slowa, 0) {}
+
+    /// @brief Konwersja z matrix: element rozny od zera to prawda
+    explicit bool_matrix(const matrix& m);
+
+    /// @brief Zwraca liczbe wierszy
+    std::size_t get_rows() const noexcept { return rows; }
+
+    /// @brief Zwraca liczbe kolumn
+    std::size_t get_cols() const noexcept { return cols; }
+
+    /// @brief Liczba slow w wierszu
+    std::size_t words_per_row() const noexcept { return slowa; }
+
+    /// @brief Odczyt elementu (i, j)
+    bool operator()(std::size_t i, std::size_t j) const noexcept {
+        return (dane[i * slowa + j / word_bits] >> (j % word_bits)) & 1u;
+    }
+
+    /// @brief Zapis elementu (i, j)
+    void set(std::size_t i, std::size_t j, bool v) noexcept {
+        word& w = dane[i * slowa + j / word_bits];
+        const word bit = word{1} << (j % word_bits);
+        w = v ? (w | bit) : (w & ~bit);
+    }
+
+    /// @brief Slowa wiersza i (do zapisu; bity za ostatnia kolumna musza pozostac zerami)
+    word* row_ptr(std::size_t i) noexcept { return dane.data() + i * slowa; }
+
+    /// @brief Slowa wiersza i (do odczytu)
+    const word* row_ptr(std::size_t i) const noexcept { return dane.data() + i * slowa; }
+
+    /// @brief Liczba elementow prawdziwych (popcount)
+    std::size_t count() const noexcept;
+
+    /// @brief Zamiana na matrix z elementami 0 i 1
+    matrix to_matrix() const;
+
+    /// @brief Iloczyn logiczny element po elemencie
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    bool_matrix& operator&=(const bool_matrix& m);
+
+    /// @brief Suma logiczna element po elemencie
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    bool_matrix& operator|=(const bool_matrix& m);
+
+    /// @brief Roznica symetryczna element po elemencie
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    bool_matrix& operator^=(const bool_matrix& m);
+
+    /// @brief Porownanie wszystkich elementow
+    bool operator==(const bool_matrix& m) const noexcept {
+        return rows == m.rows && cols == m.cols && dane == m.dane;
+    }
+
+    /// @brief Sprawdz, czy macierze sie roznia
+    bool operator!=(const bool_matrix& m) const noexcept { return !(*this == m); }
+
+private:
+    /// @brief Maska bitow uzywanych w ostatnim slowie wiersza
+    word maska_konca() const noexcept {
+        return cols % word_bits ? (word{1} << (cols % word_bits)) - 1 : ~word{0};
+    }
+
+    friend bool_matrix operator~(bool_matrix m);
+
+    std::size_t rows = 0, cols = 0, slowa = 0;
+    std::vector<word> dane;
+};
+
+/// @brief Iloczyn logiczny element po elemencie (AND)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+inline bool_matrix operator&(bool_matrix a, const bool_matrix& b) { return a &= b; }
+
+/// @brief Suma logiczna element po elemencie (OR)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+inline bool_matrix operator|(bool_matrix a, const bool_matrix& b) { return a |= b; }
+
+/// @brief Roznica symetryczna element po elemencie (XOR)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+inline bool_matrix operator^(bool_matrix a, const bool_matrix& b) { return a ^= b; }
+
+/// @brief Negacja wszystkich elementow
+bool_matrix operator~(bool_matrix m);
+
+/// @brief Iloczyn logiczny macierzy (OR-AND): C(i, j) = OR_p A(i, p) AND B(p, j)
+/// @throw std::runtime_error jesli A.cols != B.rows
+bool_matrix operator*(const bool_matrix& A, const bool_matrix& B);
+
+/// @brief Domkniecie przechodnie relacji (osiagalnosc w grafie): C(i, j) jest
+/// prawda, jesli istnieje sciezka i -> j dlugosci co najmniej 1
+/// @throw std::runtime_error jesli macierz nie jest kwadratowa
+bool_matrix transitive_closure(bool_matrix A);
@@ -0,0 +1,104 @@
+#pragma once
+#include "matrix.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// @file counter_rng.h
+/// @brief Licznikowy generator liczb losowych (Philox4x32-10) i wypelnianie macierzy
+///
+/// Generator licznikowy nie ma stanu przechodzacego z liczby na liczbe:
+/// blok nr b (cztery slowa 32-bitowe) jest funkcja (ziarno, strumien, b).
+/// Dzieki temu dowolny fragment ciagu mozna wyliczyc niezaleznie, wiec
+/// macierz jest wypelniana rownolegle i wektorowo, a wynik zalezy tylko od
+/// ziarna, strumienia i pozycji generatora - nie od liczby watkow ani ISA.
+///
+/// Element (i, j) macierzy rows x cols dostaje liczbe nr k = i * cols + j:
+/// 64-bitowa polowke k % 2 bloku position() + k / 2 (rozklad normalny
+/// zuzywa caly blok na pare elementow). Wypelnienie przesuwa generator
+/// o ceil(rows * cols / 2) blokow, wiec kolejne wywolania daja rozne liczby.
+
+/// @class philox_rng
+/// @brief Generator Philox4x32-10 (Salmon i in., SC'11) z ziarnem i strumieniem
+/// Ziarno jest kluczem szyfru, strumien - starsza polowa licznika, a pozycja -
+/// mlodsza; rozne strumienie tego samego ziarna daja niezalezne ciagi.
+/// Obiekt nie jest synchronizowany - kazdy watek powinien miec wlasny
+/// (np. ten sam seed i rozne stream).
+class philox_rng {
+public:
+    /// @brief Generator o zadanym ziarnie i numerze strumienia, na pozycji 0
+    /// @param seed Ziarno (klucz 64-bitowy)
+    /// @param stream Numer strumienia
+    explicit philox_rng(std::uint64_t seed = 0, std::uint64_t stream = 0) noexcept
+        : klucz(seed), strumien(stream) {}
+
+    /// @brief Zwraca ziarno
+    std::uint64_t seed() const noexcept { return klucz; }
+
+    /// @brief Zwraca numer strumienia
+    std::uint64_t stream() const noexcept { return strumien; }
+
+    /// @brief Numer nastepnego bloku
+    std::uint64_t position() const noexcept { return pozycja; }
+
+    /// @brief Ustaw numer nastepnego bloku
+    void set_position(std::uint64_t blok) noexcept { pozycja = blok; }
+
+    /// @brief Pomin `bloki` blokow
+    void discard(std::uint64_t bloki) noexcept { pozycja += bloki; }
+
+    /// @brief Nastepny blok czterech slow 32-bitowych
+    std::array<std::uint32_t, 4> operator()() noexcept;
+
+    /// @brief Wygeneruj n kolejnych blokow do out (2n slow 64-bitowych)
+    /// Blok b trafia do out[2b] = w1:w0 i out[2b + 1] = w3:w2; generator
+    /// przesuwa sie o n blokow.
+    /// @param out Bufor na co najmniej 2n liczb
+    /// @param n Liczba blokow
+    void generate(std::uint64_t* out, std::size_t n) noexcept;
+
+private:
+    std::uint64_t klucz;
+    std::uint64_t strumien;
+    std::uint64_t pozycja = 0;
+};
+
+/// @brief Wypelnij macierz liczbami o rozkladzie jednostajnym na [lo, hi)
+/// Liczba 53-bitowa u z [0, 1) jest skalowana do lo + u * (hi - lo);
+/// dla typow calkowitych wynik jest obcinany (lepiej uzyc fill_integers()).
+/// @param m Macierz wypelniana
+/// @param g Generator (przesuwany o ceil(rows * cols / 2) blokow)
+/// @param lo Dolna granica
+/// @param hi Gorna granica
+/// @return Referencja na m
+template <typename T>
+basic_matrix<T>& fill_uniform(basic_matrix<T>& m, philox_rng& g, double lo = 0.0, double hi = 1.0);
+
+/// @brief Wypelnij macierz liczbami o rozkladzie normalnym N(mean, stddev^2)
+/// Metoda Boxa-Mullera: kazdy blok daje pare niezaleznych liczb (cos, sin).
+/// @param m Macierz wypelniana
+/// @param g Generator (przesuwany o ceil(rows * cols / 2) blokow)
+/// @param mean Wartosc oczekiwana
+/// @param stddev Odchylenie standardowe
+/// @return Referencja na m
+template <typename T>
+basic_matrix<T>& fill_normal(basic_matrix<T>& m, philox_rng& g, double mean = 0.0, double stddev = 1.0);
+
+/// @brief Wypelnij macierz liczbami calkowitymi z [lo, hi] (oba konce wlacznie)
+/// Liczba 64-bitowa x jest mapowana na lo + (x * (hi - lo + 1)) >> 64, bez
+/// dzielenia modulo; odchylenie od rozkladu jednostajnego jest rzedu
+/// (hi - lo + 1) / 2^64.
+/// @param m Macierz wypelniana
+/// @param g Generator (przesuwany o ceil(rows * cols / 2) blokow)
+/// @param lo Najmniejsza wartosc
+/// @param hi Najwieksza wartosc
+/// @return Referencja na m
+/// @throw std::runtime_error jesli lo > hi lub zakres nie miesci sie w typie T
+template <typename T>
+basic_matrix<T>& fill_integers(basic_matrix<T>& m, philox_rng& g, std::int64_t lo, std::int64_t hi);
+
+/// @brief Ustaw ziarno wspolnego generatora uzywanego przez losuj()
+/// Bez wywolania ziarno jest losowane raz (std::random_device) przy
+/// pierwszym uzyciu; po seed_random(s) ciag wywolan losuj() jest powtarzalny.
+/// @param seed Ziarno
+void seed_random(std::uint64_t seed) noexcept;
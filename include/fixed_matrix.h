@@ -0,0 +1,228 @@
+#pragma once
+#include "matrix.h"
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// @file fixed_matrix.h
+/// @brief Macierz o wymiarach znanych w czasie kompilacji
+///
+/// fixed_matrix<R, C> przechowuje elementy w std::array wewnatrz obiektu
+/// (bez alokacji), a wszystkie operacje sa constexpr i rozwijane w czasie
+/// kompilacji, wiec np. iloczyn dwoch macierzy 4x4 kompiluje sie do ciagu
+/// 64 mnozen bez petli i skokow. Przeznaczona dla malych macierzy
+/// (transformacje 3x3, macierze jednorodne 4x4); dla duzych wymiarow
+/// rozwiniecie wydluza kompilacje i kod - nalezy uzyc matrix.
+
+namespace detail {
+
+template <typename F, std::size_t... I>
+constexpr void rozwin_impl(F& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<std::size_t, I>{}), ...);
+}
+
+/// @brief Wywoluje f(0), f(1), ..., f(N-1) jako rozwiniety ciag wywolan
+/// Indeks jest przekazywany jako std::integral_constant, wiec jest stala kompilacji.
+template <std::size_t N, typename F>
+constexpr void rozwin(F&& f) {
+    rozwin_impl(f, std::make_index_sequence<N>{});
+}
+
+} // namespace detail
+
+/// @class fixed_matrix
+/// @brief Macierz R x C o wymiarach stalych w czasie kompilacji
+/// @tparam R Liczba wierszy
+/// @tparam C Liczba kolumn
+template <std::size_t R, std::size_t C>
+class fixed_matrix {
+    static_assert(R > 0 && C > 0, "fixed_matrix wymaga dodatnich wymiarow");
+
+public:
+    /// @brief Konstruktor domyslny - macierz zerowa
+    constexpr fixed_matrix() noexcept : data{} {}
+
+    /// @brief Konstruktor wypelniajacy
+    /// @param value Wartosc wszystkich elementow
+    constexpr explicit fixed_matrix(double value) noexcept : data{} {
+        detail::rozwin<R * C>([&](auto i) { data[i] = value; });
+    }
+
+    /// @brief Konstruktor z listy inicjalizacyjnej
+    /// @param init Lista R wierszy po C wartosci
+    /// @throw std::runtime_error jesli wymiary listy sa inne niz R x C
+    constexpr fixed_matrix(std::initializer_list<std::initializer_list<double>> init) : data{} {
+        if (init.size() != R)
+            throw std::runtime_error("Niezgodne wymiary initializer_list");
+        std::size_t i = 0;
+        for (const auto& wiersz : init) {
+            if (wiersz.size() != C)
+                throw std::runtime_error("Niezgodne długości wierszy w initializer_list");
+            for (double v : wiersz) data[i++] = v;
+        }
+    }
+
+    /// @brief Konwersja z macierzy dynamicznej
+    /// @param m Macierz o wymiarach R x C
+    /// @throw std::runtime_error jesli wymiary m sa inne niz R x C
+    explicit fixed_matrix(const matrix& m) : data{} {
+        if (m.get_rows() != R || m.get_cols() != C)
+            throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+        for (std::size_t r = 0; r < R; ++r) {
+            for (std::size_t c = 0; c < C; ++c) {
+                data[r * C + c] = m(r, c);
+            }
+        }
+    }
+
+    /// @brief Konwersja do macierzy dynamicznej
+    /// @return Nowa macierz R x C z tymi samymi elementami
+    matrix to_matrix() const {
+        matrix m(R, C, bez_zerowania);
+        for (std::size_t r = 0; r < R; ++r) {
+            for (std::size_t c = 0; c < C; ++c) {
+                m(r, c) = data[r * C + c];
+            }
+        }
+        return m;
+    }
+
+    /// @brief Zwraca liczbe wierszy
+    static constexpr std::size_t get_rows() noexcept { return R; }
+
+    /// @brief Zwraca liczbe kolumn
+    static constexpr std::size_t get_cols() noexcept { return C; }
+
+    /// @brief Zwraca liczbe elementow
+    static constexpr std::size_t size() noexcept { return R * C; }
+
+    /// @brief Dostep do elementu (do zapisu)
+    constexpr double& operator()(std::size_t r, std::size_t c) noexcept { return data[r * C + c]; }
+
+    /// @brief Dostep do elementu (do odczytu)
+    constexpr double operator()(std::size_t r, std::size_t c) const noexcept { return data[r * C + c]; }
+
+    /// @brief Transpozycja w miejscu (tylko macierze kwadratowe)
+    /// @return Referencja na biezaca macierz
+    constexpr fixed_matrix& dowroc() noexcept {
+        static_assert(R == C, "Transpozycja in-place wymaga macierzy kwadratowej");
+        detail::rozwin<R * C>([&](auto idx) {
+            constexpr std::size_t i = idx / C, j = idx % C;
+            if constexpr (j > i) {
+                const double t = data[i * C + j];
+                data[i * C + j] = data[j * C + i];
+                data[j * C + i] = t;
+            }
+        });
+        return *this;
+    }
+
+    /// @brief Transpozycja do nowej macierzy (takze prostokatnych)
+    /// @return Macierz C x R
+    constexpr fixed_matrix<C, R> transponowana() const noexcept {
+        fixed_matrix<C, R> t;
+        detail::rozwin<R * C>([&](auto idx) {
+            constexpr std::size_t i = idx / C, j = idx % C;
+            t.data[j * R + i] = data[idx];
+        });
+        return t;
+    }
+
+    /// @brief Dodaj macierz element po elemencie (w miejscu)
+    constexpr fixed_matrix& operator+=(const fixed_matrix& m) noexcept {
+        detail::rozwin<R * C>([&](auto i) { data[i] += m.data[i]; });
+        return *this;
+    }
+
+    /// @brief Odejmij macierz element po elemencie (w miejscu)
+    constexpr fixed_matrix& operator-=(const fixed_matrix& m) noexcept {
+        detail::rozwin<R * C>([&](auto i) { data[i] -= m.data[i]; });
+        return *this;
+    }
+
+    /// @brief Pomnoz wszystkie elementy przez skalar (w miejscu)
+    constexpr fixed_matrix& operator*=(double a) noexcept {
+        detail::rozwin<R * C>([&](auto i) { data[i] *= a; });
+        return *this;
+    }
+
+    /// @brief Elementy macierzy wierszami
+    std::array<double, R * C> data;
+};
+
+/// @brief Dodawanie macierzy - A + B
+template <std::size_t R, std::size_t C>
+constexpr fixed_matrix<R, C> operator+(fixed_matrix<R, C> a, const fixed_matrix<R, C>& b) noexcept {
+    return a += b;
+}
+
+/// @brief Odejmowanie macierzy - A - B
+template <std::size_t R, std::size_t C>
+constexpr fixed_matrix<R, C> operator-(fixed_matrix<R, C> a, const fixed_matrix<R, C>& b) noexcept {
+    return a -= b;
+}
+
+/// @brief Mnozenie przez skalar - A * a
+template <std::size_t R, std::size_t C>
+constexpr fixed_matrix<R, C> operator*(fixed_matrix<R, C> m, double a) noexcept {
+    return m *= a;
+}
+
+/// @brief Mnozenie przez skalar z lewej - a * A
+template <std::size_t R, std::size_t C>
+constexpr fixed_matrix<R, C> operator*(double a, fixed_matrix<R, C> m) noexcept {
+    return m *= a;
+}
+
+/// @brief Mnozenie macierzy - A * B, w pelni rozwiniete
+/// Kolejnosc sumowania (p = 0..K-1) jest taka sama jak w matrix::operator*,
+/// wiec wyniki obu klas sa identyczne.
+/// @return Macierz R x C
+template <std::size_t R, std::size_t K, std::size_t C>
+constexpr fixed_matrix<R, C> operator*(const fixed_matrix<R, K>& a, const fixed_matrix<K, C>& b) noexcept {
+    fixed_matrix<R, C> w;
+    detail::rozwin<R * C>([&](auto idx) {
+        constexpr std::size_t i = idx / C, j = idx % C;
+        double suma = 0.0;
+        detail::rozwin<K>([&](auto p) { suma += a.data[i * K + p] * b.data[p * C + j]; });
+        w.data[idx] = suma;
+    });
+    return w;
+}
+
+/// @brief Porownanie rownosci wszystkich elementow
+template <std::size_t R, std::size_t C>
+constexpr bool operator==(const fixed_matrix<R, C>& a, const fixed_matrix<R, C>& b) noexcept {
+    bool rowne = true;
+    detail::rozwin<R * C>([&](auto i) { rowne = rowne && a.data[i] == b.data[i]; });
+    return rowne;
+}
+
+/// @brief Porownanie nierownosci
+template <std::size_t R, std::size_t C>
+constexpr bool operator!=(const fixed_matrix<R, C>& a, const fixed_matrix<R, C>& b) noexcept {
+    return !(a == b);
+}
+
+/// @brief Wypisz macierz na strumien (format jak dla matrix)
+template <std::size_t R, std::size_t C>
+ostream& operator<<(ostream& o, const fixed_matrix<R, C>& m) {
+    for (std::size_t i = 0; i < R; i++) {
+        for (std::size_t j = 0; j < C; j++) {
+            o << m(i, j);
+            if (j < C - 1) o << " ";
+        }
+        o << endl;
+    }
+    return o;
+}
+
+/// @brief Macierz 3x3 (np. transformacje w 2D we wspolrzednych jednorodnych)
+using matrix3 = fixed_matrix<3, 3>;
+
+/// @brief Macierz 4x4 (np. transformacje w 3D we wspolrzednych jednorodnych)
+using matrix4 = fixed_matrix<4, 4>;
@@ -0,0 +1,173 @@
+#pragma once
+#include "matrix.h"
+#include <cstddef>
+#include <vector>
+
+/// @file layout_matrix.h
+/// @brief Macierz gesta z wybieranym ukladem elementow w pamieci
+///
+/// `matrix` przechowuje elementy zawsze wierszami, wiec przejscie po
+/// kolumnie (kolumna(), sumy kolumn) dotyka osobnej linii cache na kazdy
+/// element. `layout_matrix` pozwala wybrac uklad pod sposob uzycia:
+///
+/// - `row_major` - wiersze ciagle, jak matrix;
+/// - `col_major` - kolumny ciagle (analizy kolumnowe, dane w stylu Fortranu);
+/// - `tiled` - kafelki tile x tile ulozone w kolejnosci Z (Morton), wiersze
+///   ciagle wewnatrz kafelka; sasiednie kafelki leza blisko w pamieci
+///   w obu kierunkach, a kafelek jest naturalna jednostka pracy watku.
+///
+/// Kazdy uklad udostepnia kafelki jako widoki (tile_view()), wiec konwersje,
+/// mnozenie i redukcje pracuja na kafelkach niezaleznie od ukladu, a kroki
+/// widoku wybieraja sposob dostepu (memcpy wierszy, blokowa transpozycja
+/// SIMD, pakowanie GEMM kolumnami). Dla row_major i col_major view() zwraca
+/// widok calej macierzy (w col_major - z zamienionymi krokami, jak
+/// transpose()), ktory wchodzi do wyrazen, gemm i porownan jak kazdy inny.
+
+/// @brief Uklad elementow macierzy w pamieci
+enum class storage_layout {
+    row_major, ///< wierszami (jak matrix)
+    col_major, ///< kolumnami
+    tiled      ///< kafelkami tile x tile w kolejnosci Z (Morton)
+};
+
+/// @class layout_matrix
+/// @brief Macierz double o ukladzie row_major, col_major albo tiled
+class layout_matrix {
+public:
+    /// @brief Bok kafelka (128 x 128 double = 128 KiB - kafelek miesci sie w L2)
+    static constexpr std::size_t tile = 128;
+
+    /// @brief Konstruktor domyslny - macierz 0x0 wierszami
+    layout_matrix() = default;
+
+    /// @brief Macierz zerowa rows x cols o zadanym ukladzie
+    /// @param rows Liczba wierszy
+    /// @param cols Liczba kolumn
+    /// @param layout Uklad elementow
+    layout_matrix(std::size_t rows, std::size_t cols, storage_layout layout = storage_layout::row_major);
+
+    /// @brief Kopia macierzy (lub fragmentu) w zadanym ukladzie
+    /// @param m Macierz lub widok zrodlowy
+    /// @param layout Uklad elementow
+    explicit layout_matrix(const_matrix_view m, storage_layout layout = storage_layout::row_major);
+
+    /// @brief Zwraca liczbe wierszy
+    std::size_t get_rows() const noexcept { return rows; }
+
+    /// @brief Zwraca liczbe kolumn
+    std::size_t get_cols() const noexcept { return cols; }
+
+    /// @brief Zwraca uklad elementow
+    storage_layout layout() const noexcept { return uklad; }
+
+    /// @brief Liczba wierszy kafelkow (ceil(rows / tile))
+    std::size_t tile_rows() const noexcept { return kafle_r; }
+
+    /// @brief Liczba kolumn kafelkow (ceil(cols / tile))
+    std::size_t tile_cols() const noexcept { return kafle_c; }
+
+    /// @brief Element (i, j); indeksy nie sa sprawdzane
+    double& operator()(std::size_t i, std::size_t j) noexcept { return dane[indeks(i, j)]; }
+
+    /// @brief Element (i, j) do odczytu; indeksy nie sa sprawdzane
+    double operator()(std::size_t i, std::size_t j) const noexcept { return dane[indeks(i, j)]; }
+
+    /// @brief Widok calej macierzy (row_major: wiersze ciagle, col_major: kolumny ciagle)
+    /// @throw std::runtime_error dla ukladu tiled
+    matrix_view view();
+
+    /// @brief Widok calej macierzy tylko do odczytu
+    /// @throw std::runtime_error dla ukladu tiled
+    const_matrix_view view() const;
+
+    /// @brief Kafelek (ti, tj) jako widok (brzegowe kafelki sa mniejsze)
+    /// Dostepny w kazdym ukladzie; w tiled wiersze kafelka sa ciagle i sasiaduja.
+    /// @throw std::runtime_error jesli kafelek wykracza poza macierz
+    matrix_view tile_view(std::size_t ti, std::size_t tj);
+
+    /// @brief Kafelek (ti, tj) jako widok tylko do odczytu
+    /// @throw std::runtime_error jesli kafelek wykracza poza macierz
+    const_matrix_view tile_view(std::size_t ti, std::size_t tj) const;
+
+    /// @brief Ta sama macierz w ukladzie `layout` (kopia, jesli uklad jest ten sam)
+    /// Kafelki sa przepisywane rownolegle: wiersze ciagle przez memcpy,
+    /// zmiana wierszy na kolumny - blokowa transpozycja SIMD.
+    layout_matrix to_layout(storage_layout layout) const;
+
+    /// @brief Zamiana na matrix (wiersze ciagle)
+    matrix to_matrix() const;
+
+    /// @brief Sumy kolumn (cols liczb)
+    /// W col_major kazda kolumna jest czytana ciagle, w row_major wiersze
+    /// sa dodawane do wektora sum jadrem axpy, w tiled - kafelkami.
+    std::vector<double> col_sums() const;
+
+    /// @brief Sumy wierszy (rows liczb); dostep dobierany do ukladu jak w col_sums()
+    std::vector<double> row_sums() const;
+
+    /// @brief Dodaj macierz element po elemencie (B jest najpierw sprowadzana do ukladu A)
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    layout_matrix& operator+=(const layout_matrix& m);
+
+    /// @brief Odejmij macierz element po elemencie (B jest najpierw sprowadzana do ukladu A)
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    layout_matrix& operator-=(const layout_matrix& m);
+
+    /// @brief Dodaj skalar do wszystkich elementow
+    layout_matrix& operator+=(double a) noexcept;
+
+    /// @brief Pomnoz wszystkie elementy przez skalar
+    layout_matrix& operator*=(double a) noexcept;
+
+private:
+    /// @brief Pozycja elementu (i, j) w tablicy danych
+    std::size_t indeks(std::size_t i, std::size_t j) const noexcept {
+        switch (uklad) {
+        case storage_layout::row_major: return i * ld + j;
+        case storage_layout::col_major: return j * ld + i;
+        default:
+            return kolejnosc[(i / tile) * kafle_c + j / tile] * (tile * tile) + (i % tile) * tile + j % tile;
+        }
+    }
+
+    /// @brief Wykonuje f(z, w, n) na kolejnych fragmentach tablic danych (rownolegle)
+    template <typename F>
+    void po_danych(const layout_matrix* m, F f);
+
+    std::size_t rows = 0, cols = 0;
+    storage_layout uklad = storage_layout::row_major;
+    /// @brief Krok wiersza (row_major) lub kolumny (col_major), wielokrotnosc 8
+    std::size_t ld = 0;
+    std::size_t kafle_r = 0, kafle_c = 0;
+    /// @brief Pozycja kafelka (ti, tj) w kolejnosci Z - tylko tiled
+    std::vector<std::size_t> kolejnosc;
+    std::vector<double> dane;
+};
+
+/// @brief Iloczyn A * B; wynik ma uklad A
+/// Dla row_major / col_major operandy trafiaja do gemm() jako widoki
+/// (kroki wybieraja pakowanie wierszami lub kolumnami), bez zmiany ukladu.
+/// Jesli ktorys operand jest tiled, kafelki wyniku sa rozdzielane miedzy
+/// watki, a kazdy liczy sume iloczynow kafelkow A i B (tile-parallel GEMM).
+/// @throw std::runtime_error jesli A.cols != B.rows
+layout_matrix operator*(const layout_matrix& A, const layout_matrix& B);
+
+/// @brief Suma element po elemencie; wynik ma uklad A
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+inline layout_matrix operator+(layout_matrix A, const layout_matrix& B) { return A += B; }
+
+/// @brief Roznica element po elemencie; wynik ma uklad A
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+inline layout_matrix operator-(layout_matrix A, const layout_matrix& B) { return A -= B; }
+
+/// @brief Iloczyn macierzy i skalara
+inline layout_matrix operator*(layout_matrix A, double s) { return A *= s; }
+
+/// @brief Iloczyn skalara i macierzy
+inline layout_matrix operator*(double s, layout_matrix A) { return A *= s; }
+
+/// @brief Porownanie wszystkich elementow (uklady moga sie roznic)
+bool operator==(const layout_matrix& A, const layout_matrix& B);
+
+/// @brief Sprawdz, czy macierze sie roznia
+inline bool operator!=(const layout_matrix& A, const layout_matrix& B) { return !(A == B); }
@@ -1,49 +1,184 @@
 #pragma once
 #include <memory>
 #include <vector>
+#include <functional>
 #include <cstddef>
 #include <initializer_list>
 #include <ostream>
+#include <cstdint>
+#include <new>
+#include <type_traits>
 
 using namespace std;
 
-/// @class matrix
-/// @brief Klasa reprezentujaca macierz liczb zmiennoprzecinkowych
+template <typename E>
+struct matrix_expr;
+
+template <typename T>
+class basic_matrix;
+
+template <typename T>
+class basic_matrix_view;
+
+namespace detail {
+template <typename E>
+void wylicz(E& e, basic_matrix<double>& wynik, bool przejmuj);
+} // namespace detail
+
+/// @brief Znacznik konstruktora, ktory nie zeruje elementow
+struct bez_zerowania_t {
+    explicit bez_zerowania_t() = default;
+};
+
+/// @brief Instancja znacznika dla konstruktora basic_matrix(rows, cols, bez_zerowania)
+inline constexpr bez_zerowania_t bez_zerowania{};
+
+/// @brief Typ akumulatora iloczynow skalarnych dla elementow typu T
+/// Typy calkowite akumuluja w typie szerszym, wiec iloczyn macierzy jest
+/// dokladny: int8 -> int32 (dla k < 131072), int32 -> int64.
+template <typename T>
+struct akumulator {
+    using type = T;
+};
+
+template <>
+struct akumulator<std::int8_t> {
+    using type = std::int32_t;
+};
+
+template <>
+struct akumulator<std::int32_t> {
+    using type = std::int64_t;
+};
+
+template <typename T>
+using akumulator_t = typename akumulator<T>::type;
+
+/// @class basic_matrix
+/// @brief Klasa reprezentujaca macierz elementow typu T
 /// Klasa zapewnia operacje macierzowe oraz zaawansowane funkcjonalnosci
 /// do manipulacji danymi macierzy.
-class matrix {
+///
+/// Obslugiwane typy elementow: double (alias matrix), float, std::int8_t,
+/// std::int32_t i std::int64_t. Jadra SIMD, silnik GEMM i leniwe wyrazenia
+/// (zob. matrix_expr.h) dzialaja dla double; pozostale typy uzywaja
+/// prostych petli, a operatory element po elemencie licza wynik od razu.
+/// Iloczyn macierzy ma elementy typu akumulator_t<T>.
+///
+/// @tparam T Typ elementu
+template <typename T>
+class basic_matrix {
 public:
+    /// @brief Typ elementu
+    using value_type = T;
+
     /// @brief Konstruktor domyslny
     /// Tworzy macierz z wartosciami domyslnymi
-    matrix() noexcept;
+    basic_matrix() noexcept;
     
     /// @brief Konstruktor parametryzowany
     /// @param rows Liczba wierszy macierzy
     /// @param cols Liczba kolumn macierzy
-    /// @param value Wartosc inicjujaca wszystkie elementy (domyslnie 0.0)
-    matrix(std::size_t rows, std::size_t cols, double value = 0.0);
+    /// @param value Wartosc inicjujaca wszystkie elementy (domyslnie 0)
+    basic_matrix(std::size_t rows, std::size_t cols, T value = T());
+
+    /// @brief Konstruktor bez inicjalizacji elementow
+    /// Elementy maja nieokreslona wartosc i musza zostac nadpisane;
+    /// zerowane jest tylko dopelnienie wierszy do `stride`.
+    /// @param rows Liczba wierszy macierzy
+    /// @param cols Liczba kolumn macierzy
+    basic_matrix(std::size_t rows, std::size_t cols, bez_zerowania_t);
     
     /// @brief Konstruktor z listy inicjalizacyjnej
     /// @param init Lista zagniezdzona zawierajaca wartosci macierzy
-    matrix(std::initializer_list<std::initializer_list<double>> init);
+    basic_matrix(std::initializer_list<std::initializer_list<T>> init);
 
     /// @brief Konstruktor kopiujacy
     /// @param other Macierz do skopiowania
-    matrix(const matrix& other);
+    basic_matrix(const basic_matrix& other);
+
+    /// @brief Konwersja z macierzy o innym typie elementu
+    /// Elementy sa konwertowane przez static_cast (np. float -> double
+    /// bez straty, double -> int8 z obcieciem).
+    /// @param other Macierz zrodlowa
+    template <typename U, typename = std::enable_if_t<!std::is_same_v<U, T>>>
+    explicit basic_matrix(const basic_matrix<U>& other) : basic_matrix(other.get_rows(), other.get_cols(), bez_zerowania) {
+        for (std::size_t i = 0; i < get_rows(); ++i) {
+            const U* z = other.row_ptr(i);
+            T* w = row_ptr(i);
+            for (std::size_t j = 0; j < get_cols(); ++j) w[j] = static_cast<T>(z[j]);
+        }
+    }
     
     /// @brief Operator przypisania (kopiowanie)
     /// @param other Macierz do skopiowania
     /// @return Referencja na biezaca macierz
-    matrix& operator=(const matrix& other);
-    
+    basic_matrix& operator=(const basic_matrix& other);
+    
+    /// @brief Konstruktor z wyrazenia - wylicza wyrazenie w jednym przebiegu (tylko double)
+    /// @param e Wyrazenie element po elemencie
+    template <typename E, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix(const matrix_expr<E>& e) : basic_matrix() {
+        E kopia = e.self();
+        detail::wylicz(kopia, *this, false);
+    }
+
+    /// @brief Konstruktor z wyrazenia tymczasowego
+    /// Jesli wyrazenie zawiera macierz tymczasowa (np. `std::move(A) * 2`),
+    /// jej bufor jest przejmowany i nie dochodzi do alokacji.
+    /// @param e Wyrazenie element po elemencie
+    template <typename E, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix(matrix_expr<E>&& e) : basic_matrix() {
+        detail::wylicz(e.self(), *this, true);
+    }
+
+    /// @brief Przypisanie wyrazenia - wylicza je do istniejacego bufora
+    /// Przy zgodnych wymiarach nie alokuje pamieci; macierz moze wystepowac
+    /// w wyrazeniu (np. `A = A * 2 + B`).
+    /// @param e Wyrazenie element po elemencie
+    /// @return Referencja na biezaca macierz
+    template <typename E, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix& operator=(const matrix_expr<E>& e) {
+        E kopia = e.self();
+        detail::wylicz(kopia, *this, false);
+        return *this;
+    }
+
+    /// @brief Przypisanie wyrazenia tymczasowego
+    /// Jak wersja z const&, ale przy niezgodnych wymiarach moze przejac
+    /// bufor macierzy tymczasowej z wyrazenia zamiast alokowac nowy.
+    /// @param e Wyrazenie element po elemencie
+    /// @return Referencja na biezaca macierz
+    template <typename E, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix& operator=(matrix_expr<E>&& e) {
+        detail::wylicz(e.self(), *this, true);
+        return *this;
+    }
+
     /// @brief Konstruktor przenoszacy
-    matrix(matrix&&) noexcept = default;
+    basic_matrix(basic_matrix&& other) noexcept;
     
     /// @brief Operator przypisania (przenoszenie)
-    matrix& operator=(matrix&&) noexcept = default;
+    basic_matrix& operator=(basic_matrix&& other) noexcept;
+
+    /// @brief Konstruktor z widoku - kopia jego elementow w ciaglych wierszach
+    /// Pozwala pisac `matrix B = A.transpose();` lub `matrix B = A.block(...)`;
+    /// widok transpose() jest kopiowany blokowa transpozycja SIMD.
+    /// @param v Widok do skopiowania
+    template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T>>>
+    basic_matrix(const basic_matrix_view<U>& v);
+
+    /// @brief Przypisanie widoku - jawna kopia jego elementow do ciaglych wierszy
+    /// Dopasowuje wymiary (przy zgodnych nie alokuje); widok transpose() jest
+    /// kopiowany blokowa transpozycja SIMD. Widok moze wskazywac na elementy
+    /// tej samej macierzy (np. `A = A.transpose()`).
+    /// @param v Widok do skopiowania
+    /// @return Referencja na biezaca macierz
+    template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T>>>
+    basic_matrix& operator=(const basic_matrix_view<U>& v);
     
     /// @brief Destruktor
-    ~matrix() = default;
+    ~basic_matrix() = default;
 
     /// @brief Zwraca liczbe wierszy
     /// @return Liczba wierszy macierzy
@@ -57,6 +192,10 @@ public:
     /// @return Calkowita liczba elementow (wiersze * kolumny)
     std::size_t size() const noexcept { return rows * cols; }
 
+    /// @brief Zwraca odstep miedzy poczatkami kolejnych wierszy
+    /// @return Liczba elementow (nie bajtow) w jednym wierszu bufora
+    std::size_t get_stride() const noexcept { return stride; }
+
     /// @brief Alokuje pamiec dla macierzy
     /// @param n Liczba elementow do alokacji
     void alokuj(std::size_t n);
@@ -65,112 +204,190 @@ public:
     /// @param r Indeks wiersza
     /// @param c Indeks kolumny
     /// @return Referencja na element macierzy
-    double& operator()(std::size_t r, std::size_t c);
+    T& operator()(std::size_t r, std::size_t c) { return data[r * stride + c]; }
     
     /// @brief Dostep do elementu macierzy (do odczytu)
     /// @param r Indeks wiersza
     /// @param c Indeks kolumny
     /// @return Wartosc elementu macierzy
-    double operator()(std::size_t r, std::size_t c) const;
+    T operator()(std::size_t r, std::size_t c) const { return data[r * stride + c]; }
+
+    /// @brief Wskaznik na poczatek wiersza (do zapisu)
+    /// @param r Indeks wiersza
+    /// @return Wskaznik na pierwszy element wiersza, wyrownany do 64 bajtow
+    T* row_ptr(std::size_t r) noexcept { return data.get() + r * stride; }
+
+    /// @brief Wskaznik na poczatek wiersza (do odczytu)
+    /// @param r Indeks wiersza
+    /// @return Wskaznik na pierwszy element wiersza, wyrownany do 64 bajtow
+    const T* row_ptr(std::size_t r) const noexcept { return data.get() + r * stride; }
+
+    /// @brief Widok calej macierzy (do zapisu)
+    basic_matrix_view<T> view() noexcept;
+
+    /// @brief Widok calej macierzy (do odczytu)
+    basic_matrix_view<const T> view() const noexcept;
+
+    /// @brief Widok bloku nr x nc o lewym gornym rogu (r0, c0), bez kopiowania
+    /// @throw std::runtime_error jesli blok wykracza poza macierz
+    basic_matrix_view<T> block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc);
+
+    /// @brief Widok bloku nr x nc o lewym gornym rogu (r0, c0) (do odczytu)
+    /// @throw std::runtime_error jesli blok wykracza poza macierz
+    basic_matrix_view<const T> block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc) const;
+
+    /// @brief Widok wierszy od r0 do r0 + nr - 1
+    /// @throw std::runtime_error jesli zakres wykracza poza macierz
+    basic_matrix_view<T> row_block(std::size_t r0, std::size_t nr);
+
+    /// @brief Widok wierszy od r0 do r0 + nr - 1 (do odczytu)
+    /// @throw std::runtime_error jesli zakres wykracza poza macierz
+    basic_matrix_view<const T> row_block(std::size_t r0, std::size_t nr) const;
+
+    /// @brief Widok kolumn od c0 do c0 + nc - 1
+    /// @throw std::runtime_error jesli zakres wykracza poza macierz
+    basic_matrix_view<T> col_block(std::size_t c0, std::size_t nc);
+
+    /// @brief Widok kolumn od c0 do c0 + nc - 1 (do odczytu)
+    /// @throw std::runtime_error jesli zakres wykracza poza macierz
+    basic_matrix_view<const T> col_block(std::size_t c0, std::size_t nc) const;
+
+    /// @brief Widok wiersza i (1 x cols)
+    /// @throw std::runtime_error jesli i >= rows
+    basic_matrix_view<T> row(std::size_t i);
+
+    /// @brief Widok wiersza i (do odczytu)
+    /// @throw std::runtime_error jesli i >= rows
+    basic_matrix_view<const T> row(std::size_t i) const;
+
+    /// @brief Widok kolumny j (rows x 1, elementy co stride)
+    /// @throw std::runtime_error jesli j >= cols
+    basic_matrix_view<T> col(std::size_t j);
+
+    /// @brief Widok kolumny j (do odczytu)
+    /// @throw std::runtime_error jesli j >= cols
+    basic_matrix_view<const T> col(std::size_t j) const;
+
+    /// @brief Transpozycja jako widok (cols x rows) - O(1), bez przenoszenia danych
+    /// Widok ma zamienione kroki wiersza i kolumny; dostep do elementow,
+    /// mnozenie (pakowanie paneli) i wyrazenia korzystaja z nich wprost.
+    /// Ciagla kopie tworzy `transpose().to_matrix()` lub transpose_into().
+    basic_matrix_view<T> transpose() noexcept;
+
+    /// @brief Transpozycja jako widok tylko do odczytu - O(1)
+    basic_matrix_view<const T> transpose() const noexcept;
 
-    /// @brief Dodawanie dwoch macierzy
-    /// @param m Macierz do dodania
-    /// @return Referencja na wynik (macierz zmieniona)
-    matrix& operator+(matrix& m);
-    
     /// @brief Mnozenie dwoch macierzy
+    /// Dla typow calkowitych iloczyny sa sumowane w akumulator_t<T>,
+    /// wiec wynik jest dokladny.
     /// @param m Macierz do pomnozenia
-    /// @return Referencja na wynik (macierz zmieniona)
-    matrix& operator*(matrix& m);
-    
-    /// @brief Dodawanie skalara do macierzy
-    /// @param a Wartosc skalara
-    /// @return Referencja na wynik (macierz zmieniona)
-    matrix& operator+(int a);
-    
-    /// @brief Mnozenie macierzy przez skalar
-    /// @param a Wartosc skalara
-    /// @return Referencja na wynik (macierz zmieniona)
-    matrix& operator*(int a);
-    
-    /// @brief Odejmowanie skalara od macierzy
-    /// @param a Wartosc skalara
-    /// @return Referencja na wynik (macierz zmieniona)
-    matrix& operator-(int a);
-
-    /// @brief Dodawanie skalara do macierzy (skalar z lewej)
-    /// @param a Wartosc skalara
-    /// @param m Macierz
-    /// @return Wynik operacji
-    friend matrix operator+(int a, matrix& m);
-    
-    /// @brief Mnozenie macierzy przez skalar (skalar z lewej)
-    /// @param a Wartosc skalara
-    /// @param m Macierz
-    /// @return Wynik operacji
-    friend matrix operator*(int a, matrix& m);
-    
-    /// @brief Odejmowanie macierzy od skalara
-    /// @param a Wartosc skalara
-    /// @param m Macierz
-    /// @return Wynik operacji
-    friend matrix operator-(int a, matrix& m);
+    /// @return Nowa macierz z iloczynem (elementy typu akumulator_t<T>)
+    basic_matrix<akumulator_t<T>> operator*(const basic_matrix& m) const;
+
+    /// @brief Mnozenie przez fragment innej macierzy (tylko double) - bez kopii widoku
+    /// @param v Widok prawego operandu
+    /// @return Nowa macierz z iloczynem
+    template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T> &&
+                                                      std::is_same_v<T, double>>>
+    basic_matrix operator*(const basic_matrix_view<U>& v) const;
 
     /// @brief Inkrementacja wszystkich elementow (operator postfixowy)
     /// @return Referencja na macierz przed zmiana
-    matrix& operator++(int);
+    basic_matrix& operator++(int);
     
     /// @brief Dekrementacja wszystkich elementow (operator postfixowy)
     /// @return Referencja na macierz przed zmiana
-    matrix& operator--(int);
+    basic_matrix& operator--(int);
+
+    /// @brief Dodaj macierz element po elemencie (w miejscu)
+    /// @param m Macierz o tych samych wymiarach
+    /// @return Referencja na zmieniona macierz
+    basic_matrix& operator+=(const basic_matrix& m);
+
+    /// @brief Odejmij macierz element po elemencie (w miejscu)
+    /// @param m Macierz o tych samych wymiarach
+    /// @return Referencja na zmieniona macierz
+    basic_matrix& operator-=(const basic_matrix& m);
+
+    /// @brief Dodaj fragment macierzy (widok) element po elemencie (tylko double)
+    /// Widok moze wskazywac na te sama macierz (np. `A += A.transpose()`).
+    /// @param v Widok o wymiarach macierzy
+    /// @return Referencja na zmieniona macierz
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T> &&
+                                                      std::is_same_v<T, double>>>
+    basic_matrix& operator+=(const basic_matrix_view<U>& v);
+
+    /// @brief Odejmij fragment macierzy (widok) element po elemencie (tylko double)
+    /// @param v Widok o wymiarach macierzy
+    /// @return Referencja na zmieniona macierz
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T> &&
+                                                      std::is_same_v<T, double>>>
+    basic_matrix& operator-=(const basic_matrix_view<U>& v);
+
+    /// @brief Dodaj wyrazenie element po elemencie w jednym przebiegu, bez macierzy posredniej
+    /// @param e Wyrazenie o wymiarach macierzy
+    /// @return Referencja na zmieniona macierz
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename E, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix& operator+=(const matrix_expr<E>& e);
+
+    /// @brief Odejmij wyrazenie element po elemencie w jednym przebiegu, bez macierzy posredniej
+    /// @param e Wyrazenie o wymiarach macierzy
+    /// @return Referencja na zmieniona macierz
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename E, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix& operator-=(const matrix_expr<E>& e);
 
     /// @brief Dodaj skalar do wszystkich elementow
     /// @param a Wartosc skalara do dodania
     /// @return Referencja na zmieniona macierz
-    matrix& operator+=(int a);
+    basic_matrix& operator+=(T a);
     
     /// @brief Odejmij skalar od wszystkich elementow
     /// @param a Wartosc skalara do odjecia
     /// @return Referencja na zmieniona macierz
-    matrix& operator-=(int a);
+    basic_matrix& operator-=(T a);
     
     /// @brief Pomnozy wszystkie elementy przez skalar
     /// @param a Wartosc skalara do mnozenia
     /// @return Referencja na zmieniona macierz
-    matrix& operator*=(int a);
+    basic_matrix& operator*=(T a);
 
-    /// @brief Ustaw wszystkie elementy na dana wartosc
-    /// @param value Wartosc do ustawienia
+    /// @brief Dodaj czesc calkowita wartosci do wszystkich elementow
+    /// @param value Wartosc, ktorej czesc calkowita jest dodawana
     /// @return Referencja na zmieniona macierz
-    matrix& operator()(double value);
-
-    /// @brief Wypisz macierz na strumien wyjsciowy
-    /// @param o Strumien wyjsciowy
-    /// @param m Macierz do wypisania
-    /// @return Strumien wyjsciowy
-    friend ostream& operator<<(ostream& o, matrix& m);
+    basic_matrix& operator()(double value);
 
     /// @brief Sprawdz czy dwie macierze sa rowne
     /// @param m Macierz do porownania
     /// @return Prawda jesli macierze sa rowne
-    bool operator==(const matrix& m);
+    bool operator==(const basic_matrix& m) const;
+
+    /// @brief Porownaj z fragmentem macierzy (tylko double)
+    /// @param v Widok do porownania
+    /// @return Prawda, jesli wymiary i wszystkie elementy sa rowne
+    template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T> &&
+                                                      std::is_same_v<T, double>>>
+    bool operator==(const basic_matrix_view<U>& v) const;
     
     /// @brief Sprawdz czy macierz jest wieksza niz druga
     /// @param m Macierz do porownania
     /// @return Prawda jesli warunek jest spelniony
-    bool operator>(const matrix& m);
+    bool operator>(const basic_matrix& m) const;
     
     /// @brief Sprawdz czy macierz jest mniejsza niz druga
     /// @param m Macierz do porownania
     /// @return Prawda jesli warunek jest spelniony
-    bool operator<(const matrix& m);
+    bool operator<(const basic_matrix& m) const;
 
     /// @brief Wstaw wartosc w okreslone miejsce
     /// @param x Indeks wiersza
     /// @param y Indeks kolumny
     /// @param wartosc Wartosc do wstawienia
     /// @return Referencja na zmieniona macierz
-    matrix& wstaw(int x, int y, int wartosc);
+    basic_matrix& wstaw(int x, int y, int wartosc);
     
     /// @brief Pokaz wartosc z danego miejsca
     /// @param x Indeks wiersza
@@ -178,57 +395,62 @@ public:
     /// @return Wartosc z okreslonych wspolrzednych
     int pokaz(int x, int y);
     
-    /// @brief Odwroc macierz (transponuj)
+    /// @brief Transponuj macierz w miejscu
+    /// Macierz kwadratowa jest transponowana kafelkami w jej wlasnym buforze;
+    /// prostokatna dostaje nowy bufor i wymiary cols x rows. Gdy transpozycja
+    /// jest tylko czytana (np. mnozona), tanszy jest widok transpose().
     /// @return Referencja na zmieniona macierz
-    matrix& dowroc();
+    basic_matrix& dowroc();
     
-    /// @brief Wypelnij macierz losowymi wartosciami
+    /// @brief Wypelnij macierz losowymi cyframi 0-9
+    /// Uzywa wspolnego generatora Philox (zob. counter_rng.h, seed_random());
+    /// wypelnianie jest rownolegle, a kolejne wywolania daja rozne macierze.
     /// @return Referencja na zmieniona macierz
-    matrix& losuj();
+    basic_matrix& losuj();
     
-    /// @brief Wypelnij macierz losowymi wartosciami z zakresu
-    /// @param x Maksymalna wartosc losowa
+    /// @brief Wstaw losowe cyfry 0-9 w x losowych pozycjach (ze zwracaniem)
+    /// @param x Liczba losowanych pozycji
     /// @return Referencja na zmieniona macierz
-    matrix& losuj(int x);
+    basic_matrix& losuj(int x);
     
     /// @brief Utworz macierz diagonalna z tablicy
     /// @param t Tablica zawierajaca wartosci diagonalne
     /// @return Referencja na zmieniona macierz
-    matrix& diagonalna(int* t);
+    basic_matrix& diagonalna(int* t);
     
     /// @brief Utworz macierz z diagonala przesunietej
     /// @param k Przesunicie diagonali (dodatnie - nad glowna, ujemne - pod glowna)
     /// @param t Tablica zawierajaca wartosci diagonalne
     /// @return Referencja na zmieniona macierz
-    matrix& diagonalna_k(int k, int* t);
+    basic_matrix& diagonalna_k(int k, int* t);
     
     /// @brief Wstaw wartosci tablicy w kolumne macierzy
     /// @param x Numer kolumny
     /// @param t Tablica wartosci
     /// @return Referencja na zmieniona macierz
-    matrix& kolumna(int x, int* t);
+    basic_matrix& kolumna(int x, int* t);
     
     /// @brief Wstaw wartosci tablicy w wiersz macierzy
     /// @param y Numer wiersza
     /// @param t Tablica wartosci
     /// @return Referencja na zmieniona macierz
-    matrix& wiersz(int y, int* t);
+    basic_matrix& wiersz(int y, int* t);
     
     /// @brief Wypelnij macierz glowna diagonala
     /// @return Referencja na zmieniona macierz
-    matrix& przekatna();
+    basic_matrix& przekatna();
     
     /// @brief Wypelnij czesc pod glowna diagonala
     /// @return Referencja na zmieniona macierz
-    matrix& pod_przekatna();
+    basic_matrix& pod_przekatna();
     
     /// @brief Wypelnij czesc nad glowna diagonala
     /// @return Referencja na zmieniona macierz
-    matrix& nad_przekatna();
+    basic_matrix& nad_przekatna();
     
     /// @brief Wypelnij macierz w wzor szachownicy
     /// @return Referencja na zmieniona macierz
-    matrix& szachownica();
+    basic_matrix& szachownica();
 
     /// @brief Liczba wierszy macierzy
     int rows;
@@ -236,8 +458,227 @@ public:
     /// @brief Liczba kolumn macierzy
     int cols;
     
-    /// @brief Wskaznik na dane macierzy (tablica wskaz­ni­kow do wierszy)
-    std::unique_ptr<double*[]> data;
+    /// @brief Wyrownanie bufora danych w bajtach (linia cache, rejestr AVX-512)
+    static constexpr std::size_t alignment = 64;
+
+    /// @brief Deleter zwalniajacy bufor zaalokowany z wyrownaniem `alignment`
+    struct aligned_deleter {
+        void operator()(T* p) const noexcept {
+            ::operator delete[](p, std::align_val_t{alignment});
+        }
+    };
+
+    /// @brief Odstep miedzy wierszami w elementach (cols zaokraglone do pelnej linii cache)
+    std::size_t stride;
+
+    /// @brief Wskaznik na dane macierzy (jeden ciagly blok rows * stride elementow)
+    std::unique_ptr<T[], aligned_deleter> data;
 
 private:
-};
\ No newline at end of file
+    /// @brief Alokuje bufor bez zerowania elementow (zerowane jest tylko dopelnienie)
+    void alokuj_bez_zerowania();
+};
+
+/// @brief Macierz liczb zmiennoprzecinkowych podwojnej precyzji
+using matrix = basic_matrix<double>;
+
+/// @brief Macierz liczb zmiennoprzecinkowych pojedynczej precyzji
+using matrix_f32 = basic_matrix<float>;
+
+/// @brief Macierz liczb calkowitych 8-bitowych (iloczyn: matrix_i32)
+using matrix_i8 = basic_matrix<std::int8_t>;
+
+/// @brief Macierz liczb calkowitych 32-bitowych (iloczyn: matrix_i64)
+using matrix_i32 = basic_matrix<std::int32_t>;
+
+/// @brief Macierz liczb calkowitych 64-bitowych
+using matrix_i64 = basic_matrix<std::int64_t>;
+
+/// @brief Wypisz macierz na strumien wyjsciowy
+/// Elementy typow 8-bitowych wypisywane sa jako liczby, nie znaki.
+/// @param o Strumien wyjsciowy
+/// @param m Macierz do wypisania
+/// @return Strumien wyjsciowy
+template <typename T>
+ostream& operator<<(ostream& o, const basic_matrix<T>& m);
+
+/// @brief Czy typ elementu uzywa operatorow obliczanych od razu (wszystkie poza double)
+template <typename T>
+constexpr bool bez_wyrazen_v = !std::is_same_v<T, double>;
+
+/// @brief Dodawanie macierzy (typy inne niz double) - A + B
+/// @throw std::runtime_error jesli wymiary operandow sie roznia
+template <typename T, typename = std::enable_if_t<bez_wyrazen_v<T>>>
+basic_matrix<T> operator+(basic_matrix<T> a, const basic_matrix<T>& b) {
+    return std::move(a += b);
+}
+
+/// @brief Odejmowanie macierzy (typy inne niz double) - A - B
+/// @throw std::runtime_error jesli wymiary operandow sie roznia
+template <typename T, typename = std::enable_if_t<bez_wyrazen_v<T>>>
+basic_matrix<T> operator-(basic_matrix<T> a, const basic_matrix<T>& b) {
+    return std::move(a -= b);
+}
+
+/// @brief Dodawanie skalara (typy inne niz double) - A + a
+template <typename T, typename = std::enable_if_t<bez_wyrazen_v<T>>>
+basic_matrix<T> operator+(basic_matrix<T> m, typename basic_matrix<T>::value_type a) {
+    return std::move(m += a);
+}
+
+/// @brief Odejmowanie skalara (typy inne niz double) - A - a
+template <typename T, typename = std::enable_if_t<bez_wyrazen_v<T>>>
+basic_matrix<T> operator-(basic_matrix<T> m, typename basic_matrix<T>::value_type a) {
+    return std::move(m -= a);
+}
+
+/// @brief Mnozenie przez skalar (typy inne niz double) - A * a
+template <typename T, typename = std::enable_if_t<bez_wyrazen_v<T>>>
+basic_matrix<T> operator*(basic_matrix<T> m, typename basic_matrix<T>::value_type a) {
+    return std::move(m *= a);
+}
+
+/// @brief Dodawanie skalara z lewej (typy inne niz double) - a + A
+template <typename T, typename = std::enable_if_t<bez_wyrazen_v<T>>>
+basic_matrix<T> operator+(typename basic_matrix<T>::value_type a, basic_matrix<T> m) {
+    return std::move(m += a);
+}
+
+/// @brief Mnozenie przez skalar z lewej (typy inne niz double) - a * A
+template <typename T, typename = std::enable_if_t<bez_wyrazen_v<T>>>
+basic_matrix<T> operator*(typename basic_matrix<T>::value_type a, basic_matrix<T> m) {
+    return std::move(m *= a);
+}
+
+/// @brief Operacja wykonywana na operandzie gemm() przed mnozeniem
+enum class trans {
+    none,      ///< operand bez zmian
+    transpose  ///< operand transponowany (odczyt z zamienionymi krokami, bez kopii)
+};
+
+/// @brief Iloczyn zapisywany do istniejacej macierzy: C = op(A) * op(B)
+/// W odroznieniu od gemm() dopasowuje wymiary C; bufor jest uzywany
+/// ponownie, gdy C ma juz wymiary wyniku.
+/// @param C Macierz wynikowa
+/// @param A Lewy operand
+/// @param B Prawy operand
+/// @param ta Operacja na A
+/// @param tb Operacja na B
+/// @return Referencja na C
+/// @throw std::runtime_error jesli wymiary sa niezgodne
+matrix& gemm_into(matrix& C, const matrix& A, const matrix& B,
+                  trans ta = trans::none, trans tb = trans::none);
+
+/// @brief Iloczyn Aᵀ * B bez tworzenia transpozycji A
+/// @param A Lewy operand (k x m)
+/// @param B Prawy operand (k x n)
+/// @return Nowa macierz m x n
+/// @throw std::runtime_error jesli A i B maja rozna liczbe wierszy
+matrix mul_tn(const matrix& A, const matrix& B);
+
+/// @brief Iloczyn A * Bᵀ bez tworzenia transpozycji B
+/// @param A Lewy operand (m x k)
+/// @param B Prawy operand (n x k)
+/// @return Nowa macierz m x n
+/// @throw std::runtime_error jesli A i B maja rozna liczbe kolumn
+matrix mul_nt(const matrix& A, const matrix& B);
+
+/// @brief Transpozycja zapisywana do istniejacej macierzy: B = Aᵀ
+/// Dopasowuje wymiary B; bufor jest uzywany ponownie, gdy B ma juz
+/// wymiary A.cols x A.rows. Dla &B == &A transponuje w miejscu.
+/// Rekurencyjny podzial na bloki mieszczace sie w L1, bloki transponowane
+/// w rejestrach SIMD, duze macierze dzielone miedzy watki puli.
+/// @param B Macierz wynikowa
+/// @param A Macierz transponowana
+/// @return Referencja na B
+template <typename T>
+basic_matrix<T>& transpose_into(basic_matrix<T>& B, const basic_matrix<T>& A);
+
+/// @brief Algorytm mnozenia wybierany w multiply()
+enum class mul_algo {
+    classic,   ///< klasyczny blokowy GEMM, O(n^3), jak operator*
+    strassen,  ///< Strassen-Winograd, O(n^2.807), slabsze ograniczenie bledu
+    automatic  ///< Strassen, gdy kazdy wymiar >= 4 * get_strassen_crossover(), inaczej classic
+};
+
+/// @brief Iloczyn A * B wybranym algorytmem
+///
+/// Ograniczenia bledu (u - precyzja maszynowa, 2^-53):
+/// - classic: skladowo |C - fl(C)| <= k u |A| |B| + O(u^2), jak operator*;
+/// - strassen: tylko normowo, ||C - fl(C)|| <= [(n/n0)^log2(18) (n0^2 + 6 n0) - 6n] u ||A|| ||B||
+///   + O(u^2) dla n = 2^l n0, n0 - prog przejscia (Higham, "Accuracy and Stability of
+///   Numerical Algorithms", rozdz. 23). Blad rosnie okolo 18 razy na poziom rekurencji
+///   i odnosi sie do najwiekszych elementow, wiec male elementy C moga stracic
+///   wzgledna dokladnosc. Nadaje sie do danych o podobnej skali elementow.
+///
+/// @param A Lewy operand
+/// @param B Prawy operand
+/// @param algo Algorytm
+/// @return Nowa macierz z iloczynem
+/// @throw std::runtime_error jesli A.cols != B.rows
+matrix multiply(const matrix& A, const matrix& B, mul_algo algo = mul_algo::automatic);
+
+/// @brief Ustaw prog przejscia Strassena na algorytm klasyczny
+/// Rekurencja dzieli macierze, dopoki najmniejszy wymiar przekracza ten prog.
+/// @param n Prog w elementach (domyslnie 512)
+void set_strassen_crossover(std::size_t n) noexcept;
+
+/// @brief Zwraca prog przejscia Strassena na algorytm klasyczny
+/// @return Prog w elementach
+std::size_t get_strassen_crossover() noexcept;
+
+/// @brief Sposob sumowania iloczynow skalarnych przy mnozeniu macierzy float
+///
+/// Ograniczenia bledu skladowo, w jednostkach |A| |B| (u = 2^-24 dla float, 2^-53 dla double):
+/// - f32: k u - najszybciej, blad rosnie liniowo z dlugoscia iloczynu;
+/// - f64: u (float) za zaokraglenie wyniku + k 2^-53 - operandy czytane jako float;
+/// - kahan: 2u + O(k u^2) - sumy float z kompensacja, blad praktycznie niezalezny od k;
+/// - pairwise: (32 + log2(k / 32)) u - drzewo sum czesciowych blokow po 32 skladniki.
+enum class acc_policy {
+    f32,      ///< suma w float (jak operator* dla matrix_f32)
+    f64,      ///< suma w double
+    kahan,    ///< suma w float z kompensacja Kahana
+    pairwise  ///< suma w float parami
+};
+
+/// @brief Iloczyn macierzy float z wybranym sposobem akumulacji
+/// Operandy i wynik przechowywane sa jako float, wiec odczyt z pamieci jest
+/// o polowe mniejszy niz dla matrix; dokladnosc okresla `polityka`.
+/// @param A Lewy operand
+/// @param B Prawy operand
+/// @param polityka Sposob sumowania
+/// @return Nowa macierz z iloczynem
+/// @throw std::runtime_error jesli A.cols != B.rows
+matrix_f32 multiply(const matrix_f32& A, const matrix_f32& B, acc_policy polityka = acc_policy::f64);
+
+/// @brief Iloczyn lancucha macierzy w optymalnej kolejnosci
+/// Kolejnosc mnozen wybiera programowanie dynamiczne na wymiarach
+/// (minimalna liczba operacji), a iloczyny posrednie trafiaja do
+/// wielokrotnie uzywanych buforow roboczych.
+/// @param lancuch Macierze w kolejnosci mnozenia (przekazywane przez referencje)
+/// @return Nowa macierz z iloczynem
+/// @throw std::runtime_error jesli lancuch jest pusty lub wymiary sie nie zgadzaja
+matrix multiply_chain(std::initializer_list<std::reference_wrapper<const matrix>> lancuch);
+
+/// @brief Iloczyn lancucha macierzy o dlugosci znanej w czasie wykonania
+/// @param lancuch Macierze w kolejnosci mnozenia
+/// @return Nowa macierz z iloczynem
+/// @throw std::runtime_error jesli lancuch jest pusty lub wymiary sie nie zgadzaja
+matrix multiply_chain(const std::vector<std::reference_wrapper<const matrix>>& lancuch);
+
+/// @brief Wsadowe mnozenie par malych macierzy: C[g] = A[g] * B[g] dla g < count
+/// Macierze leza kolejno w ciaglych tablicach, kazda wierszami bez dopelnienia
+/// (m*k, k*n i m*n elementow). Dla wymiarow do 8 uzywane sa jadra SIMD liczace
+/// kilka iloczynow naraz. Funkcja nie alokuje pamieci.
+/// @param count Liczba par
+/// @param m Liczba wierszy A[g] i C[g]
+/// @param n Liczba kolumn B[g] i C[g]
+/// @param k Liczba kolumn A[g] i wierszy B[g]
+/// @param A Tablica count macierzy m x k
+/// @param B Tablica count macierzy k x n
+/// @param C Tablica wynikowa na count macierzy m x n
+void gemm_batched(std::size_t count, std::size_t m, std::size_t n, std::size_t k,
+                  const double* A, const double* B, double* C);
+
+#include "matrix_view.h"
+#include "matrix_expr.h"
\ No newline at end of file
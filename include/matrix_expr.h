@@ -0,0 +1,384 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// @file matrix_expr.h
+/// @brief Leniwe wyrazenia element po elemencie (expression templates)
+///
+/// Operatory +, - oraz * i - ze skalarem nie licza wyniku, tylko buduja
+/// drzewo wyrazenia znane w czasie kompilacji. Przy przypisaniu do macierzy
+/// drzewo jest splaszczane do krotkiego programu w notacji postfiksowej
+/// i wyliczane jednym przebiegiem po pamieci: wynik kazdego fragmentu
+/// wiersza powstaje w buforach mieszczacych sie w L1, a do pamieci trafia
+/// tylko wynik koncowy. Wyrazenie `(A + B - 3) * 5` czyta A i B raz
+/// i zapisuje wynik raz, bez macierzy posrednich.
+///
+/// Macierze tymczasowe (np. `std::move(A)` albo wynik mnozenia) sa
+/// przechowywane w drzewie przez wartosc; ich bufor staje sie buforem wyniku.
+///
+/// @warning Wyrazenie przechowuje referencje na macierze-operandy, wiec
+///          zapisane przez `auto` nie moze przezyc tych macierzy.
+///
+/// Plik jest dolaczany na koncu matrix.h.
+
+namespace detail {
+
+/// @brief Instrukcja splaszczonego wyrazenia (notacja postfiksowa)
+struct expr_instr {
+    /// @brief Rodzaj instrukcji
+    enum kod : unsigned char { leaf, add, sub, add_scalar, mul_scalar, rsub_scalar };
+
+    /// @brief Rodzaj instrukcji
+    kod op;
+
+    /// @brief Macierz lub fragment odkladany na stos (tylko dla leaf)
+    const_matrix_view m;
+
+    /// @brief Skalar (tylko dla operacji ze skalarem)
+    double s;
+};
+
+/// @brief Najwieksza liczba instrukcji w programie wyrazenia
+/// Dane pomocnicze wyliczania (np. numery kafli lisci) mieszcza sie wtedy
+/// w tablicach o stalym rozmiarze, bez alokacji przy kazdym wyrazeniu.
+constexpr std::size_t expr_max_instrukcji = 64;
+
+/// @brief Wylicza program wyrazenia do macierzy lub widoku `out`
+/// Jadra SIMD dzialaja na fragmentach wierszy, a wiersze sa dzielone miedzy
+/// watki puli. `out` musi miec wymiary wyrazenia. Lisc wskazujacy na te same
+/// elementy w tym samym ukladzie (A = A * 2 + B) jest czytany w miejscu;
+/// jesli lisc moze dzielic elementy z `out` w innym ukladzie (A = A + A^T,
+/// przesuniety blok tej samej macierzy), wynik powstaje w macierzy
+/// tymczasowej i jest kopiowany do `out`.
+/// @param prog Instrukcje w notacji postfiksowej
+/// @param n Liczba instrukcji (najwyzej expr_max_instrukcji)
+/// @param out Macierz lub fragment docelowy
+void expr_evaluate(const expr_instr* prog, std::size_t n, matrix_view out);
+
+/// @brief Czy ktorys lisc programu moze dzielic elementy z `out` w innym ukladzie
+/// @param prog Instrukcje w notacji postfiksowej
+/// @param n Liczba instrukcji
+/// @param out Fragment docelowy
+bool expr_aliases(const expr_instr* prog, std::size_t n, const_matrix_view out) noexcept;
+
+} // namespace detail
+
+/// @brief Baza CRTP wszystkich wezlow wyrazenia
+/// @tparam E Typ konkretnego wezla
+template <typename E>
+struct matrix_expr {
+    /// @brief Zwraca wezel jako typ pochodny
+    const E& self() const noexcept { return static_cast<const E&>(*this); }
+
+    /// @brief Zwraca wezel jako typ pochodny (do przeniesienia)
+    E& self() noexcept { return static_cast<E&>(*this); }
+};
+
+namespace detail {
+
+/// @brief Lisc: referencja na istniejaca macierz lub jej fragment
+struct expr_ref : matrix_expr<expr_ref> {
+    static constexpr std::size_t instrukcje = 1;
+
+    explicit expr_ref(const_matrix_view m) noexcept : m(m) {}
+
+    std::size_t get_rows() const noexcept { return m.get_rows(); }
+    std::size_t get_cols() const noexcept { return m.get_cols(); }
+
+    void zapisz(expr_instr*& p) const noexcept { *p++ = {expr_instr::leaf, m, 0.0}; }
+    bool przejmij(matrix&) noexcept { return false; }
+
+    const_matrix_view m;
+};
+
+/// @brief Lisc: macierz tymczasowa przechowywana przez wartosc
+/// Jej bufor moze zostac przejety przez wynik (przejmij()); wtedy lisc
+/// wskazuje na macierz docelowa, ktora ma jeszcze nienadpisane dane.
+struct expr_tmp : matrix_expr<expr_tmp> {
+    static constexpr std::size_t instrukcje = 1;
+
+    explicit expr_tmp(matrix&& m) noexcept : m(std::move(m)) {}
+
+    std::size_t get_rows() const noexcept { return cel ? cel->get_rows() : m.get_rows(); }
+    std::size_t get_cols() const noexcept { return cel ? cel->get_cols() : m.get_cols(); }
+
+    void zapisz(expr_instr*& p) const noexcept { *p++ = {expr_instr::leaf, cel ? *cel : m, 0.0}; }
+
+    bool przejmij(matrix& wynik) noexcept {
+        if (cel || !m.data) return false;
+        wynik = std::move(m);
+        cel = &wynik;
+        return true;
+    }
+
+    matrix m;
+    const matrix* cel = nullptr;
+};
+
+/// @brief Wezel: operacja na dwoch macierzach o tych samych wymiarach
+template <expr_instr::kod Op, typename L, typename R>
+struct expr_binary : matrix_expr<expr_binary<Op, L, R>> {
+    static constexpr std::size_t instrukcje = L::instrukcje + R::instrukcje + 1;
+
+    expr_binary(L&& l, R&& r) : l(std::move(l)), r(std::move(r)) {
+        if (this->l.get_rows() != this->r.get_rows() || this->l.get_cols() != this->r.get_cols())
+            throw std::runtime_error(Op == expr_instr::add ? "Nieprawidłowe wymiary dla dodawania"
+                                                           : "Nieprawidłowe wymiary dla odejmowania");
+    }
+
+    std::size_t get_rows() const noexcept { return l.get_rows(); }
+    std::size_t get_cols() const noexcept { return l.get_cols(); }
+
+    void zapisz(expr_instr*& p) const noexcept {
+        l.zapisz(p);
+        r.zapisz(p);
+        *p++ = {Op, {}, 0.0};
+    }
+
+    bool przejmij(matrix& wynik) noexcept { return l.przejmij(wynik) || r.przejmij(wynik); }
+
+    L l;
+    R r;
+};
+
+/// @brief Wezel: operacja macierzy ze skalarem
+template <expr_instr::kod Op, typename E>
+struct expr_scalar : matrix_expr<expr_scalar<Op, E>> {
+    static constexpr std::size_t instrukcje = E::instrukcje + 1;
+
+    expr_scalar(E&& e, double s) : e(std::move(e)), s(s) {}
+
+    std::size_t get_rows() const noexcept { return e.get_rows(); }
+    std::size_t get_cols() const noexcept { return e.get_cols(); }
+
+    void zapisz(expr_instr*& p) const noexcept {
+        e.zapisz(p);
+        *p++ = {Op, {}, s};
+    }
+
+    bool przejmij(matrix& wynik) noexcept { return e.przejmij(wynik); }
+
+    E e;
+    double s;
+};
+
+/// @brief Czy T jest macierza, widokiem lub wyrazeniem (operand operatorow element po elemencie)
+template <typename T, typename D = std::decay_t<T>>
+constexpr bool jest_operandem_v = std::is_same_v<D, matrix> || std::is_same_v<D, matrix_view> ||
+                                  std::is_same_v<D, const_matrix_view> || std::is_base_of_v<matrix_expr<D>, D>;
+
+/// @brief Macierz trwala staje sie lisciem-referencja
+inline expr_ref jako_wyrazenie(const matrix& m) noexcept { return expr_ref(m); }
+
+/// @brief Widok staje sie lisciem-referencja na ten sam fragment
+inline expr_ref jako_wyrazenie(const_matrix_view m) noexcept { return expr_ref(m); }
+
+/// @brief Widok do zapisu - jak widok tylko do odczytu
+inline expr_ref jako_wyrazenie(matrix_view m) noexcept { return expr_ref(m); }
+
+/// @brief Macierz tymczasowa jest przenoszona do drzewa
+inline expr_tmp jako_wyrazenie(matrix&& m) noexcept { return expr_tmp(std::move(m)); }
+
+/// @brief Wyrazenie tymczasowe jest przenoszone do drzewa
+template <typename E>
+E jako_wyrazenie(matrix_expr<E>&& e) { return std::move(e.self()); }
+
+/// @brief Wyrazenie nazwane jest kopiowane (pozostaje uzyteczne po operacji)
+template <typename E>
+E jako_wyrazenie(const matrix_expr<E>& e) { return e.self(); }
+
+/// @brief Typ wezla powstalego z operandu T
+template <typename T>
+using wezel_t = decltype(jako_wyrazenie(std::declval<T>()));
+
+/// @brief Wylicza wyrazenie do `wynik`
+/// @param e Wezel glowny
+/// @param wynik Macierz docelowa
+/// @param przejmuj Czy wolno przejac bufor macierzy tymczasowej z wyrazenia
+template <typename E>
+void wylicz(E& e, matrix& wynik, bool przejmuj) {
+    static_assert(E::instrukcje <= expr_max_instrukcji, "Za dlugie wyrazenie - wylicz czesc do macierzy");
+    const std::size_t r = e.get_rows(), c = e.get_cols();
+    std::array<expr_instr, E::instrukcje> prog;
+    expr_instr* p = prog.data();
+    if (wynik.data && wynik.get_rows() == r && wynik.get_cols() == c) {
+        e.zapisz(p);
+        if (!expr_aliases(prog.data(), prog.size(), wynik)) {
+            expr_evaluate(prog.data(), prog.size(), wynik);
+            return;
+        }
+    }
+    // Nowy bufor trafia do wynik dopiero po wyliczeniu, bo liscie moga
+    // wskazywac na dotychczasowe elementy wynik (np. A = A.transpose() + 1)
+    matrix nowy;
+    if (!(przejmuj && e.przejmij(nowy))) {
+        nowy = matrix(r, c, bez_zerowania);
+    }
+    p = prog.data();
+    e.zapisz(p);
+    expr_evaluate(prog.data(), prog.size(), nowy);
+    wynik = std::move(nowy);
+}
+
+/// @brief Wylicza wyrazenie do istniejacego fragmentu macierzy
+/// @param e Wezel glowny
+/// @param wynik Widok docelowy o wymiarach wyrazenia
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+template <typename E>
+void wylicz(E& e, matrix_view wynik) {
+    if (e.get_rows() != wynik.get_rows() || e.get_cols() != wynik.get_cols())
+        throw std::runtime_error("Nieprawidłowe wymiary widoku");
+    static_assert(E::instrukcje <= expr_max_instrukcji, "Za dlugie wyrazenie - wylicz czesc do macierzy");
+    std::array<expr_instr, E::instrukcje> prog;
+    expr_instr* p = prog.data();
+    e.zapisz(p);
+    expr_evaluate(prog.data(), prog.size(), wynik);
+}
+
+} // namespace detail
+
+/// @brief Dodawanie dwoch macierzy (lub wyrazen) - A + B
+/// @param l Lewy operand
+/// @param r Prawy operand
+/// @return Leniwe wyrazenie; wymiary sprawdzane sa od razu
+/// @throw std::runtime_error jesli wymiary operandow sie roznia
+template <typename L, typename R,
+          typename = std::enable_if_t<detail::jest_operandem_v<L> && detail::jest_operandem_v<R>>>
+auto operator+(L&& l, R&& r) {
+    return detail::expr_binary<detail::expr_instr::add, detail::wezel_t<L>, detail::wezel_t<R>>(
+        detail::jako_wyrazenie(std::forward<L>(l)), detail::jako_wyrazenie(std::forward<R>(r)));
+}
+
+/// @brief Odejmowanie dwoch macierzy (lub wyrazen) - A - B
+/// @param l Lewy operand
+/// @param r Prawy operand
+/// @return Leniwe wyrazenie; wymiary sprawdzane sa od razu
+/// @throw std::runtime_error jesli wymiary operandow sie roznia
+template <typename L, typename R,
+          typename = std::enable_if_t<detail::jest_operandem_v<L> && detail::jest_operandem_v<R>>>
+auto operator-(L&& l, R&& r) {
+    return detail::expr_binary<detail::expr_instr::sub, detail::wezel_t<L>, detail::wezel_t<R>>(
+        detail::jako_wyrazenie(std::forward<L>(l)), detail::jako_wyrazenie(std::forward<R>(r)));
+}
+
+/// @brief Dodawanie skalara - A + a
+/// @param l Macierz lub wyrazenie
+/// @param a Skalar dodawany do kazdego elementu
+/// @return Leniwe wyrazenie
+template <typename L, typename = std::enable_if_t<detail::jest_operandem_v<L>>>
+auto operator+(L&& l, double a) {
+    return detail::expr_scalar<detail::expr_instr::add_scalar, detail::wezel_t<L>>(
+        detail::jako_wyrazenie(std::forward<L>(l)), a);
+}
+
+/// @brief Odejmowanie skalara - A - a
+/// @param l Macierz lub wyrazenie
+/// @param a Skalar odejmowany od kazdego elementu
+/// @return Leniwe wyrazenie
+template <typename L, typename = std::enable_if_t<detail::jest_operandem_v<L>>>
+auto operator-(L&& l, double a) {
+    return detail::expr_scalar<detail::expr_instr::add_scalar, detail::wezel_t<L>>(
+        detail::jako_wyrazenie(std::forward<L>(l)), -a);
+}
+
+/// @brief Mnozenie przez skalar - A * a
+/// @param l Macierz lub wyrazenie
+/// @param a Mnoznik
+/// @return Leniwe wyrazenie
+template <typename L, typename = std::enable_if_t<detail::jest_operandem_v<L>>>
+auto operator*(L&& l, double a) {
+    return detail::expr_scalar<detail::expr_instr::mul_scalar, detail::wezel_t<L>>(
+        detail::jako_wyrazenie(std::forward<L>(l)), a);
+}
+
+/// @brief Dodawanie skalara z lewej - a + A
+/// @param a Skalar dodawany do kazdego elementu
+/// @param r Macierz lub wyrazenie
+/// @return Leniwe wyrazenie
+template <typename R, typename = std::enable_if_t<detail::jest_operandem_v<R>>>
+auto operator+(double a, R&& r) {
+    return detail::expr_scalar<detail::expr_instr::add_scalar, detail::wezel_t<R>>(
+        detail::jako_wyrazenie(std::forward<R>(r)), a);
+}
+
+/// @brief Mnozenie przez skalar z lewej - a * A
+/// @param a Mnoznik
+/// @param r Macierz lub wyrazenie
+/// @return Leniwe wyrazenie
+template <typename R, typename = std::enable_if_t<detail::jest_operandem_v<R>>>
+auto operator*(double a, R&& r) {
+    return detail::expr_scalar<detail::expr_instr::mul_scalar, detail::wezel_t<R>>(
+        detail::jako_wyrazenie(std::forward<R>(r)), a);
+}
+
+/// @brief Odejmowanie macierzy od skalara - a - A
+/// @param a Skalar
+/// @param r Macierz lub wyrazenie
+/// @return Leniwe wyrazenie o elementach a - r[i][j]
+template <typename R, typename = std::enable_if_t<detail::jest_operandem_v<R>>>
+auto operator-(double a, R&& r) {
+    return detail::expr_scalar<detail::expr_instr::rsub_scalar, detail::wezel_t<R>>(
+        detail::jako_wyrazenie(std::forward<R>(r)), a);
+}
+
+/// @brief Mnozenie macierzowe wyrazenia przez macierz - (A + B) * C
+/// Wyrazenie jest najpierw wyliczane, bo GEMM potrzebuje obu operandow w pamieci.
+template <typename E>
+matrix operator*(const matrix_expr<E>& l, const matrix& r) {
+    return matrix(l) * r;
+}
+
+/// @brief Mnozenie macierzowe macierzy przez wyrazenie - A * (B + C)
+template <typename E>
+matrix operator*(const matrix& l, const matrix_expr<E>& r) {
+    return l * matrix(r);
+}
+
+/// @brief Mnozenie macierzowe dwoch wyrazen - (A + B) * (C - D)
+template <typename E1, typename E2>
+matrix operator*(const matrix_expr<E1>& l, const matrix_expr<E2>& r) {
+    return matrix(l) * matrix(r);
+}
+
+template <typename T>
+template <typename E, typename U, typename>
+basic_matrix_view<T>& basic_matrix_view<T>::operator=(const matrix_expr<E>& e) {
+    E kopia = e.self();
+    detail::wylicz(kopia, *this);
+    return *this;
+}
+
+template <typename T>
+template <typename E, typename U, typename>
+basic_matrix<T>& basic_matrix<T>::operator+=(const matrix_expr<E>& e) {
+    view() += e.self();
+    return *this;
+}
+
+template <typename T>
+template <typename E, typename U, typename>
+basic_matrix<T>& basic_matrix<T>::operator-=(const matrix_expr<E>& e) {
+    view() -= e.self();
+    return *this;
+}
+
+template <typename T>
+template <typename R, typename U, typename>
+basic_matrix_view<T>& basic_matrix_view<T>::operator+=(R&& r) {
+    return *this = *this + std::forward<R>(r);
+}
+
+template <typename T>
+template <typename R, typename U, typename>
+basic_matrix_view<T>& basic_matrix_view<T>::operator-=(R&& r) {
+    return *this = *this - std::forward<R>(r);
+}
+
+template <typename T>
+template <typename U, typename>
+basic_matrix_view<T>& basic_matrix_view<T>::operator*=(double a) {
+    return *this = *this * a;
+}
@@ -0,0 +1,448 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// @file matrix_view.h
+/// @brief Widok na fragment macierzy bez kopiowania danych
+///
+/// Widok opisuje prostokatny fragment istniejacej macierzy wskaznikiem na
+/// element (0, 0) i dwoma krokami: odstepem miedzy wierszami i miedzy
+/// kolumnami (w elementach). Bloki, zakresy wierszy i kolumn oraz pojedyncze
+/// wiersze i kolumny sa widokami na ten sam bufor, wiec algorytmy blokowe
+/// dziela prace bez alokowania podmacierzy.
+///
+/// `matrix_view` i `const_matrix_view` (double) sa pelnoprawnymi operandami:
+/// wchodza do leniwych wyrazen (+, -, dzialania ze skalarem), mnozenia
+/// (operator*, gemm) i porownania, a `matrix_view` moze byc celem przypisania:
+///
+/// @code
+/// C.block(0, 0, 64, 64) = A.block(0, 0, 64, 64) * 2 + B.row_block(0, 64).col_block(0, 64);
+/// gemm(C.block(64, 0, 64, 64), A.row_block(64, 64), B.col_block(0, 64));
+/// @endcode
+///
+/// Przypisanie do widoku kopiuje elementy (jak do bloku macierzy), a nie
+/// przestawia widoku na inny fragment; widok tylko do odczytu przypisanie
+/// przestawia.
+///
+/// @warning Widok nie jest wlascicielem danych - nie moze przezyc macierzy,
+///          na ktora wskazuje, ani jej realokacji (np. przypisania macierzy
+///          o innych wymiarach).
+///
+/// Transpozycja to rowniez widok: `A.transpose()` zamienia wymiary i kroki
+/// (O(1)), wiec `A * B.transpose()` pakuje B kolumnami zamiast tworzyc kopie.
+/// Elementy sa przenoszone dopiero przy jawnej kopii (`to_matrix()`,
+/// przypisanie do macierzy lub widoku o ciaglych wierszach), ktora korzysta
+/// z blokowej transpozycji SIMD.
+///
+/// Plik jest dolaczany na koncu matrix.h.
+
+namespace detail {
+/// @brief Blokowa transpozycja b = aᵀ (a: rows x cols) - src/matrix_transpose.cpp
+/// Konkretyzowana dla typow elementow basic_matrix. Bloki nie moga sie nakladac.
+template <typename T>
+void transpose_copy(std::size_t rows, std::size_t cols, const T* a, std::size_t lda,
+                    T* b, std::size_t ldb);
+} // namespace detail
+
+template <typename T>
+class basic_matrix_view;
+
+namespace detail {
+template <typename T>
+bool moga_sie_nakladac(basic_matrix_view<const T> x, basic_matrix_view<const T> y) noexcept;
+
+template <typename T>
+bool ten_sam_uklad(basic_matrix_view<const T> x, basic_matrix_view<const T> y) noexcept;
+} // namespace detail
+
+/// @class basic_matrix_view
+/// @brief Widok (bez wlasnosci danych) na prostokatny fragment macierzy
+/// @tparam T Typ elementu; `const T` - widok tylko do odczytu
+template <typename T>
+class basic_matrix_view {
+public:
+    /// @brief Typ elementu bez kwalifikatora const
+    using value_type = std::remove_const_t<T>;
+
+    /// @brief Widok pusty (0x0)
+    basic_matrix_view() noexcept = default;
+
+    /// @brief Widok na dowolnie rozmieszczone elementy
+    /// @param ptr Wskaznik na element (0, 0)
+    /// @param rows Liczba wierszy
+    /// @param cols Liczba kolumn
+    /// @param rs Odstep miedzy wierszami (w elementach)
+    /// @param cs Odstep miedzy kolumnami (w elementach)
+    basic_matrix_view(T* ptr, std::size_t rows, std::size_t cols,
+                      std::ptrdiff_t rs, std::ptrdiff_t cs = 1) noexcept
+        : ptr(ptr), rows(rows), cols(cols), rs(rs), cs(cs) {}
+
+    /// @brief Widok calej macierzy
+    basic_matrix_view(basic_matrix<value_type>& m) noexcept
+        : basic_matrix_view(m.data.get(), m.get_rows(), m.get_cols(),
+                            static_cast<std::ptrdiff_t>(m.get_stride())) {}
+
+    /// @brief Widok tylko do odczytu calej macierzy stalej
+    template <typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+    basic_matrix_view(const basic_matrix<value_type>& m) noexcept
+        : basic_matrix_view(m.data.get(), m.get_rows(), m.get_cols(),
+                            static_cast<std::ptrdiff_t>(m.get_stride())) {}
+
+    /// @brief Widok tylko do odczytu z widoku do zapisu
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    basic_matrix_view(const basic_matrix_view<U>& v) noexcept
+        : basic_matrix_view(v.data(), v.get_rows(), v.get_cols(), v.row_stride(), v.col_stride()) {}
+
+    /// @brief Konstruktor kopiujacy - nowy widok na te same elementy
+    basic_matrix_view(const basic_matrix_view&) noexcept = default;
+
+    /// @brief Przypisanie widoku tego samego typu
+    /// Dla widoku do zapisu kopiuje elementy `v` (wymiary musza byc zgodne),
+    /// dla widoku tylko do odczytu przestawia widok na elementy `v`.
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja (widok do zapisu)
+    basic_matrix_view& operator=(const basic_matrix_view& v) {
+        if constexpr (std::is_const_v<T>) {
+            ptr = v.ptr;
+            rows = v.rows;
+            cols = v.cols;
+            rs = v.rs;
+            cs = v.cs;
+        } else {
+            kopiuj(v);
+        }
+        return *this;
+    }
+
+    /// @brief Kopiuje elementy widoku `v` (wymiary musza byc zgodne)
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    basic_matrix_view& operator=(const basic_matrix_view<const value_type>& v) {
+        kopiuj(v);
+        return *this;
+    }
+
+    /// @brief Kopiuje elementy macierzy `m` (wymiary musza byc zgodne)
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    basic_matrix_view& operator=(const basic_matrix<value_type>& m) {
+        kopiuj(basic_matrix_view<const value_type>(m));
+        return *this;
+    }
+
+    /// @brief Wylicza wyrazenie do widoku (tylko double; wymiary musza byc zgodne)
+    /// Widok moze byc operandem wyrazenia, jesli wskazuje na te same elementy
+    /// w tym samym ukladzie (np. `V = V * 2 + B`).
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename E, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix_view& operator=(const matrix_expr<E>& e);
+
+    /// @brief Dodaj macierz, widok lub wyrazenie element po elemencie (tylko double)
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename R, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix_view& operator+=(R&& r);
+
+    /// @brief Odejmij macierz, widok lub wyrazenie element po elemencie (tylko double)
+    /// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+    template <typename R, typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix_view& operator-=(R&& r);
+
+    /// @brief Pomnoz wszystkie elementy przez skalar (tylko double)
+    template <typename U = T, typename = std::enable_if_t<std::is_same_v<U, double>>>
+    basic_matrix_view& operator*=(double a);
+
+    /// @brief Ustaw wszystkie elementy na `wartosc`
+    template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    void fill(value_type wartosc) const noexcept {
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) {
+                (*this)(i, j) = wartosc;
+            }
+        }
+    }
+
+    /// @brief Zwraca liczbe wierszy
+    std::size_t get_rows() const noexcept { return rows; }
+
+    /// @brief Zwraca liczbe kolumn
+    std::size_t get_cols() const noexcept { return cols; }
+
+    /// @brief Zwraca liczbe elementow
+    std::size_t size() const noexcept { return rows * cols; }
+
+    /// @brief Odstep miedzy kolejnymi wierszami (w elementach)
+    std::ptrdiff_t row_stride() const noexcept { return rs; }
+
+    /// @brief Odstep miedzy kolejnymi kolumnami (w elementach)
+    std::ptrdiff_t col_stride() const noexcept { return cs; }
+
+    /// @brief Wskaznik na element (0, 0)
+    T* data() const noexcept { return ptr; }
+
+    /// @brief Czy elementy kazdego wiersza leza w pamieci obok siebie
+    bool contiguous_rows() const noexcept { return cs == 1 || cols <= 1; }
+
+    /// @brief Czy elementy kazdej kolumny leza w pamieci obok siebie (np. widok transpose())
+    bool contiguous_cols() const noexcept { return rs == 1 || rows <= 1; }
+
+    /// @brief Dostep do elementu (i, j); indeksy nie sa sprawdzane
+    T& operator()(std::size_t i, std::size_t j) const noexcept {
+        return ptr[static_cast<std::ptrdiff_t>(i) * rs + static_cast<std::ptrdiff_t>(j) * cs];
+    }
+
+    /// @brief Wskaznik na poczatek wiersza i (elementy co col_stride())
+    T* row_ptr(std::size_t i) const noexcept { return ptr + static_cast<std::ptrdiff_t>(i) * rs; }
+
+    /// @brief Blok nr x nc o lewym gornym rogu (r0, c0)
+    /// @throw std::runtime_error jesli blok wykracza poza widok
+    basic_matrix_view block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc) const {
+        if (r0 > rows || nr > rows - r0 || c0 > cols || nc > cols - c0)
+            throw std::runtime_error("Fragment wykracza poza macierz");
+        return basic_matrix_view(ptr + static_cast<std::ptrdiff_t>(r0) * rs + static_cast<std::ptrdiff_t>(c0) * cs,
+                                 nr, nc, rs, cs);
+    }
+
+    /// @brief Wiersze od r0 do r0 + nr - 1
+    /// @throw std::runtime_error jesli zakres wykracza poza widok
+    basic_matrix_view row_block(std::size_t r0, std::size_t nr) const { return block(r0, 0, nr, cols); }
+
+    /// @brief Kolumny od c0 do c0 + nc - 1
+    /// @throw std::runtime_error jesli zakres wykracza poza widok
+    basic_matrix_view col_block(std::size_t c0, std::size_t nc) const { return block(0, c0, rows, nc); }
+
+    /// @brief Wiersz i jako widok 1 x cols
+    /// @throw std::runtime_error jesli i >= rows
+    basic_matrix_view row(std::size_t i) const { return block(i, 0, 1, cols); }
+
+    /// @brief Kolumna j jako widok rows x 1
+    /// @throw std::runtime_error jesli j >= cols
+    basic_matrix_view col(std::size_t j) const { return block(0, j, rows, 1); }
+
+    /// @brief Transpozycja widoku (cols x rows) - O(1), zamienia tylko kroki
+    basic_matrix_view transpose() const noexcept { return basic_matrix_view(ptr, cols, rows, cs, rs); }
+
+    /// @brief Kopia elementow widoku jako nowa macierz (wiersze ciagle)
+    basic_matrix<value_type> to_matrix() const {
+        basic_matrix<value_type> m(rows, cols, bez_zerowania);
+        basic_matrix_view<value_type>(m).kopiuj(*this);
+        return m;
+    }
+
+private:
+    template <typename U>
+    friend class basic_matrix_view;
+
+    /// @brief Kopiuje elementy `v` do widoku; wiersze ciagle kopiowane sa memcpy
+    /// Zrodlo o ciaglych kolumnach (transpozycja) trafia do ciaglych wierszy
+    /// blokowa transpozycja SIMD. Cel o ciaglych kolumnach jest wypelniany
+    /// jako transpozycja, wiec te same sciezki obsluguja zapis kolumnami.
+    /// Fragmenty, ktore moga sie nakladac w innym ukladzie (przesuniety blok,
+    /// `A.view() = A.transpose()`), sa kopiowane przez kopie tymczasowa.
+    void kopiuj(const basic_matrix_view<const value_type>& v) const {
+        if (v.get_rows() != rows || v.get_cols() != cols)
+            throw std::runtime_error("Nieprawidłowe wymiary widoku");
+        if (detail::moga_sie_nakladac<value_type>(*this, v)) {
+            if (!detail::ten_sam_uklad<value_type>(*this, v)) kopiuj(v.to_matrix());
+            return;
+        }
+        if (!contiguous_rows() && contiguous_cols()) {
+            transpose().kopiuj(v.transpose());
+            return;
+        }
+        if (rows > 1 && cols > 1 && cs == 1 && v.rs == 1 && rs > 0 && v.cs > 0) {
+            detail::transpose_copy(cols, rows, v.ptr, static_cast<std::size_t>(v.cs),
+                                   ptr, static_cast<std::size_t>(rs));
+            return;
+        }
+        for (std::size_t i = 0; i < rows; ++i) {
+            const value_type* z = v.row_ptr(i);
+            value_type* w = row_ptr(i);
+            if (contiguous_rows() && v.contiguous_rows()) {
+                std::memcpy(w, z, cols * sizeof(value_type));
+                continue;
+            }
+            for (std::size_t j = 0; j < cols; ++j) {
+                w[static_cast<std::ptrdiff_t>(j) * cs] = z[static_cast<std::ptrdiff_t>(j) * v.col_stride()];
+            }
+        }
+    }
+
+    T* ptr = nullptr;
+    std::size_t rows = 0, cols = 0;
+    std::ptrdiff_t rs = 0, cs = 1;
+};
+
+/// @brief Widok do zapisu na fragment macierzy double
+using matrix_view = basic_matrix_view<double>;
+
+/// @brief Widok tylko do odczytu na fragment macierzy double
+using const_matrix_view = basic_matrix_view<const double>;
+
+namespace detail {
+
+/// @brief Czy dwa fragmenty moga miec wspolne elementy
+/// Rozlaczne przedzialy adresow wykluczaja nakladanie. Dla dwoch blokow
+/// tej samej macierzy (ten sam krok wiersza, ciagle wiersze) polozenie
+/// jednego wzgledem drugiego wyznacza roznica adresow; przesuniecie kolumn
+/// jest znane z dokladnoscia do jednego zawiniecia wiersza, wiec sprawdzane
+/// sa oba warianty. W pozostalych przypadkach odpowiedz jest zachowawcza (tak).
+template <typename T>
+bool moga_sie_nakladac(basic_matrix_view<const T> x, basic_matrix_view<const T> y) noexcept {
+    if (x.size() == 0 || y.size() == 0) return false;
+    if (x.row_stride() < 0 || x.col_stride() < 0 || y.row_stride() < 0 || y.col_stride() < 0) return true;
+    auto koniec = [](basic_matrix_view<const T> v) {
+        return &v(v.get_rows() - 1, v.get_cols() - 1);
+    };
+    if (koniec(x) < y.data() || koniec(y) < x.data()) return false;
+
+    // Ten sam fragment opisany wierszami ciaglymi, jesli ciagle sa jego kolumny
+    auto wierszowo = [](basic_matrix_view<const T> v) {
+        return !v.contiguous_rows() && v.contiguous_cols() ? v.transpose() : v;
+    };
+    x = wierszowo(x);
+    y = wierszowo(y);
+    if (y.data() < x.data()) std::swap(x, y);
+    const std::ptrdiff_t rs = x.row_stride();
+    if (!x.contiguous_rows() || !y.contiguous_rows() || y.row_stride() != rs ||
+        rs < static_cast<std::ptrdiff_t>(std::max(x.get_cols(), y.get_cols()))) {
+        return true;
+    }
+    const std::ptrdiff_t d = y.data() - x.data();
+    auto przecina = [&](std::ptrdiff_t dr, std::ptrdiff_t dc) {
+        return dr < static_cast<std::ptrdiff_t>(x.get_rows()) &&
+               dc < static_cast<std::ptrdiff_t>(x.get_cols()) &&
+               dc + static_cast<std::ptrdiff_t>(y.get_cols()) > 0;
+    };
+    return przecina(d / rs, d % rs) || przecina(d / rs + 1, d % rs - rs);
+}
+
+/// @brief Czy widoki opisuja te same elementy w tym samym ukladzie
+/// Operacja element po elemencie moze wtedy czytac i pisac ten sam fragment.
+template <typename T>
+bool ten_sam_uklad(basic_matrix_view<const T> x, basic_matrix_view<const T> y) noexcept {
+    return x.data() == y.data() && x.get_rows() == y.get_rows() && x.get_cols() == y.get_cols() &&
+           (x.get_rows() <= 1 || x.row_stride() == y.row_stride()) &&
+           (x.get_cols() <= 1 || x.col_stride() == y.col_stride());
+}
+
+} // namespace detail
+
+template <typename T>
+basic_matrix_view<T> basic_matrix<T>::view() noexcept { return basic_matrix_view<T>(*this); }
+
+template <typename T>
+basic_matrix_view<const T> basic_matrix<T>::view() const noexcept { return basic_matrix_view<const T>(*this); }
+
+template <typename T>
+basic_matrix_view<T> basic_matrix<T>::block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc) {
+    return view().block(r0, c0, nr, nc);
+}
+
+template <typename T>
+basic_matrix_view<const T> basic_matrix<T>::block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc) const {
+    return view().block(r0, c0, nr, nc);
+}
+
+template <typename T>
+basic_matrix_view<T> basic_matrix<T>::row_block(std::size_t r0, std::size_t nr) { return view().row_block(r0, nr); }
+
+template <typename T>
+basic_matrix_view<const T> basic_matrix<T>::row_block(std::size_t r0, std::size_t nr) const { return view().row_block(r0, nr); }
+
+template <typename T>
+basic_matrix_view<T> basic_matrix<T>::col_block(std::size_t c0, std::size_t nc) { return view().col_block(c0, nc); }
+
+template <typename T>
+basic_matrix_view<const T> basic_matrix<T>::col_block(std::size_t c0, std::size_t nc) const { return view().col_block(c0, nc); }
+
+template <typename T>
+basic_matrix_view<T> basic_matrix<T>::row(std::size_t i) { return view().row(i); }
+
+template <typename T>
+basic_matrix_view<const T> basic_matrix<T>::row(std::size_t i) const { return view().row(i); }
+
+template <typename T>
+basic_matrix_view<T> basic_matrix<T>::col(std::size_t j) { return view().col(j); }
+
+template <typename T>
+basic_matrix_view<const T> basic_matrix<T>::col(std::size_t j) const { return view().col(j); }
+
+template <typename T>
+template <typename U, typename>
+basic_matrix<T>::basic_matrix(const basic_matrix_view<U>& v) : basic_matrix(v.get_rows(), v.get_cols(), bez_zerowania) {
+    view() = basic_matrix_view<const T>(v);
+}
+
+template <typename T>
+template <typename U, typename>
+basic_matrix<T>& basic_matrix<T>::operator=(const basic_matrix_view<U>& v) {
+    if (get_rows() == v.get_rows() && get_cols() == v.get_cols()) {
+        view() = basic_matrix_view<const T>(v);
+    } else {
+        *this = v.to_matrix();
+    }
+    return *this;
+}
+
+template <typename T>
+basic_matrix_view<T> basic_matrix<T>::transpose() noexcept { return view().transpose(); }
+
+template <typename T>
+basic_matrix_view<const T> basic_matrix<T>::transpose() const noexcept { return view().transpose(); }
+
+/// @brief Iloczyn A * B fragmentow macierzy (dowolne kroki, bez kopii operandow)
+/// @return Nowa macierz z iloczynem
+/// @throw std::runtime_error jesli A.cols != B.rows
+matrix operator*(const_matrix_view A, const_matrix_view B);
+
+/// @brief Porownanie wszystkich elementow dwoch fragmentow
+/// @return Prawda, jesli wymiary i wszystkie elementy sa rowne
+bool operator==(const_matrix_view A, const_matrix_view B);
+
+template <typename T>
+template <typename U, typename>
+basic_matrix<T> basic_matrix<T>::operator*(const basic_matrix_view<U>& v) const {
+    return view() * basic_matrix_view<const T>(v);
+}
+
+template <typename T>
+template <typename U, typename>
+bool basic_matrix<T>::operator==(const basic_matrix_view<U>& v) const {
+    return view() == basic_matrix_view<const T>(v);
+}
+
+template <typename T>
+template <typename U, typename>
+basic_matrix<T>& basic_matrix<T>::operator+=(const basic_matrix_view<U>& v) {
+    view() += basic_matrix_view<const T>(v);
+    return *this;
+}
+
+template <typename T>
+template <typename U, typename>
+basic_matrix<T>& basic_matrix<T>::operator-=(const basic_matrix_view<U>& v) {
+    view() -= basic_matrix_view<const T>(v);
+    return *this;
+}
+
+/// @brief Mnozenie w konwencji BLAS: C = alpha * op(A) * op(B) + beta * C
+/// Wynik trafia do istniejacego bufora C, wiec wielokrotne mnozenie do tej
+/// samej macierzy nie alokuje pamieci. Dla beta == 0 poprzednia zawartosc C
+/// jest ignorowana (takze NaN). Operandy i wynik moga byc macierzami albo
+/// blokami, zakresami wierszy lub kolumn innych macierzy. Wynik o kolumnach
+/// rozrzuconych w pamieci (np. kolumna macierzy) jest liczony jako
+/// op(B)^T * op(A)^T; jesli C naklada sie w pamieci na A lub B (takze C == A),
+/// iloczyn powstaje w buforze tymczasowym.
+/// @param C Wynik o wymiarach op(A).rows x op(B).cols
+/// @param A Lewy operand
+/// @param B Prawy operand
+/// @param alpha Mnoznik iloczynu
+/// @param beta Mnoznik dotychczasowej zawartosci C
+/// @param ta Operacja na A
+/// @param tb Operacja na B
+/// @throw std::runtime_error jesli wymiary sa niezgodne
+void gemm(matrix_view C, const_matrix_view A, const_matrix_view B, double alpha = 1.0, double beta = 0.0,
+          trans ta = trans::none, trans tb = trans::none);
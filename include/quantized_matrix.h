@@ -0,0 +1,77 @@
+#pragma once
+#include "matrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @file quantized_matrix.h
+/// @brief Macierz skwantowana do int8 ze skalami wierszy lub kolumn
+///
+/// Element x jest zapisywany jako q = round(x / s) z zakresu [-127, 127],
+/// gdzie s to skala jego wiersza (albo kolumny). Macierz zajmuje 8 razy mniej
+/// pamieci niz matrix, a iloczyn liczony jest na liczbach calkowitych
+/// z akumulacja w int32 i skalowany dopiero na koncu:
+/// C[i][j] = sA[i] * sB[j] * suma_p qA[i][p] * qB[p][j].
+/// Wymaga to skal wierszy dla lewego i skal kolumn dla prawego operandu.
+
+/// @brief Wymiar, wzdluz ktorego macierz ma wspolna skale
+enum class quant_axis {
+    per_row, ///< jedna skala na wiersz (lewy operand mnozenia)
+    per_col  ///< jedna skala na kolumne (prawy operand mnozenia)
+};
+
+/// @class quantized_matrix
+/// @brief Wartosci int8 i skale double jednej macierzy
+class quantized_matrix {
+public:
+    /// @brief Konstruktor domyslny - macierz 0x0
+    quantized_matrix() = default;
+
+    /// @brief Konstruktor z gotowych wartosci i skal
+    /// @param wartosci Elementy skwantowane
+    /// @param skale Skale wierszy (per_row) albo kolumn (per_col)
+    /// @param os Wymiar skal
+    /// @throw std::runtime_error jesli liczba skal nie odpowiada wymiarowi
+    quantized_matrix(matrix_i8 wartosci, std::vector<double> skale, quant_axis os);
+
+    /// @brief Zwraca liczbe wierszy
+    std::size_t get_rows() const noexcept { return wartosci.get_rows(); }
+
+    /// @brief Zwraca liczbe kolumn
+    std::size_t get_cols() const noexcept { return wartosci.get_cols(); }
+
+    /// @brief Zwraca wymiar skal
+    quant_axis axis() const noexcept { return os; }
+
+    /// @brief Elementy skwantowane
+    const matrix_i8& values() const noexcept { return wartosci; }
+
+    /// @brief Skale wierszy albo kolumn (zob. axis())
+    const std::vector<double>& scales() const noexcept { return skale; }
+
+private:
+    matrix_i8 wartosci;
+    std::vector<double> skale;
+    quant_axis os = quant_axis::per_row;
+};
+
+/// @brief Kwantyzacja symetryczna: skala = max |x| / 127 w wierszu lub kolumnie
+/// @param m Macierz zrodlowa
+/// @param os Wymiar skal (per_row dla lewego, per_col dla prawego operandu mnozenia)
+/// @return Macierz skwantowana; wiersz/kolumna samych zer dostaje skale 1
+quantized_matrix quantize(const matrix& m, quant_axis os);
+
+/// @brief Odtwarza macierz double: x = q * skala
+/// @param q Macierz skwantowana
+/// @return Przyblizenie macierzy zrodlowej (blad najwyzej skala / 2 na element)
+matrix dequantize(const quantized_matrix& q);
+
+/// @brief Iloczyn macierzy skwantowanych - A * B
+/// Mnozenie int8 x int8 z akumulacja int32 (detail::gemm_i8), wynik
+/// przeskalowany do double.
+/// @param A Lewy operand ze skalami wierszy
+/// @param B Prawy operand ze skalami kolumn
+/// @return Macierz A.rows x B.cols
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+/// @throw std::runtime_error jesli A nie ma skal wierszy lub B skal kolumn
+matrix operator*(const quantized_matrix& A, const quantized_matrix& B);
@@ -0,0 +1,112 @@
+#pragma once
+#include "matrix.h"
+#include <limits>
+
+/// @file semiring.h
+/// @brief Mnozenie macierzy nad dowolnym polpierscieniem
+///
+/// Zwykly iloczyn C(i, j) = sum_p A(i, p) * B(p, j) jest szczegolnym
+/// przypadkiem iloczynu nad polpierscieniem (+, *). Zamiana dzialan daje
+/// m.in. algebre tropikalna: w (min, +) iloczyn macierzy wag to najkrotsze
+/// sciezki o dwukrotnej liczbie krawedzi, a w (max, +) na logarytmach
+/// prawdopodobienstw - krok algorytmu Viterbiego.
+///
+/// Polpierscien to typ ze stala `zero` (element neutralny dodawania,
+/// pochlaniajacy przy mnozeniu) i statycznymi szablonami `add(a, b)`
+/// i `mul(a, b)`. Szablony sa wywolywane zarowno dla double, jak i dla
+/// wektorow GCC (`vector_size`), wiec moga uzywac tylko operatorow
+/// arytmetycznych, porownan i `?:` - wtedy mikro-jadro jest wektoryzowane
+/// bez pisania intrinsics dla kazdego polpierscienia.
+
+/// @brief Zwykla arytmetyka (+, *) - jak operator*
+struct plus_times {
+    /// @brief Element neutralny dodawania
+    static constexpr double zero = 0.0;
+
+    /// @brief Dodawanie polpierscienia
+    template <typename V>
+    static V add(const V& a, const V& b) { return a + b; }
+
+    /// @brief Mnozenie polpierscienia
+    template <typename V>
+    static V mul(const V& a, const V& b) { return a * b; }
+};
+
+/// @brief Polpierscien tropikalny (min, +) - najkrotsze sciezki
+/// Brak krawedzi oznacza sie przez +inf (min_plus::zero).
+struct min_plus {
+    /// @brief Element neutralny dodawania (+inf)
+    static constexpr double zero = std::numeric_limits<double>::infinity();
+
+    /// @brief Dodawanie polpierscienia - minimum
+    template <typename V>
+    static V add(const V& a, const V& b) { return b < a ? b : a; }
+
+    /// @brief Mnozenie polpierscienia - suma
+    template <typename V>
+    static V mul(const V& a, const V& b) { return a + b; }
+};
+
+/// @brief Polpierscien tropikalny (max, +) - najdluzsze sciezki, Viterbi na logarytmach
+/// Brak krawedzi oznacza sie przez -inf (max_plus::zero).
+struct max_plus {
+    /// @brief Element neutralny dodawania (-inf)
+    static constexpr double zero = -std::numeric_limits<double>::infinity();
+
+    /// @brief Dodawanie polpierscienia - maksimum
+    template <typename V>
+    static V add(const V& a, const V& b) { return a < b ? b : a; }
+
+    /// @brief Mnozenie polpierscienia - suma
+    template <typename V>
+    static V mul(const V& a, const V& b) { return a + b; }
+};
+
+/// @brief Polpierscien logiczny (OR, AND) - osiagalnosc w grafie, zlozenie relacji
+/// Wartosci 0 i 1 (falsz i prawda); na nich add to OR (maksimum), a mul -
+/// AND (minimum). multiply() traktuje kazdy element rozny od zera jak
+/// prawde i liczy iloczyn przez bool_matrix (64 elementy w slowie), wiec
+/// wynik zawiera tylko 0 i 1.
+struct or_and {
+    /// @brief Element neutralny dodawania (falsz)
+    static constexpr double zero = 0.0;
+
+    /// @brief Dodawanie polpierscienia - OR
+    template <typename V>
+    static V add(const V& a, const V& b) { return a < b ? b : a; }
+
+    /// @brief Mnozenie polpierscienia - AND
+    template <typename V>
+    static V mul(const V& a, const V& b) { return b < a ? b : a; }
+};
+
+/// @brief Iloczyn A * B nad polpierscieniem S: C(i, j) = add_p mul(A(i, p), B(p, j))
+///
+/// Liczy go silnik blokowy operator* (pakowanie paneli pod cache, petle
+/// NC -> KC -> MC, podzial kafelkow wyniku miedzy watki puli) z wlasnym
+/// mikro-jadrem polpierscienia: S::add / S::mul skompilowanymi dla
+/// wektorow SSE2 / AVX2 / AVX-512, wybieranych przy starcie. Szablon jest
+/// konkretyzowany w src/matrix_semiring.cpp dla plus_times, min_plus
+/// i max_plus; nowy polpierscien wymaga tam dopisania jednej linii.
+/// Dla or_and jest wyspecjalizowany (iloczyn bool_matrix).
+///
+/// Przyklad: `multiply(D, D, min_plus{})` - najkrotsze sciezki o co najwyzej
+/// dwoch krawedziach dla macierzy wag D z zerami na przekatnej.
+///
+/// @param A Lewy operand
+/// @param B Prawy operand
+/// @return Nowa macierz z iloczynem (dla A.cols == 0 wypelniona S::zero)
+/// @throw std::runtime_error jesli A.cols != B.rows
+template <typename S>
+matrix multiply(const matrix& A, const matrix& B, S);
+
+extern template matrix multiply(const matrix&, const matrix&, plus_times);
+extern template matrix multiply(const matrix&, const matrix&, min_plus);
+extern template matrix multiply(const matrix&, const matrix&, max_plus);
+
+/// @brief Iloczyn logiczny: C(i, j) = 1, jesli A(i, p) != 0 i B(p, j) != 0 dla pewnego p
+/// Operandy sa zamieniane na bool_matrix, a iloczyn liczony metoda
+/// "czterech Rosjan" (bool_matrix operator*).
+/// @throw std::runtime_error jesli A.cols != B.rows
+template <>
+matrix multiply(const matrix& A, const matrix& B, or_and);
@@ -0,0 +1,172 @@
+#pragma once
+#include "matrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @file sparse_matrix.h
+/// @brief Macierz rzadka w formacie CSR lub CSC
+///
+/// Przechowywane sa tylko elementy niezerowe: w formacie CSR wierszami,
+/// w CSC kolumnami. Dla wymiaru glownego (wierszy w CSR, kolumn w CSC)
+/// tablica wskaznikow o dlugosci rozmiar + 1 wskazuje poczatek elementow
+/// danego wiersza (kolumny) w tablicach indeksow i wartosci, a indeksy
+/// w obrebie wiersza (kolumny) sa scisle rosnace. Pamiec i czas operacji
+/// sa proporcjonalne do liczby elementow niezerowych (nnz), a nie do
+/// iloczynu wymiarow.
+
+/// @brief Sposob ulozenia elementow macierzy rzadkiej
+enum class sparse_format {
+    csr, ///< wierszami (Compressed Sparse Row)
+    csc  ///< kolumnami (Compressed Sparse Column)
+};
+
+/// @brief Element macierzy rzadkiej podany wspolrzednymi (format COO)
+struct sparse_entry {
+    std::size_t row; ///< indeks wiersza
+    std::size_t col; ///< indeks kolumny
+    double value;    ///< wartosc elementu
+};
+
+/// @class sparse_matrix
+/// @brief Macierz rzadka double w formacie CSR albo CSC
+class sparse_matrix {
+public:
+    /// @brief Typ indeksu wymiaru pobocznego (4 bajty zamiast 8 na element)
+    using index_type = std::uint32_t;
+
+    /// @brief Konstruktor domyslny - macierz 0x0
+    sparse_matrix() = default;
+
+    /// @brief Konstruktor macierzy zerowej
+    /// @param rows Liczba wierszy
+    /// @param cols Liczba kolumn
+    /// @param format Ulozenie elementow
+    /// @throw std::runtime_error jesli wymiar nie miesci sie w index_type
+    sparse_matrix(std::size_t rows, std::size_t cols, sparse_format format = sparse_format::csr);
+
+    /// @brief Konstruktor z macierzy gestej - zapamietuje elementy rozne od zera
+    /// @param m Macierz zrodlowa
+    /// @param format Ulozenie elementow
+    explicit sparse_matrix(const matrix& m, sparse_format format = sparse_format::csr);
+
+    /// @brief Konstruktor z listy elementow (np. krawedzi grafu)
+    /// Elementy moga byc podane w dowolnej kolejnosci; powtorzenia tej samej
+    /// pozycji sa sumowane.
+    /// @param rows Liczba wierszy
+    /// @param cols Liczba kolumn
+    /// @param elementy Elementy niezerowe
+    /// @param format Ulozenie elementow
+    /// @throw std::runtime_error jesli indeks elementu wykracza poza wymiary
+    sparse_matrix(std::size_t rows, std::size_t cols, const std::vector<sparse_entry>& elementy,
+                  sparse_format format = sparse_format::csr);
+
+    /// @brief Konstruktor z gotowych tablic formatu CSR/CSC
+    /// @param rows Liczba wierszy
+    /// @param cols Liczba kolumn
+    /// @param wskazniki Poczatki wierszy (CSR) lub kolumn (CSC), rozmiar + 1 pozycji
+    /// @param indeksy Indeksy kolumn (CSR) lub wierszy (CSC), scisle rosnace w wierszu
+    /// @param wartosci Wartosci elementow
+    /// @param format Ulozenie elementow
+    /// @throw std::runtime_error jesli tablice nie opisuja poprawnej macierzy
+    sparse_matrix(std::size_t rows, std::size_t cols, std::vector<std::size_t> wskazniki,
+                  std::vector<index_type> indeksy, std::vector<double> wartosci,
+                  sparse_format format = sparse_format::csr);
+
+    /// @brief Zwraca liczbe wierszy
+    std::size_t get_rows() const noexcept { return rows; }
+
+    /// @brief Zwraca liczbe kolumn
+    std::size_t get_cols() const noexcept { return cols; }
+
+    /// @brief Zwraca liczbe zapamietanych elementow
+    std::size_t nnz() const noexcept { return wartosci.size(); }
+
+    /// @brief Zwraca ulozenie elementow
+    sparse_format format() const noexcept { return uklad; }
+
+    /// @brief Poczatki wierszy (CSR) lub kolumn (CSC) w indices() i values()
+    const std::vector<std::size_t>& pointers() const noexcept { return wskazniki; }
+
+    /// @brief Indeksy kolumn (CSR) lub wierszy (CSC) kolejnych elementow
+    const std::vector<index_type>& indices() const noexcept { return indeksy; }
+
+    /// @brief Wartosci kolejnych elementow
+    const std::vector<double>& values() const noexcept { return wartosci; }
+
+    /// @brief Element (i, j); zero, jesli nie jest zapamietany
+    /// Wyszukiwanie binarne w wierszu (kolumnie) - O(log nnz wiersza).
+    /// Indeksy nie sa sprawdzane, jak w matrix::operator().
+    double operator()(std::size_t i, std::size_t j) const noexcept;
+
+    /// @brief Ta sama macierz w formacie CSR (kopia, jesli juz jest CSR)
+    sparse_matrix to_csr() const;
+
+    /// @brief Ta sama macierz w formacie CSC (kopia, jesli juz jest CSC)
+    sparse_matrix to_csc() const;
+
+    /// @brief Macierz transponowana
+    /// Tablice sa kopiowane bez przestawiania: CSR macierzy to CSC jej
+    /// transpozycji, wiec wynik ma przeciwny format.
+    sparse_matrix transpose() const;
+
+    /// @brief Zamiana na macierz gesta
+    matrix to_matrix() const;
+
+    /// @brief Mnozenie przez skalar w miejscu (struktura bez zmian)
+    sparse_matrix& operator*=(double s) noexcept;
+
+private:
+    /// @brief Rozmiar wymiaru glownego (wiersze w CSR, kolumny w CSC)
+    std::size_t glowny() const noexcept { return uklad == sparse_format::csr ? rows : cols; }
+
+    /// @brief Ta sama macierz w przeciwnym formacie (sortowanie kubelkowe, O(nnz))
+    sparse_matrix przestaw() const;
+
+    std::size_t rows = 0, cols = 0;
+    sparse_format uklad = sparse_format::csr;
+    std::vector<std::size_t> wskazniki = {0};
+    std::vector<index_type> indeksy;
+    std::vector<double> wartosci;
+};
+
+/// @brief Iloczyn macierzy rzadkiej i wektora - A * x (SpMV), wielowatkowo
+/// @param A Macierz rzadka
+/// @param x Wektor o A.cols elementach
+/// @return Wektor o A.rows elementach
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+std::vector<double> operator*(const sparse_matrix& A, const std::vector<double>& x);
+
+/// @brief Iloczyn macierzy rzadkiej i gestej - A * B
+/// @throw std::runtime_error jesli A.cols != B.rows
+matrix operator*(const sparse_matrix& A, const matrix& B);
+
+/// @brief Iloczyn macierzy gestej i rzadkiej - A * B
+/// @throw std::runtime_error jesli A.cols != B.rows
+matrix operator*(const matrix& A, const sparse_matrix& B);
+
+/// @brief Iloczyn macierzy rzadkich - A * B (SpGEMM), wynik w CSR
+/// @throw std::runtime_error jesli A.cols != B.rows
+sparse_matrix operator*(const sparse_matrix& A, const sparse_matrix& B);
+
+/// @brief Suma macierzy rzadkich; wynik ma format A i elementy z sumy struktur
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+sparse_matrix operator+(const sparse_matrix& A, const sparse_matrix& B);
+
+/// @brief Roznica macierzy rzadkich; wynik ma format A i elementy z sumy struktur
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+sparse_matrix operator-(const sparse_matrix& A, const sparse_matrix& B);
+
+/// @brief Macierz przeciwna (struktura bez zmian)
+sparse_matrix operator-(sparse_matrix A);
+
+/// @brief Mnozenie przez skalar (struktura bez zmian)
+sparse_matrix operator*(sparse_matrix A, double s);
+
+/// @brief Mnozenie przez skalar (struktura bez zmian)
+sparse_matrix operator*(double s, sparse_matrix A);
+
+/// @brief Iloczyn Hadamarda (element po elemencie); wynik ma format A
+/// i elementy tylko tam, gdzie oba operandy je maja
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+sparse_matrix hadamard(const sparse_matrix& A, const sparse_matrix& B);
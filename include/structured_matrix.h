@@ -0,0 +1,341 @@
+#pragma once
+#include "matrix.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/// @file structured_matrix.h
+/// @brief Macierze kwadratowe o znanej strukturze: diagonalna, pasmowa, trojkatna, symetryczna
+///
+/// Kazdy typ przechowuje tylko elementy swojej struktury (n, n * (kl + ku + 1)
+/// lub n * (n + 1) / 2 liczb), a mnozenie, dodawanie i rozwiazywanie ukladow
+/// kosztuja O(n * szerokosc pasma) zamiast O(n^3) dla macierzy gestej.
+/// Elementy spoza struktury sa zerami; to_matrix() tworzy macierz gesta
+/// dopiero na zadanie.
+
+/// @class diagonal_matrix
+/// @brief Macierz diagonalna n x n - tylko elementy przekatnej
+class diagonal_matrix {
+public:
+    /// @brief Konstruktor domyslny - macierz 0x0
+    diagonal_matrix() = default;
+
+    /// @brief Macierz zerowa n x n
+    explicit diagonal_matrix(std::size_t n) : d(n, 0.0) {}
+
+    /// @brief Macierz z podana przekatna
+    explicit diagonal_matrix(std::vector<double> przekatna) : d(std::move(przekatna)) {}
+
+    /// @brief Przekatna macierzy gestej (pozostale elementy sa pomijane)
+    /// @throw std::runtime_error jesli m nie jest kwadratowa
+    explicit diagonal_matrix(const matrix& m);
+
+    /// @brief Zwraca rozmiar n
+    std::size_t size() const noexcept { return d.size(); }
+
+    /// @brief Element przekatnej (do zapisu)
+    double& operator[](std::size_t i) noexcept { return d[i]; }
+
+    /// @brief Element przekatnej (do odczytu)
+    double operator[](std::size_t i) const noexcept { return d[i]; }
+
+    /// @brief Element (i, j); zero poza przekatna
+    double operator()(std::size_t i, std::size_t j) const noexcept { return i == j ? d[i] : 0.0; }
+
+    /// @brief Elementy przekatnej
+    const std::vector<double>& diagonal() const noexcept { return d; }
+
+    /// @brief Zamiana na macierz gesta
+    matrix to_matrix() const;
+
+private:
+    std::vector<double> d;
+};
+
+/// @class banded_matrix
+/// @brief Macierz pasmowa n x n z kl przekatnymi pod i ku nad glowna
+///
+/// Wiersz i zajmuje kl + ku + 1 kolejnych liczb dla kolumn i - kl .. i + ku
+/// (pozycje poza macierza w pierwszych i ostatnich wierszach sa zerami),
+/// wiec wiersz pasma jest ciagly w pamieci.
+class banded_matrix {
+public:
+    /// @brief Konstruktor domyslny - macierz 0x0
+    banded_matrix() = default;
+
+    /// @brief Macierz zerowa n x n o szerokosciach pasma kl (pod) i ku (nad)
+    banded_matrix(std::size_t n, std::size_t kl, std::size_t ku);
+
+    /// @brief Pasmo macierzy gestej (elementy spoza pasma sa pomijane)
+    /// @throw std::runtime_error jesli m nie jest kwadratowa
+    banded_matrix(const matrix& m, std::size_t kl, std::size_t ku);
+
+    /// @brief Zwraca rozmiar n
+    std::size_t size() const noexcept { return n; }
+
+    /// @brief Liczba przekatnych pod glowna
+    std::size_t lower() const noexcept { return kl; }
+
+    /// @brief Liczba przekatnych nad glowna
+    std::size_t upper() const noexcept { return ku; }
+
+    /// @brief Sprawdz, czy element (i, j) lezy w pasmie
+    bool in_band(std::size_t i, std::size_t j) const noexcept { return j + kl >= i && j <= i + ku; }
+
+    /// @brief Element (i, j) w pasmie (do zapisu); poza pasmem zachowanie niezdefiniowane
+    double& operator()(std::size_t i, std::size_t j) noexcept { return pasmo[i * szerokosc() + j + kl - i]; }
+
+    /// @brief Element (i, j); zero poza pasmem
+    double operator()(std::size_t i, std::size_t j) const noexcept {
+        return in_band(i, j) ? pasmo[i * szerokosc() + j + kl - i] : 0.0;
+    }
+
+    /// @brief Poczatek wiersza pasma i (element (i, i - kl))
+    const double* band_row(std::size_t i) const noexcept { return pasmo.data() + i * szerokosc(); }
+
+    /// @brief Zamiana na macierz gesta
+    matrix to_matrix() const;
+
+private:
+    /// @brief Liczba elementow wiersza pasma
+    std::size_t szerokosc() const noexcept { return kl + ku + 1; }
+
+    std::size_t n = 0, kl = 0, ku = 0;
+    std::vector<double> pasmo;
+};
+
+/// @brief Rodzaj macierzy trojkatnej
+enum class triangle {
+    lower, ///< elementy na i pod przekatna (j <= i)
+    upper  ///< elementy na i nad przekatna (j >= i)
+};
+
+/// @class triangular_matrix
+/// @brief Macierz trojkatna n x n upakowana wierszami (n * (n + 1) / 2 liczb)
+class triangular_matrix {
+public:
+    /// @brief Konstruktor domyslny - macierz 0x0
+    triangular_matrix() = default;
+
+    /// @brief Macierz zerowa n x n
+    triangular_matrix(std::size_t n, triangle rodzaj);
+
+    /// @brief Trojkat macierzy gestej (elementy spoza trojkata sa pomijane)
+    /// @throw std::runtime_error jesli m nie jest kwadratowa
+    triangular_matrix(const matrix& m, triangle rodzaj);
+
+    /// @brief Zwraca rozmiar n
+    std::size_t size() const noexcept { return n; }
+
+    /// @brief Zwraca rodzaj trojkata
+    triangle kind() const noexcept { return rodzaj; }
+
+    /// @brief Sprawdz, czy element (i, j) lezy w trojkacie
+    bool in_triangle(std::size_t i, std::size_t j) const noexcept {
+        return rodzaj == triangle::lower ? j <= i : j >= i;
+    }
+
+    /// @brief Element (i, j) w trojkacie (do zapisu); poza nim zachowanie niezdefiniowane
+    double& operator()(std::size_t i, std::size_t j) noexcept { return dane[indeks(i, j)]; }
+
+    /// @brief Element (i, j); zero poza trojkatem
+    double operator()(std::size_t i, std::size_t j) const noexcept {
+        return in_triangle(i, j) ? dane[indeks(i, j)] : 0.0;
+    }
+
+    /// @brief Poczatek upakowanego wiersza i (kolumna 0 dla lower, i dla upper)
+    const double* packed_row(std::size_t i) const noexcept { return dane.data() + poczatek(i); }
+
+    /// @brief Pierwsza kolumna zapamietana w wierszu i
+    std::size_t row_begin(std::size_t i) const noexcept { return rodzaj == triangle::lower ? 0 : i; }
+
+    /// @brief Kolumna za ostatnia zapamietana w wierszu i
+    std::size_t row_end(std::size_t i) const noexcept { return rodzaj == triangle::lower ? i + 1 : n; }
+
+    /// @brief Zamiana na macierz gesta
+    matrix to_matrix() const;
+
+    /// @brief Wszystkie elementy trojkata kolejnymi wierszami
+    const std::vector<double>& packed() const noexcept { return dane; }
+
+    /// @brief Wszystkie elementy trojkata kolejnymi wierszami (do zapisu)
+    std::vector<double>& packed() noexcept { return dane; }
+
+private:
+    /// @brief Polozenie wiersza i w upakowanej tablicy
+    std::size_t poczatek(std::size_t i) const noexcept {
+        return rodzaj == triangle::lower ? i * (i + 1) / 2 : i * n - i * (i - 1) / 2;
+    }
+
+    /// @brief Polozenie elementu (i, j) w upakowanej tablicy
+    std::size_t indeks(std::size_t i, std::size_t j) const noexcept { return poczatek(i) + j - row_begin(i); }
+
+    std::size_t n = 0;
+    triangle rodzaj = triangle::lower;
+    std::vector<double> dane;
+};
+
+/// @class symmetric_matrix
+/// @brief Macierz symetryczna n x n - gorny trojkat upakowany wierszami
+///
+/// Element (i, j) i (j, i) to ta sama liczba, zapisana w wierszu min(i, j).
+/// Uklad pamieci jest taki sam jak triangular_matrix z triangle::upper.
+class symmetric_matrix {
+public:
+    /// @brief Konstruktor domyslny - macierz 0x0
+    symmetric_matrix() = default;
+
+    /// @brief Macierz zerowa n x n
+    explicit symmetric_matrix(std::size_t rozmiar) : n(rozmiar), dane(rozmiar * (rozmiar + 1) / 2, 0.0) {}
+
+    /// @brief Gorny trojkat macierzy gestej (dolny jest pomijany)
+    /// @throw std::runtime_error jesli m nie jest kwadratowa
+    explicit symmetric_matrix(const matrix& m);
+
+    /// @brief Zwraca rozmiar n
+    std::size_t size() const noexcept { return n; }
+
+    /// @brief Element (i, j) == (j, i) (do zapisu)
+    double& operator()(std::size_t i, std::size_t j) noexcept { return dane[indeks(i, j)]; }
+
+    /// @brief Element (i, j) == (j, i) (do odczytu)
+    double operator()(std::size_t i, std::size_t j) const noexcept { return dane[indeks(i, j)]; }
+
+    /// @brief Poczatek upakowanego wiersza i (elementy (i, i) .. (i, n - 1))
+    const double* packed_row(std::size_t i) const noexcept { return dane.data() + poczatek(i); }
+
+    /// @brief Gorny trojkat kolejnymi wierszami
+    const std::vector<double>& packed() const noexcept { return dane; }
+
+    /// @brief Gorny trojkat kolejnymi wierszami (do zapisu)
+    std::vector<double>& packed() noexcept { return dane; }
+
+    /// @brief Zamiana na macierz gesta (oba trojkaty)
+    matrix to_matrix() const;
+
+private:
+    /// @brief Polozenie wiersza i w upakowanej tablicy
+    std::size_t poczatek(std::size_t i) const noexcept { return i * n - i * (i - 1) / 2; }
+
+    /// @brief Polozenie elementu (i, j) w upakowanej tablicy
+    std::size_t indeks(std::size_t i, std::size_t j) const noexcept {
+        return i <= j ? poczatek(i) + j - i : poczatek(j) + i - j;
+    }
+
+    std::size_t n = 0;
+    std::vector<double> dane;
+};
+
+/// @brief Iloczyn D * x
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+std::vector<double> operator*(const diagonal_matrix& D, const std::vector<double>& x);
+
+/// @brief Iloczyn D * M (skalowanie wierszy M)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+matrix operator*(const diagonal_matrix& D, const matrix& M);
+
+/// @brief Iloczyn M * D (skalowanie kolumn M)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+matrix operator*(const matrix& M, const diagonal_matrix& D);
+
+/// @brief Iloczyn macierzy diagonalnych
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+diagonal_matrix operator*(const diagonal_matrix& A, const diagonal_matrix& B);
+
+/// @brief Suma macierzy diagonalnych
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+diagonal_matrix operator+(const diagonal_matrix& A, const diagonal_matrix& B);
+
+/// @brief Roznica macierzy diagonalnych
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+diagonal_matrix operator-(const diagonal_matrix& A, const diagonal_matrix& B);
+
+/// @brief Rozwiazanie ukladu D * x = b
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja lub D jest osobliwa
+std::vector<double> solve(const diagonal_matrix& D, const std::vector<double>& b);
+
+/// @brief Rozwiazanie ukladow D * X = B (kazda kolumna B osobno)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja lub D jest osobliwa
+matrix solve(const diagonal_matrix& D, const matrix& B);
+
+/// @brief Iloczyn A * x - O(n * (kl + ku))
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+std::vector<double> operator*(const banded_matrix& A, const std::vector<double>& x);
+
+/// @brief Iloczyn A * M - O(n * (kl + ku) * M.cols)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+matrix operator*(const banded_matrix& A, const matrix& M);
+
+/// @brief Iloczyn macierzy pasmowych; pasmo wyniku: kl = A.kl + B.kl, ku = A.ku + B.ku
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+banded_matrix operator*(const banded_matrix& A, const banded_matrix& B);
+
+/// @brief Suma macierzy pasmowych; pasmo wyniku to szersze z pasm operandow
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+banded_matrix operator+(const banded_matrix& A, const banded_matrix& B);
+
+/// @brief Roznica macierzy pasmowych; pasmo wyniku to szersze z pasm operandow
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+banded_matrix operator-(const banded_matrix& A, const banded_matrix& B);
+
+/// @brief Rozwiazanie ukladu A * x = b eliminacja Gaussa z wyborem elementu
+/// glownego w pasmie - O(n * kl * (kl + ku))
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja lub A jest osobliwa
+std::vector<double> solve(const banded_matrix& A, const std::vector<double>& b);
+
+/// @brief Rozwiazanie ukladow A * X = B (jeden rozklad dla wszystkich kolumn B)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja lub A jest osobliwa
+matrix solve(const banded_matrix& A, const matrix& B);
+
+/// @brief Iloczyn T * x - O(n^2 / 2)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+std::vector<double> operator*(const triangular_matrix& T, const std::vector<double>& x);
+
+/// @brief Iloczyn T * M - O(n^2 / 2 * M.cols)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+matrix operator*(const triangular_matrix& T, const matrix& M);
+
+/// @brief Iloczyn macierzy trojkatnych tego samego rodzaju (wynik tez trojkatny)
+/// @throw std::runtime_error jesli wymiary lub rodzaje sie nie zgadzaja
+triangular_matrix operator*(const triangular_matrix& A, const triangular_matrix& B);
+
+/// @brief Suma macierzy trojkatnych tego samego rodzaju
+/// @throw std::runtime_error jesli wymiary lub rodzaje sie nie zgadzaja
+triangular_matrix operator+(const triangular_matrix& A, const triangular_matrix& B);
+
+/// @brief Roznica macierzy trojkatnych tego samego rodzaju
+/// @throw std::runtime_error jesli wymiary lub rodzaje sie nie zgadzaja
+triangular_matrix operator-(const triangular_matrix& A, const triangular_matrix& B);
+
+/// @brief Rozwiazanie ukladu T * x = b podstawianiem w przod (lower) lub wstecz (upper)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja lub T jest osobliwa
+std::vector<double> solve(const triangular_matrix& T, const std::vector<double>& b);
+
+/// @brief Rozwiazanie ukladow T * X = B
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja lub T jest osobliwa
+matrix solve(const triangular_matrix& T, const matrix& B);
+
+/// @brief Iloczyn symetryczny liczony tylko dla gornego trojkata (SYRK)
+/// trans::none daje A * Aᵀ (A.rows x A.rows), trans::transpose - Aᵀ * A
+/// (macierz Grama kolumn, A.cols x A.cols). Liczba mnozen i pamiec wyniku
+/// sa o polowe mniejsze niz dla gemm().
+/// @param A Macierz zrodlowa
+/// @param t Ktory z iloczynow liczyc
+/// @return Macierz symetryczna
+symmetric_matrix syrk(const matrix& A, trans t = trans::none);
+
+/// @brief Iloczyn S * x
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+std::vector<double> operator*(const symmetric_matrix& S, const std::vector<double>& x);
+
+/// @brief Iloczyn S * M (SYMM)
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+matrix operator*(const symmetric_matrix& S, const matrix& M);
+
+/// @brief Suma macierzy symetrycznych
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+symmetric_matrix operator+(const symmetric_matrix& A, const symmetric_matrix& B);
+
+/// @brief Roznica macierzy symetrycznych
+/// @throw std::runtime_error jesli wymiary sie nie zgadzaja
+symmetric_matrix operator-(const symmetric_matrix& A, const symmetric_matrix& B);
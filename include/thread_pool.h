@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/// @class thread_pool
+/// @brief Trwala pula watkow biblioteki z rownowazeniem obciazenia przez kradziez zadan
+///
+/// Pula jest tworzona przy pierwszym rownoleglym wywolaniu i zyje do konca
+/// programu. Zadania jednego wywolania parallel_for() sa rozdzielane po rowno
+/// miedzy watki; watek, ktory skonczy swoja czesc, kradnie polowe pozostalych
+/// zadan innego watku (work stealing). Watek wywolujacy rowniez wykonuje zadania.
+///
+/// Wywolania zagniezdzone (z wnetrza zadania) oraz prace mniejsze niz prog
+/// serial_cutoff wykonywane sa szeregowo, bez kosztu budzenia watkow.
+class thread_pool {
+public:
+    /// @brief Zwraca globalna pule biblioteki
+    /// Domyslna liczba watkow to std::thread::hardware_concurrency()
+    /// lub wartosc zmiennej srodowiskowej MATRIX_THREADS.
+    /// @return Referencja na pule
+    static thread_pool& instance();
+
+    /// @brief Destruktor - zatrzymuje i dolacza wszystkie watki
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /// @brief Ustaw liczbe watkow (lacznie z watkiem wywolujacym)
+    /// Nie moze byc wywolywana z wnetrza zadania puli (czekalaby na samo siebie).
+    /// @param n Liczba watkow; 0 oznacza hardware_concurrency(), 1 wylacza rownoleglosc
+    /// @throw std::runtime_error jesli wywolanie pochodzi z wnetrza zadania puli
+    void set_threads(std::size_t n);
+
+    /// @brief Zwraca liczbe watkow (lacznie z watkiem wywolujacym)
+    /// @return Liczba watkow
+    std::size_t get_threads() const noexcept;
+
+    /// @brief Ustaw prog pracy, ponizej ktorego operacje wykonuja sie szeregowo
+    /// @param work Prog w jednostkach pracy (liczba elementow dla operacji
+    ///        element po elemencie, m*n*k dla mnozenia macierzy)
+    void set_serial_cutoff(std::size_t work) noexcept;
+
+    /// @brief Zwraca prog pracy dla wykonania szeregowego
+    /// @return Prog w jednostkach pracy
+    std::size_t get_serial_cutoff() const noexcept;
+
+    /// @brief Sprawdz, czy praca danej wielkosci powinna byc zrownoleglona
+    /// @param work Wielkosc pracy w jednostkach jak dla set_serial_cutoff()
+    /// @return Prawda, jesli jest wiecej niz jeden watek, praca przekracza prog
+    ///         i wywolanie nie pochodzi z wnetrza zadania puli
+    bool should_parallelize(std::size_t work) const noexcept;
+
+    /// @brief Wykonaj f(i) dla i = 0..n-1 na watkach puli
+    /// Wraca dopiero po wykonaniu wszystkich zadan. Pierwszy wyjatek
+    /// rzucony przez zadanie jest przekazywany do wywolujacego.
+    /// @param n Liczba zadan
+    /// @param f Funkcja wywolywana z indeksem zadania
+    template <typename F>
+    void parallel_for(std::size_t n, F&& f) {
+        using Fn = std::remove_reference_t<F>;
+        run(n, [](void* ctx, std::size_t i) { (*static_cast<Fn*>(ctx))(i); },
+            const_cast<void*>(static_cast<const void*>(std::addressof(f))));
+    }
+
+    /// @brief Podziel wiersze na zakresy i wykonaj f(r0, r1) dla kazdego zakresu
+    /// Dla pracy ponizej progu f(0, rows) wywolywane jest bezposrednio.
+    /// @param rows Liczba wierszy
+    /// @param work_per_row Praca przypadajaca na jeden wiersz (zwykle liczba kolumn)
+    /// @param f Funkcja przetwarzajaca wiersze [r0, r1)
+    template <typename F>
+    void parallel_rows(std::size_t rows, std::size_t work_per_row, F&& f) {
+        if (rows < 2 || !should_parallelize(rows * work_per_row)) {
+            f(std::size_t{0}, rows);
+            return;
+        }
+        // Kilka zakresow na watek, aby kradziez zadan miala co wyrownywac
+        std::size_t zakresy = get_threads() * 4;
+        if (zakresy > rows) zakresy = rows;
+        parallel_for(zakresy, [&](std::size_t t) {
+            f(rows * t / zakresy, rows * (t + 1) / zakresy);
+        });
+    }
+
+private:
+    thread_pool();
+
+    /// @brief Wykonanie zadania opisanego wskaznikiem funkcji i kontekstem
+    void run(std::size_t n, void (*fn)(void*, std::size_t), void* ctx);
+
+    struct impl;
+    std::unique_ptr<impl> p;
+};
@@ -3,7 +3,30 @@ setlocal enabledelayedexpansion
 
 set OUT=main.exe
 
-g++ -Wall -Wextra -std=c++17 ./src/*.cpp -o %OUT%
+rem run.bat test - testy (tests\*.cpp) pod kazda wartoscia MATRIX_ISA, szeregowo i na 4 watkach
+if "%1"=="test" (
+    set SRC=
+    for %%f in (src\*.cpp) do if /I not "%%~nxf"=="main.cpp" set SRC=!SRC! %%f
+    g++ -O2 -pthread -Wall -Wextra -std=c++17 !SRC! tests\*.cpp -o tests_main.exe
+    if ERRORLEVEL 1 (
+        pause
+        exit /b 1
+    )
+    set STATUS=0
+    for %%i in (scalar sse2 avx2 avx512) do (
+        for %%t in (1 4) do (
+            echo == MATRIX_ISA=%%i MATRIX_THREADS=%%t
+            set MATRIX_ISA=%%i
+            set MATRIX_THREADS=%%t
+            tests_main.exe
+            if ERRORLEVEL 1 set STATUS=1
+        )
+    )
+    pause
+    exit /b !STATUS!
+)
+
+g++ -O2 -pthread -Wall -Wextra -std=c++17 ./src/*.cpp -o %OUT%
 if ERRORLEVEL 1 (
     pause
     exit /b 1
@@ -4,7 +4,24 @@ OUT="main"
 
 clear
 
-g++ -Wall -Wextra -std=c++17 ./src/*.cpp -o $OUT
+# ./run.sh test - testy (tests/*.cpp) pod kazda wartoscia MATRIX_ISA, szeregowo i na 4 watkach
+if [ "$1" = "test" ]; then
+    SRC=()
+    for f in ./src/*.cpp; do
+        [ "$f" != "./src/main.cpp" ] && SRC+=("$f")
+    done
+    g++ -O2 -pthread -Wall -Wextra -std=c++17 "${SRC[@]}" ./tests/*.cpp -o tests_main || exit 1
+    STATUS=0
+    for ISA in scalar sse2 avx2 avx512; do
+        for THREADS in 1 4; do
+            echo "== MATRIX_ISA=$ISA MATRIX_THREADS=$THREADS"
+            MATRIX_ISA=$ISA MATRIX_THREADS=$THREADS ./tests_main || STATUS=1
+        done
+    done
+    exit $STATUS
+fi
+
+g++ -O2 -pthread -Wall -Wextra -std=c++17 ./src/*.cpp -o $OUT
 
 if [ $? -eq 0 ]; then
     ./$OUT
@@ -0,0 +1,57 @@
+#include "../include/matrix.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+
+/**
+ * @brief Wsadowe mnożenie par małych macierzy - C[g] = A[g] * B[g]
+ *
+ * Przeznaczone dla milionów iloczynów 2×2 … 8×8 (transformacje 3×3,
+ * macierze jednorodne 4×4), dla których koszt wywołania operator*
+ * i alokacji wyniku wielokrotnie przewyższa samo mnożenie.
+ * Jądro SIMD liczy kilka iloczynów naraz: jeden rejestr zawiera ten
+ * sam element kolejnych macierzy wsadu (2 dla SSE2, 4 dla AVX2,
+ * 8 dla AVX-512). Większe macierze liczone są po kolei zwykłą pętlą.
+ * Duże wsady dzielone są między wątki puli.
+ *
+ * Funkcja nie alokuje pamięci - wynik trafia do bufora wywołującego.
+ *
+ * @param count liczba par macierzy
+ * @param m liczba wierszy A[g] i C[g]
+ * @param n liczba kolumn B[g] i C[g]
+ * @param k liczba kolumn A[g] i wierszy B[g]
+ * @param A count macierzy m × k zapisanych kolejno, każda wierszami
+ * @param B count macierzy k × n zapisanych kolejno, każda wierszami
+ * @param C bufor na count macierzy m × n (nie może nakładać się na A i B)
+ *
+ * @complexity O(count × m × n × k)
+ *
+ * @example
+ * @code
+ * std::vector<double> a(9 * N), b(9 * N), c(9 * N);
+ * gemm_batched(N, 3, 3, 3, a.data(), b.data(), c.data());
+ * @endcode
+ */
+void gemm_batched(std::size_t count, std::size_t m, std::size_t n, std::size_t k,
+                  const double* A, const double* B, double* C) {
+    if (count == 0 || m == 0 || n == 0) {
+        return;
+    }
+    const std::size_t sa = m * k, sb = k * n, sc = m * n;
+    const bool simd = std::max({m, n, k}) <= detail::simd_batch_max;
+    const auto& jadra = detail::kernels();
+
+    thread_pool::instance().parallel_rows(count, m * n * std::max<std::size_t>(k, 1),
+                                          [&](std::size_t g0, std::size_t g1) {
+        if (simd) {
+            jadra.batch_gemm(g1 - g0, m, n, k, A + g0 * sa, B + g0 * sb, C + g0 * sc);
+            return;
+        }
+        for (std::size_t g = g0; g < g1; ++g) {
+            detail::gemm(m, n, k, 1.0, A + g * sa, static_cast<std::ptrdiff_t>(k), 1,
+                         B + g * sb, static_cast<std::ptrdiff_t>(n), 1,
+                         0.0, C + g * sc, static_cast<std::ptrdiff_t>(n));
+        }
+    });
+}
@@ -0,0 +1,206 @@
+#include "../include/bool_matrix.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+using word = bool_matrix::word;
+
+/// @brief Liczba wierszy B laczonych w jedna tablice (2^8 kombinacji)
+constexpr std::size_t grupa = 8;
+
+/// @brief Szerokosc pasa kolumn wyniku w slowach (tablica 256 x 32 slowa = 64 KiB w L2)
+constexpr std::size_t pas_slow = 32;
+
+/// @brief Liczba wierszy A obslugiwanych przez jedna tablice
+/// Budowa tablicy kosztuje 256 wierszy pasa, wiec przy 1024 wierszach A
+/// stanowi co najwyzej jedna czwarta pracy.
+constexpr std::size_t blok_wierszy = 1024;
+
+/// @brief Rzuca wyjatek, jesli wymiary macierzy sie nie zgadzaja
+void wymagaj_wymiarow(const bool_matrix& a, const bool_matrix& b) {
+    if (a.get_rows() != b.get_rows() || a.get_cols() != b.get_cols())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+}
+
+/// @brief w[j] = f(w[j], z[j]) dla wszystkich slow macierzy
+template <typename F>
+void po_slowach(bool_matrix& a, const bool_matrix& b, F f) {
+    wymagaj_wymiarow(a, b);
+    const std::size_t n = a.get_rows() * a.words_per_row();
+    word* w = a.row_ptr(0);
+    const word* z = b.row_ptr(0);
+    for (std::size_t j = 0; j < n; ++j) w[j] = f(w[j], z[j]);
+}
+
+} // namespace
+
+/**
+ * @brief Konwersja z macierzy double
+ *
+ * @complexity O(n × m)
+ */
+bool_matrix::bool_matrix(const matrix& m) : bool_matrix(m.get_rows(), m.get_cols()) {
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* x = m.row_ptr(i);
+            word* w = row_ptr(i);
+            for (std::size_t j = 0; j < cols; ++j) {
+                w[j / word_bits] |= word{x[j] != 0.0} << (j % word_bits);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Liczba elementów prawdziwych
+ *
+ * Bity dopełnienia są zerami, więc wystarczy zliczyć bity wszystkich słów.
+ *
+ * @complexity O(n × m / 64)
+ */
+std::size_t bool_matrix::count() const noexcept {
+    std::size_t suma = 0;
+    for (word w : dane) suma += static_cast<std::size_t>(__builtin_popcountll(w));
+    return suma;
+}
+
+/// @brief Zamiana na matrix z elementami 0 i 1
+matrix bool_matrix::to_matrix() const {
+    matrix wynik(rows, cols, bez_zerowania);
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const word* w = row_ptr(i);
+            double* x = wynik.row_ptr(i);
+            for (std::size_t j = 0; j < cols; ++j) x[j] = static_cast<double>((w[j / word_bits] >> (j % word_bits)) & 1u);
+        }
+    });
+    return wynik;
+}
+
+/// @brief Iloczyn logiczny element po elemencie
+bool_matrix& bool_matrix::operator&=(const bool_matrix& m) {
+    po_slowach(*this, m, [](word a, word b) { return a & b; });
+    return *this;
+}
+
+/// @brief Suma logiczna element po elemencie
+bool_matrix& bool_matrix::operator|=(const bool_matrix& m) {
+    po_slowach(*this, m, [](word a, word b) { return a | b; });
+    return *this;
+}
+
+/// @brief Różnica symetryczna element po elemencie
+bool_matrix& bool_matrix::operator^=(const bool_matrix& m) {
+    po_slowach(*this, m, [](word a, word b) { return a ^ b; });
+    return *this;
+}
+
+/// @brief Negacja - bity dopełnienia ostatniego słowa wiersza pozostają zerami
+bool_matrix operator~(bool_matrix m) {
+    if (m.slowa == 0) {
+        return m;
+    }
+    for (word& w : m.dane) w = ~w;
+    const word maska = m.maska_konca();
+    for (std::size_t i = 0; i < m.rows; ++i) m.row_ptr(i)[m.slowa - 1] &= maska;
+    return m;
+}
+
+/**
+ * @brief Iloczyn logiczny macierzy (metoda "czterech Rosjan")
+ *
+ * Wiersz i wyniku to OR wierszy B wskazanych przez prawdziwe A(i, p).
+ * Wiersze B dzielone są na grupy po 8: dla każdej grupy budowana jest
+ * tablica 256 sum OR wszystkich podzbiorów grupy (każda z jednego OR
+ * mniejszej), a bajt wiersza A wybiera od razu gotową sumę. Zamiast
+ * do 8 OR-ów wiersza na grupę wykonywany jest jeden.
+ *
+ * Praca dzielona jest na kafelki: pas pas_slow słów kolumn wyniku ×
+ * blok_wierszy wierszy A; każdy kafelek buduje własne tablice, więc
+ * wątki nie synchronizują się między grupami.
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ *
+ * @complexity O(m × n × k / (64 × 8)) operacji na słowach
+ *
+ * @example
+ * @code
+ * bool_matrix G(n, n);   // G(i, j) - krawędź i -> j
+ * bool_matrix G2 = G * G;  // ścieżki o długości dokładnie 2
+ * @endcode
+ */
+bool_matrix operator*(const bool_matrix& A, const bool_matrix& B) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t m = A.get_rows(), k = A.get_cols(), W = B.words_per_row();
+    bool_matrix C(m, B.get_cols());
+    if (m == 0 || k == 0 || W == 0) {
+        return C;
+    }
+
+    const std::size_t pasy = (W + pas_slow - 1) / pas_slow;
+    const std::size_t bloki = (m + blok_wierszy - 1) / blok_wierszy;
+    thread_pool::instance().parallel_rows(pasy * bloki, blok_wierszy * k * pas_slow / grupa, [&](std::size_t t0, std::size_t t1) {
+        thread_local std::vector<word> tablica;
+        if (tablica.size() < (std::size_t{1} << grupa) * pas_slow) tablica.resize((std::size_t{1} << grupa) * pas_slow);
+        for (std::size_t t = t0; t < t1; ++t) {
+            const std::size_t w0 = t % pasy * pas_slow, sw = std::min(pas_slow, W - w0);
+            const std::size_t i0 = t / pasy * blok_wierszy, i1 = std::min(m, i0 + blok_wierszy);
+            for (std::size_t g0 = 0; g0 < k; g0 += grupa) {
+                const std::size_t kombinacje = std::size_t{1} << std::min(grupa, k - g0);
+                // tablica[b] = OR wierszy g0 + t dla bitow t ustawionych w b
+                std::fill_n(tablica.data(), sw, word{0});
+                for (std::size_t b = 1; b < kombinacje; ++b) {
+                    const std::size_t najnizszy = b & (~b + 1);
+                    const word* reszta = tablica.data() + (b ^ najnizszy) * sw;
+                    const word* wiersz = B.row_ptr(g0 + static_cast<std::size_t>(__builtin_ctzll(b))) + w0;
+                    word* cel = tablica.data() + b * sw;
+                    for (std::size_t j = 0; j < sw; ++j) cel[j] = reszta[j] | wiersz[j];
+                }
+                for (std::size_t i = i0; i < i1; ++i) {
+                    const std::size_t bajt = (A.row_ptr(i)[g0 / bool_matrix::word_bits] >> (g0 % bool_matrix::word_bits)) & 0xFF;
+                    if (bajt == 0) continue;
+                    const word* z = tablica.data() + bajt * sw;
+                    word* c = C.row_ptr(i) + w0;
+                    for (std::size_t j = 0; j < sw; ++j) c[j] |= z[j];
+                }
+            }
+        }
+    });
+    return C;
+}
+
+/**
+ * @brief Domknięcie przechodnie (algorytm Warshalla na wierszach bitowych)
+ *
+ * Po kroku k wiersz i zawiera wierzchołki osiągalne ścieżkami, których
+ * wierzchołki pośrednie są mniejsze od k + 1: jeśli i osiąga k, wiersz k
+ * jest dodawany (OR) do wiersza i - 64 kolumny na operację. Wiersze
+ * w jednym kroku są niezależne (wiersz k nie zmienia się w kroku k),
+ * więc dzielone są między wątki.
+ *
+ * @throw std::runtime_error jeśli macierz nie jest kwadratowa
+ *
+ * @complexity O(n³ / 64)
+ */
+bool_matrix transitive_closure(bool_matrix A) {
+    if (A.get_rows() != A.get_cols())
+        throw std::runtime_error("Macierz musi być kwadratowa");
+    const std::size_t n = A.get_rows(), W = A.words_per_row();
+    thread_pool& pula = thread_pool::instance();
+    for (std::size_t k = 0; k < n; ++k) {
+        const word* wiersz_k = A.row_ptr(k);
+        const std::size_t slowo = k / bool_matrix::word_bits;
+        const word bit = word{1} << (k % bool_matrix::word_bits);
+        pula.parallel_rows(n, W, [&](std::size_t r0, std::size_t r1) {
+            for (std::size_t i = r0; i < r1; ++i) {
+                word* w = A.row_ptr(i);
+                if (i == k || !(w[slowo] & bit)) continue;
+                for (std::size_t j = 0; j < W; ++j) w[j] |= wiersz_k[j];
+            }
+        });
+    }
+    return A;
+}
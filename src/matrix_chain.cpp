@@ -0,0 +1,176 @@
+#include "../include/matrix.h"
+#include "matrix_gemm.h"
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/// @brief Odstep wierszy bufora posredniego: kolumny zaokraglone do linii cache
+std::size_t wyrownaj(std::size_t kolumny) noexcept {
+    return (kolumny + 7) / 8 * 8;
+}
+
+/**
+ * @brief Pula buforów na iloczyny pośrednie
+ *
+ * Bufor zwolniony po użyciu wraca do puli i jest wybierany ponownie dla
+ * kolejnego iloczynu, jeśli jest wystarczająco duży (wybierany jest
+ * najmniejszy pasujący). Pula jest lokalna dla wątku i przeżywa wywołanie,
+ * więc powtarzane łańcuchy o tych samych kształtach nie alokują pamięci.
+ */
+struct pula_buforow {
+    std::vector<std::unique_ptr<detail::bufor_roboczy>> wolne;
+
+    std::unique_ptr<detail::bufor_roboczy> pobierz(std::size_t n) {
+        std::size_t najlepszy = wolne.size();
+        for (std::size_t i = 0; i < wolne.size(); ++i) {
+            const std::size_t poj = wolne[i]->pojemnosc;
+            if (poj >= n && (najlepszy == wolne.size() || poj < wolne[najlepszy]->pojemnosc)) {
+                najlepszy = i;
+            }
+        }
+        // Brak pasujacego - powiekszany jest najwiekszy wolny, zamiast dokladac nowy
+        if (najlepszy == wolne.size()) {
+            for (std::size_t i = 0; i < wolne.size(); ++i) {
+                if (najlepszy == wolne.size() || wolne[i]->pojemnosc > wolne[najlepszy]->pojemnosc) {
+                    najlepszy = i;
+                }
+            }
+        }
+        std::unique_ptr<detail::bufor_roboczy> b;
+        if (najlepszy == wolne.size()) {
+            b = std::make_unique<detail::bufor_roboczy>();
+        } else {
+            b = std::move(wolne[najlepszy]);
+            wolne.erase(wolne.begin() + static_cast<std::ptrdiff_t>(najlepszy));
+        }
+        b->zapewnij(n);
+        return b;
+    }
+
+    void zwroc(std::unique_ptr<detail::bufor_roboczy> b) {
+        if (b) wolne.push_back(std::move(b));
+    }
+};
+
+/**
+ * @brief Wykonanie planu: iloczyn łańcucha [i, j] do bufora `out`
+ */
+struct wykonawca {
+    const std::vector<std::reference_wrapper<const matrix>>& lancuch;
+    const std::vector<std::size_t>& wymiary;
+    const std::vector<std::size_t>& podzial;
+    pula_buforow& pula;
+
+    std::size_t n() const noexcept { return lancuch.size(); }
+
+    /// @brief Operand mnożenia: macierz z łańcucha albo bufor pośredni
+    struct operand {
+        const double* p;
+        std::ptrdiff_t rs;
+        std::unique_ptr<detail::bufor_roboczy> bufor;
+    };
+
+    operand argument(std::size_t i, std::size_t j) {
+        if (i == j) {
+            const matrix& m = lancuch[i];
+            return {m.data.get(), static_cast<std::ptrdiff_t>(m.get_stride()), nullptr};
+        }
+        const std::size_t ld = wyrownaj(wymiary[j + 1]);
+        auto b = pula.pobierz(wymiary[i] * ld);
+        licz(i, j, b->ptr, static_cast<std::ptrdiff_t>(ld));
+        return {b->ptr, static_cast<std::ptrdiff_t>(ld), std::move(b)};
+    }
+
+    void licz(std::size_t i, std::size_t j, double* out, std::ptrdiff_t rso) {
+        const std::size_t s = podzial[i * n() + j];
+        operand l = argument(i, s);
+        operand r = argument(s + 1, j);
+        detail::gemm(wymiary[i], wymiary[j + 1], wymiary[s + 1], 1.0,
+                     l.p, l.rs, 1, r.p, r.rs, 1, 0.0, out, rso);
+        pula.zwroc(std::move(l.bufor));
+        pula.zwroc(std::move(r.bufor));
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Iloczyn łańcucha macierzy w optymalnej kolejności
+ *
+ * Klasyczne programowanie dynamiczne (Cormen i in., rozdz. 15.2):
+ * koszt[i][j] = min po s z koszt[i][s] + koszt[s+1][j] + p[i]·p[s+1]·p[j+1],
+ * gdzie p to kolejne wymiary łańcucha. Planowanie kosztuje O(n³) dla
+ * n macierzy, czyli pomijalnie mało wobec samych mnożeń.
+ *
+ * Plan wykonywany jest rekurencyjnie; iloczyny pośrednie trafiają do
+ * buforów z puli (zob. pula_buforow), zwalnianych zaraz po użyciu,
+ * a iloczyn końcowy bezpośrednio do macierzy wynikowej.
+ *
+ * @param lancuch macierze w kolejności mnożenia
+ *
+ * @return nowa macierz z iloczynem całego łańcucha
+ *
+ * @throw std::runtime_error jeśli łańcuch jest pusty
+ * @throw std::runtime_error jeśli sąsiednie wymiary się nie zgadzają
+ *
+ * @complexity O(n³) planowanie + koszt optymalnego nawiasowania
+ *
+ * @example
+ * @code
+ * // X: 10000×10, W1: 10×500, W2: 500×5 - (X*W1)*W2 kosztuje 50 razy więcej
+ * matrix Y = multiply_chain({X, W1, W2});
+ * @endcode
+ */
+matrix multiply_chain(const std::vector<std::reference_wrapper<const matrix>>& lancuch) {
+    const std::size_t n = lancuch.size();
+    if (n == 0)
+        throw std::runtime_error("Pusty łańcuch mnożeń");
+
+    std::vector<std::size_t> wymiary(n + 1);
+    wymiary[0] = lancuch[0].get().get_rows();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (lancuch[i].get().get_rows() != wymiary[i])
+            throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+        wymiary[i + 1] = lancuch[i].get().get_cols();
+    }
+    if (n == 1) {
+        return lancuch[0].get();
+    }
+
+    // koszt[i*n + j] - minimalna liczba mnozen dla lancucha [i, j]
+    std::vector<double> koszt(n * n, 0.0);
+    std::vector<std::size_t> podzial(n * n, 0);
+    for (std::size_t dlugosc = 2; dlugosc <= n; ++dlugosc) {
+        for (std::size_t i = 0; i + dlugosc <= n; ++i) {
+            const std::size_t j = i + dlugosc - 1;
+            double najlepszy = std::numeric_limits<double>::infinity();
+            for (std::size_t s = i; s < j; ++s) {
+                const double c = koszt[i * n + s] + koszt[(s + 1) * n + j]
+                               + static_cast<double>(wymiary[i]) * wymiary[s + 1] * wymiary[j + 1];
+                if (c < najlepszy) {
+                    najlepszy = c;
+                    podzial[i * n + j] = s;
+                }
+            }
+            koszt[i * n + j] = najlepszy;
+        }
+    }
+
+    thread_local pula_buforow pula;
+    matrix result(wymiary[0], wymiary[n], bez_zerowania);
+    wykonawca w{lancuch, wymiary, podzial, pula};
+    w.licz(0, n - 1, result.data.get(), static_cast<std::ptrdiff_t>(result.get_stride()));
+    return result;
+}
+
+/**
+ * @brief Iloczyn łańcucha macierzy podanego listą - multiply_chain({A, B, C})
+ *
+ * Macierze są przekazywane przez referencję, bez kopiowania.
+ */
+matrix multiply_chain(std::initializer_list<std::reference_wrapper<const matrix>> lancuch) {
+    return multiply_chain(std::vector<std::reference_wrapper<const matrix>>(lancuch));
+}
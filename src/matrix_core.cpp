@@ -3,6 +3,24 @@
 #include <cstddef>
 #include <memory>
 #include <algorithm>
+#include <cstring>
+#include <new>
+
+/**
+ * @brief Zaokrągla liczbę kolumn w górę do pełnej linii cache
+ *
+ * Każdy wiersz zaczyna się na granicy `alignment` bajtów,
+ * dzięki czemu jądra SIMD mogą używać wyrównanych odczytów.
+ *
+ * @tparam T typ elementu
+ * @param cols liczba kolumn macierzy
+ * @return odstęp między wierszami w elementach (8 dla double, 16 dla float, 64 dla int8)
+ */
+template <typename T>
+static std::size_t wyrownaj_stride(std::size_t cols) noexcept {
+    constexpr std::size_t na_linie = basic_matrix<T>::alignment / sizeof(T);
+    return (cols + na_linie - 1) / na_linie * na_linie;
+}
 
 /**
  * @brief Konstruktor domyślny - tworzy macierz o wymiarach 0x0
@@ -13,9 +31,10 @@
  * @note Macierz utworzona tym konstruktorem jest pusta i wymaga
  *       użycia operatora przypisania, aby otrzymać dane.
  * 
- * @post rows == 0, cols == 0, data == nullptr
+ * @post rows == 0, cols == 0, stride == 0, data == nullptr
  */
-matrix::matrix() noexcept : rows(0), cols(0), data(nullptr) {}
+template <typename T>
+basic_matrix<T>::basic_matrix() noexcept : rows(0), cols(0), stride(0), data(nullptr) {}
 
 /**
  * @brief Konstruktor z parametrami - tworzy macierz o podanych wymiarach
@@ -25,7 +44,7 @@ matrix::matrix() noexcept : rows(0), cols(0), data(nullptr) {}
  * 
  * @param r liczba wierszy (konwertowana do int)
  * @param c liczba kolumn (konwertowana do int)
- * @param value wartość początkowa wszystkich elementów (domyślnie 0.0)
+ * @param value wartość początkowa wszystkich elementów (domyślnie zero)
  * 
  * @throw std::bad_alloc jeśli alokacja pamięci się nie powiedzie
  * 
@@ -37,12 +56,13 @@ matrix::matrix() noexcept : rows(0), cols(0), data(nullptr) {}
  * matrix m(3, 3, 1.5);  // macierz 3×3 wypełniona wartościami 1.5
  * @endcode
  */
-matrix::matrix(std::size_t r, std::size_t c, double value)
-    : rows(static_cast<int>(r)), cols(static_cast<int>(c)) {
+template <typename T>
+basic_matrix<T>::basic_matrix(std::size_t r, std::size_t c, T value)
+    : rows(static_cast<int>(r)), cols(static_cast<int>(c)), stride(wyrownaj_stride<T>(c)) {
     alokuj(r * c);
-    for (std::size_t i = 0; i < static_cast<std::size_t>(rows); ++i) {
-        for (std::size_t j = 0; j < static_cast<std::size_t>(cols); ++j) {
-            data[i][j] = value;
+    if (value != T()) {
+        for (std::size_t i = 0; i < r; ++i) {
+            std::fill_n(row_ptr(i), c, value);
         }
     }
 }
@@ -66,19 +86,17 @@ matrix::matrix(std::size_t r, std::size_t c, double value)
  *             {4, 5, 6}};  // macierz 2×3
  * @endcode
  */
-matrix::matrix(std::initializer_list<std::initializer_list<double>> init)
+template <typename T>
+basic_matrix<T>::basic_matrix(std::initializer_list<std::initializer_list<T>> init)
     : rows(static_cast<int>(init.size())),
-      cols(init.size() ? static_cast<int>(init.begin()->size()) : 0) {
+      cols(init.size() ? static_cast<int>(init.begin()->size()) : 0),
+      stride(wyrownaj_stride<T>(static_cast<std::size_t>(cols))) {
     alokuj(rows * cols);
     std::size_t r = 0;
     for (const auto& row : init) {
         if (row.size() != static_cast<std::size_t>(cols))
             throw std::runtime_error("Niezgodne długości wierszy w initializer_list");
-        std::size_t c = 0;
-        for (double val : row) {
-            data[r][c] = val;
-            ++c;
-        }
+        std::copy(row.begin(), row.end(), row_ptr(r));
         ++r;
     }
 }
@@ -87,7 +105,8 @@ matrix::matrix(std::initializer_list<std::initializer_list<double>> init)
  * @brief Konstruktor kopiujący - tworzy głęboką kopię macierzy
  * 
  * Tworzy nową macierz będącą kopią innej macierzy.
- * Alokuje nową pamięć i kopiuje wszystkie elementy.
+ * Alokuje jeden nowy blok pamięci i kopiuje go w całości jednym `memcpy`
+ * (łącznie z dopełnieniem wierszy, które zawsze jest wyzerowane).
  * Wymagany ze względu na użycie unique_ptr w klasie.
  * 
  * @param other macierz do skopiowania
@@ -105,13 +124,12 @@ matrix::matrix(std::initializer_list<std::initializer_list<double>> init)
  * matrix B = A;  // używa konstruktora kopiującego
  * @endcode
  */
-matrix::matrix(const matrix& other) 
-    : rows(other.rows), cols(other.cols) {
+template <typename T>
+basic_matrix<T>::basic_matrix(const basic_matrix& other)
+    : rows(other.rows), cols(other.cols), stride(other.stride) {
     alokuj(rows * cols);
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            data[i][j] = other.data[i][j];
-        }
+    if (data) {
+        std::memcpy(data.get(), other.data.get(), rows * stride * sizeof(T));
     }
 }
 
@@ -120,6 +138,8 @@ matrix::matrix(const matrix& other)
  * 
  * Tworzy głęboką kopię macierzy źródłowej i przypisuje jej zawartość
  * do bieżącej macierzy. Obsługuje także samoprzypasanie (a = a).
+ * Jeśli wymiary obu macierzy są zgodne, istniejący bufor jest
+ * ponownie wykorzystywany i nie dochodzi do żadnej alokacji.
  * 
  * @param other macierz do przypisania
  * 
@@ -138,112 +158,168 @@ matrix::matrix(const matrix& other)
  * B = A;  // B zmienia rozmiar i przejmuje dane z A
  * @endcode
  */
-matrix& matrix::operator=(const matrix& other) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator=(const basic_matrix& other) {
     if (this == &other) {
         return *this;
     }
     
-    // Zwolnij starą pamięć
-    data.reset();
-    
-    rows = other.rows;
-    cols = other.cols;
-    
-    alokuj(rows * cols);
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            data[i][j] = other.data[i][j];
-        }
+    if (rows != other.rows || cols != other.cols || !data) {
+        // Zwolnij starą pamięć
+        data.reset();
+
+        rows = other.rows;
+        cols = other.cols;
+        stride = other.stride;
+
+        alokuj(rows * cols);
+    }
+    if (data) {
+        std::memcpy(data.get(), other.data.get(), rows * stride * sizeof(T));
     }
     
     return *this;
 }
 
+/**
+ * @brief Konstruktor przenoszący - przejmuje bufor innej macierzy
+ *
+ * Nie alokuje pamięci. Macierz źródłowa zostaje pusta (0x0),
+ * więc nie da się przez nią odwołać do przejętego bufora.
+ *
+ * @param other macierz, z której przejmowane są dane
+ *
+ * @post other.rows == 0, other.cols == 0, other.data == nullptr
+ * @complexity O(1)
+ */
+template <typename T>
+basic_matrix<T>::basic_matrix(basic_matrix&& other) noexcept
+    : rows(other.rows), cols(other.cols), stride(other.stride), data(std::move(other.data)) {
+    other.rows = 0;
+    other.cols = 0;
+    other.stride = 0;
+}
+
+/**
+ * @brief Operator przypisania przenoszącego - przejmuje bufor innej macierzy
+ *
+ * Zwalnia dotychczasowy bufor i przejmuje bufor `other`.
+ *
+ * @param other macierz, z której przejmowane są dane
+ * @return referencja na bieżącą macierz (*this)
+ *
+ * @post other.rows == 0, other.cols == 0, other.data == nullptr
+ * @complexity O(1)
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator=(basic_matrix&& other) noexcept {
+    if (this != &other) {
+        data = std::move(other.data);
+        rows = other.rows;
+        cols = other.cols;
+        stride = other.stride;
+        other.rows = 0;
+        other.cols = 0;
+        other.stride = 0;
+    }
+    return *this;
+}
+
 /**
  * @brief Alokuje pamięć dla macierzy
  * 
- * Przydziela dynamiczną pamięć dla dwuwymiarowej tablicy double
- * oraz inicjalizuje wszystkie elementy na zero.
- * Korzysta z unique_ptr do automatycznego zarządzania pamięcią.
+ * Przydziela jeden ciągły blok `rows × stride` elementów wyrównany
+ * do `matrix::alignment` bajtów i zeruje go w całości (razem
+ * z dopełnieniem na końcu każdego wiersza).
+ * Bufor jest zwalniany automatycznie przez `aligned_deleter`.
  * 
  * @param n liczba elementów do alokacji (parametr nieużywany,
- *          rzeczywisty rozmiar określony przez rows i cols)
+ *          rzeczywisty rozmiar określony przez rows i stride)
  * 
- * @pre rows > 0 && cols > 0
- * @post data wskazuje na alokowaną tablicę, wszystkie elementy = 0.0
+ * @pre stride >= cols
+ * @post data wskazuje na alokowaną tablicę, wszystkie elementy = 0.0;
+ *       dla rows == 0 lub cols == 0 data == nullptr
  * @throw std::bad_alloc jeśli alokacja się nie powiedzie
- * @complexity O(rows × cols)
+ * @complexity O(rows × stride)
  * 
- * @note Parametr `n` jest ignorowany; rzeczywisty rozmiar to rows × cols
- * @warning Jeśli rows lub cols wynoszą 0, zachowanie jest niezdefiniowane
+ * @note Parametr `n` jest ignorowany; rzeczywisty rozmiar to rows × stride
  * 
  * @internal Ta metoda jest wewnętrzna dla klasy i powinna być
  *           wywoływana przez konstruktory
  */
-void matrix::alokuj(std::size_t /*n*/) {
-    data = std::make_unique<double*[]>(rows);
-    for (int i = 0; i < rows; ++i) {
-        data[i] = new double[cols];
-    }
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            data[i][j] = 0.0;
-        }
+template <typename T>
+void basic_matrix<T>::alokuj(std::size_t /*n*/) {
+    const std::size_t elementy = static_cast<std::size_t>(rows) * stride;
+    if (elementy == 0 || cols == 0) {
+        data.reset();
+        return;
     }
+    void* p = ::operator new[](elementy * sizeof(T), std::align_val_t{alignment});
+    data.reset(static_cast<T*>(p));
+    std::memset(p, 0, elementy * sizeof(T));
 }
 
 /**
- * @brief Operator dostępu (niestały) - zwraca referencję na element
- * 
- * Umożliwia dostęp do elementu macierzy o indeksach (r, c)
- * i modyfikację jego wartości. Brak sprawdzenia granic.
- * 
- * @param r indeks wiersza (0-based)
- * @param c indeks kolumny (0-based)
- * 
- * @return referencja na element data[r][c]
- * 
- * @pre 0 <= r < rows && 0 <= c < cols
- * @complexity O(1) - bezpośredni dostęp do pamięci
- * 
- * @warning Brak sprawdzenia granic! Przekazanie nieprawidłowych
- *          indeksów spowoduje niezdefiniowane zachowanie
- * 
- * @example
- * @code
- * matrix m(3, 3);
- * m(0, 0) = 5.0;  // ustawienie wartości
- * double x = m(0, 0);  // odczytanie wartości
- * @endcode
+ * @brief Konstruktor bez inicjalizacji - alokuje bufor bez zerowania elementów
+ *
+ * Przeznaczony dla wyników, które i tak zostaną w całości nadpisane
+ * (np. wyliczenie wyrażenia), więc zerowanie byłoby dodatkowym
+ * przebiegiem po pamięci. Dopełnienie wierszy jest zerowane, aby
+ * zachować niezmiennik wymagany przez jądra SIMD i kopiowanie.
+ *
+ * @param r liczba wierszy
+ * @param c liczba kolumn
+ *
+ * @throw std::bad_alloc jeśli alokacja pamięci się nie powiedzie
+ *
+ * @post rows == r, cols == c, elementy mają nieokreśloną wartość
  */
-double& matrix::operator()(std::size_t r, std::size_t c) {
-    return data[r][c];
+template <typename T>
+basic_matrix<T>::basic_matrix(std::size_t r, std::size_t c, bez_zerowania_t)
+    : rows(static_cast<int>(r)), cols(static_cast<int>(c)), stride(wyrownaj_stride<T>(c)) {
+    alokuj_bez_zerowania();
 }
 
 /**
- * @brief Operator dostępu (stały) - zwraca kopię elementu
- * 
- * Umożliwia bezpieczny (tylko do odczytu) dostęp do elementu
- * macierzy bez możliwości modyfikacji. Brak sprawdzenia granic.
- * 
- * @param r indeks wiersza (0-based)
- * @param c indeks kolumny (0-based)
- * 
- * @return kopia wartości elementu data[r][c]
- * 
- * @pre 0 <= r < rows && 0 <= c < cols
- * @complexity O(1) - bezpośredni dostęp do pamięci
- * 
- * @warning Brak sprawdzenia granic! Przekazanie nieprawidłowych
- *          indeksów spowoduje niezdefiniowane zachowanie
- * 
- * @example
- * @code
- * const matrix m(3, 3, 1.5);
- * double x = m(0, 0);  // zwraca 1.5 (kopię wartości)
- * // m(0, 0) = 5.0;  // BŁĄD KOMPILACJI - brak możliwości modyfikacji
- * @endcode
+ * @brief Alokuje bufor rows × stride bez zerowania elementów
+ *
+ * Zerowane jest wyłącznie dopełnienie [cols, stride) każdego wiersza.
+ *
+ * @post dla rows == 0 lub cols == 0 data == nullptr
+ * @throw std::bad_alloc jeśli alokacja się nie powiedzie
  */
-double matrix::operator()(std::size_t r, std::size_t c) const {
-    return data[r][c];
-}
\ No newline at end of file
+template <typename T>
+void basic_matrix<T>::alokuj_bez_zerowania() {
+    const std::size_t elementy = static_cast<std::size_t>(rows) * stride;
+    if (elementy == 0 || cols == 0) {
+        data.reset();
+        return;
+    }
+    void* p = ::operator new[](elementy * sizeof(T), std::align_val_t{alignment});
+    data.reset(static_cast<T*>(p));
+    const std::size_t dopelnienie = stride - static_cast<std::size_t>(cols);
+    if (dopelnienie != 0) {
+        for (int i = 0; i < rows; ++i) {
+            std::fill_n(row_ptr(i) + cols, dopelnienie, T());
+        }
+    }
+}
+
+// Jawne konkretyzacje składowych zdefiniowanych w tym pliku
+#define MATRIX_KONKRETYZUJ_RDZEN(T)                                                          \
+    template basic_matrix<T>::basic_matrix() noexcept;                                       \
+    template basic_matrix<T>::basic_matrix(std::size_t, std::size_t, T);                     \
+    template basic_matrix<T>::basic_matrix(std::size_t, std::size_t, bez_zerowania_t);       \
+    template basic_matrix<T>::basic_matrix(std::initializer_list<std::initializer_list<T>>); \
+    template basic_matrix<T>::basic_matrix(const basic_matrix<T>&);                          \
+    template basic_matrix<T>::basic_matrix(basic_matrix<T>&&) noexcept;                      \
+    template basic_matrix<T>& basic_matrix<T>::operator=(const basic_matrix<T>&);            \
+    template basic_matrix<T>& basic_matrix<T>::operator=(basic_matrix<T>&&) noexcept;        \
+    template void basic_matrix<T>::alokuj(std::size_t);                                      \
+    template void basic_matrix<T>::alokuj_bez_zerowania();
+
+MATRIX_KONKRETYZUJ_RDZEN(double)
+MATRIX_KONKRETYZUJ_RDZEN(float)
+MATRIX_KONKRETYZUJ_RDZEN(std::int8_t)
+MATRIX_KONKRETYZUJ_RDZEN(std::int32_t)
+MATRIX_KONKRETYZUJ_RDZEN(std::int64_t)
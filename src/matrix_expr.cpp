@@ -0,0 +1,195 @@
+#include "../include/matrix.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// @brief Dlugosc fragmentu wiersza liczonego naraz (4 KiB - kilka buforow miesci sie w L1)
+constexpr std::size_t fragment = 512;
+
+/// @brief Liczba wierszy kafelka dla lisci i wyniku o ciaglych kolumnach (jedna linia cache double)
+constexpr std::size_t wiersze_kafla = 8;
+
+/**
+ * @brief Maksymalna głębokość stosu potrzebna do wykonania programu
+ *
+ * Liść odkłada jeden wynik, operacja dwuargumentowa zdejmuje dwa
+ * i odkłada jeden, operacja ze skalarem nie zmienia głębokości.
+ */
+std::size_t glebokosc_stosu(const detail::expr_instr* prog, std::size_t n) noexcept {
+    std::size_t d = 0, max_d = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (prog[i].op) {
+        case detail::expr_instr::leaf: max_d = std::max(max_d, ++d); break;
+        case detail::expr_instr::add:
+        case detail::expr_instr::sub: --d; break;
+        default: break;
+        }
+    }
+    return max_d;
+}
+
+} // namespace
+
+/**
+ * @brief Wylicza spłaszczone wyrażenie element po elemencie
+ *
+ * Program jest wykonywany jak maszyna stosowa na fragmentach wierszy
+ * o długości `fragment`: liście odkładają na stos wskaźniki na dane
+ * macierzy (bez kopiowania), a operacje zapisują wynik do bufora
+ * poziomu stosu, na którym ląduje. Ostatnia instrukcja pisze od razu
+ * do wiersza wyniku, więc każdy element wejścia jest czytany i każdy
+ * element wyniku zapisywany dokładnie raz, a wyniki pośrednie nie
+ * opuszczają L1.
+ *
+ * Liść będący widokiem o kolumnach rozrzuconych w pamięci (np. kolumna
+ * macierzy) jest najpierw zbierany do bufora swojego poziomu stosu,
+ * a wynik o takim układzie powstaje w dodatkowym buforze i jest
+ * rozpraszany po obliczeniu fragmentu. Wiersze ciągłe nie są kopiowane.
+ *
+ * Liść o ciągłych kolumnach (widok transpose()) nie jest zbierany
+ * kolumna po kolumnie: wiersze są przetwarzane kafelkami po
+ * `wiersze_kafla`, a kafelek liścia trafia do bufora jednym wywołaniem
+ * jądra transpozycji SIMD, które czyta całe linie cache. Wynik
+ * o ciągłych kolumnach jest tak samo składany w kafelku i zapisywany
+ * transpozycją.
+ *
+ * Wszystkie operacje odwołują się do tych samych indeksów, dlatego
+ * `out` może być jednocześnie operandem wyrażenia (A = A * 2 + B), jeśli
+ * liść wskazuje na te same elementy w tym samym układzie. Liść, który
+ * może dzielić elementy z `out` inaczej (A = A + Aᵀ, przesunięty blok),
+ * czytałby już nadpisane wartości - wtedy wynik powstaje w macierzy
+ * tymczasowej i jest kopiowany do `out`.
+ *
+ * @param prog instrukcje w notacji postfiksowej
+ * @param n liczba instrukcji (najwyżej expr_max_instrukcji)
+ * @param out macierz lub fragment docelowy o wymiarach wyrażenia
+ */
+void detail::expr_evaluate(const expr_instr* prog, std::size_t n, matrix_view out) {
+    const std::size_t rows = out.get_rows(), cols = out.get_cols();
+    if (rows == 0 || cols == 0 || n == 0) return;
+
+    if (expr_aliases(prog, n, out)) {
+        matrix tmp(rows, cols, bez_zerowania);
+        expr_evaluate(prog, n, tmp);
+        out = tmp;
+        return;
+    }
+
+    const auto& k = detail::kernels();
+    const std::size_t glebokosc = glebokosc_stosu(prog, n);
+    const bool rozproszony = !out.contiguous_rows();
+    const bool kolumnowy = rozproszony && out.contiguous_cols() && out.col_stride() > 0;
+    const std::ptrdiff_t cs_out = out.col_stride();
+
+    // Numer kafelka dla kazdego liscia o ciaglych kolumnach, -1 dla pozostalych instrukcji
+    std::array<std::ptrdiff_t, expr_max_instrukcji> kafel_liscia;
+    std::fill_n(kafel_liscia.begin(), n, -1);
+    std::size_t liczba_kafli = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const expr_instr& in = prog[i];
+        if (in.op == expr_instr::leaf && !in.m.contiguous_rows() && in.m.contiguous_cols() && in.m.col_stride() > 0) {
+            kafel_liscia[i] = static_cast<std::ptrdiff_t>(liczba_kafli++);
+        }
+    }
+    const std::size_t kafel = wiersze_kafla * fragment;
+
+    thread_pool::instance().parallel_rows(rows, cols * n, [&](std::size_t r0, std::size_t r1) {
+        thread_local std::vector<double> bufory;
+        thread_local std::vector<double> kafle;
+        thread_local std::vector<const double*> stos;
+        if (bufory.size() < (glebokosc + 1) * fragment) bufory.resize((glebokosc + 1) * fragment);
+        if (kafle.size() < (liczba_kafli + 1) * kafel) kafle.resize((liczba_kafli + 1) * kafel);
+        if (stos.size() < glebokosc) stos.resize(glebokosc);
+        double* kafel_wyniku = kafle.data() + liczba_kafli * kafel;
+
+        for (std::size_t rb = r0; rb < r1; rb += wiersze_kafla) {
+            const std::size_t h = std::min(wiersze_kafla, r1 - rb);
+            for (std::size_t c0 = 0; c0 < cols; c0 += fragment) {
+                const std::size_t len = std::min(fragment, cols - c0);
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (kafel_liscia[i] < 0) continue;
+                    const const_matrix_view& m = prog[i].m;
+                    // Kolumny liscia sa wierszami w pamieci: (c0..c0+len) x (rb..rb+h)
+                    k.transpose_b64(len, h, &m(rb, c0), static_cast<std::size_t>(m.col_stride()),
+                                    kafle.data() + kafel_liscia[i] * kafel, fragment);
+                }
+
+                for (std::size_t r = rb; r < rb + h; ++r) {
+                    double* docelowy = kolumnowy ? kafel_wyniku + (r - rb) * fragment
+                                     : rozproszony ? bufory.data() + glebokosc * fragment
+                                     : out.row_ptr(r) + c0;
+                    std::size_t d = 0;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const expr_instr& in = prog[i];
+                        if (in.op == expr_instr::leaf) {
+                            const double* z;
+                            if (kafel_liscia[i] >= 0) {
+                                z = kafle.data() + kafel_liscia[i] * kafel + (r - rb) * fragment;
+                            } else {
+                                z = in.m.row_ptr(r) + static_cast<std::ptrdiff_t>(c0) * in.m.col_stride();
+                                if (!in.m.contiguous_rows()) {
+                                    double* b = bufory.data() + d * fragment;
+                                    const std::ptrdiff_t cs = in.m.col_stride();
+                                    for (std::size_t j = 0; j < len; ++j) b[j] = z[static_cast<std::ptrdiff_t>(j) * cs];
+                                    z = b;
+                                }
+                            }
+                            stos[d++] = z;
+                            continue;
+                        }
+                        if (in.op == expr_instr::add || in.op == expr_instr::sub) --d;
+                        double* cel = (i + 1 == n) ? docelowy : bufory.data() + (d - 1) * fragment;
+                        switch (in.op) {
+                        case expr_instr::add:         k.add(len, stos[d - 1], stos[d], cel); break;
+                        case expr_instr::sub:         k.sub(len, stos[d - 1], stos[d], cel); break;
+                        case expr_instr::add_scalar:  k.add_scalar(len, stos[d - 1], in.s, cel); break;
+                        case expr_instr::mul_scalar:  k.mul_scalar(len, stos[d - 1], in.s, cel); break;
+                        case expr_instr::rsub_scalar: k.rsub_scalar(len, stos[d - 1], in.s, cel); break;
+                        default: break;
+                        }
+                        stos[d - 1] = cel;
+                    }
+                    // Program zlozony z samego liscia - zwykla kopia
+                    if (n == 1 && stos[0] != docelowy) {
+                        std::memmove(docelowy, stos[0], len * sizeof(double));
+                    }
+                    if (rozproszony && !kolumnowy) {
+                        double* w = out.row_ptr(r) + static_cast<std::ptrdiff_t>(c0) * cs_out;
+                        for (std::size_t j = 0; j < len; ++j) w[static_cast<std::ptrdiff_t>(j) * cs_out] = docelowy[j];
+                    }
+                }
+
+                if (kolumnowy) {
+                    k.transpose_b64(h, len, kafel_wyniku, fragment, &out(rb, c0),
+                                    static_cast<std::size_t>(cs_out));
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief Sprawdza, czy któryś liść może dzielić elementy z `out` w innym układzie
+ *
+ * Liść opisujący dokładnie ten sam fragment co `out` (ten sam wskaźnik,
+ * wymiary i kroki) jest bezpieczny - każdy element jest czytany przed
+ * zapisem pod tym samym indeksem. Pozostałe liście są sprawdzane tak samo
+ * jak operandy gemm() na widokach.
+ *
+ * @param prog instrukcje w notacji postfiksowej
+ * @param n liczba instrukcji
+ * @param out fragment docelowy
+ *
+ * @return prawda, jeśli wyliczenie w miejscu mogłoby przeczytać nadpisany element
+ */
+bool detail::expr_aliases(const expr_instr* prog, std::size_t n, const_matrix_view out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (prog[i].op != expr_instr::leaf || ten_sam_uklad(prog[i].m, out)) continue;
+        if (moga_sie_nakladac(prog[i].m, out)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,343 @@
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace detail {
+
+namespace {
+
+/**
+ * @brief Pakuje blok A (mc × kc) w paski po MR wierszy
+ *
+ * Wewnątrz paska elementy leżą kolumnami: a_pack[p * MR + i] = alpha * A(i, p),
+ * więc mikro-jądro czyta je sekwencyjnie. Mnożenie przez alpha przy
+ * pakowaniu kosztuje O(mc × kc) zamiast O(m × n) przy skalowaniu wyniku.
+ * Brakujące wiersze ostatniego paska są dopełniane zerami.
+ *
+ * Pętle są ułożone tak, aby odczyt z A był sekwencyjny: dla A w układzie
+ * wierszowym (csa == 1) wewnętrzna pętla idzie wzdłuż wiersza, a dla
+ * A transponowanego (rsa == 1) wzdłuż kolumny. Zapis rozproszony trafia
+ * do bufora mieszczącego się w L1.
+ *
+ * Operand typu float jest przy pakowaniu rozszerzany do double, więc
+ * z pamięci czytana jest połowa bajtów, a mikro-jądro pozostaje to samo.
+ */
+template <typename E>
+void pakuj_a(std::size_t mc, std::size_t kc, std::size_t MR, double alpha,
+             const E* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+             double* a_pack) {
+    for (std::size_t i0 = 0; i0 < mc; i0 += MR) {
+        const std::size_t mr = std::min(MR, mc - i0);
+        if (csa == 1 && rsa != 1) {
+            for (std::size_t i = 0; i < mr; ++i) {
+                const E* wiersz = a + (i0 + i) * rsa;
+                for (std::size_t p = 0; p < kc; ++p) {
+                    a_pack[p * MR + i] = alpha * static_cast<double>(wiersz[p]);
+                }
+            }
+            for (std::size_t i = mr; i < MR; ++i) {
+                for (std::size_t p = 0; p < kc; ++p) {
+                    a_pack[p * MR + i] = 0.0;
+                }
+            }
+            a_pack += kc * MR;
+            continue;
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t i = 0; i < mr; ++i) {
+                a_pack[i] = alpha * static_cast<double>(a[(i0 + i) * rsa + p * csa]);
+            }
+            for (std::size_t i = mr; i < MR; ++i) {
+                a_pack[i] = 0.0;
+            }
+            a_pack += MR;
+        }
+    }
+}
+
+/**
+ * @brief Pakuje panel B (kc × nc) w paski po NR kolumn
+ *
+ * Wewnątrz paska elementy leżą wierszami: b_pack[p * NR + j] = B(p, j).
+ * Brakujące kolumny ostatniego paska są dopełniane zerami.
+ *
+ * Dla B transponowanego (rsb == 1) kolumny paska są ciągłymi wierszami
+ * oryginalnego bufora, więc są czytane po kolei zamiast skokami o stride.
+ */
+template <typename E>
+void pakuj_b(std::size_t kc, std::size_t nc, std::size_t NR,
+             const E* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+             double* b_pack) {
+    for (std::size_t j0 = 0; j0 < nc; j0 += NR) {
+        const std::size_t nr = std::min(NR, nc - j0);
+        if (rsb == 1 && csb != 1) {
+            for (std::size_t j = 0; j < nr; ++j) {
+                const E* kolumna = b + (j0 + j) * csb;
+                for (std::size_t p = 0; p < kc; ++p) {
+                    b_pack[p * NR + j] = kolumna[p];
+                }
+            }
+            for (std::size_t j = nr; j < NR; ++j) {
+                for (std::size_t p = 0; p < kc; ++p) {
+                    b_pack[p * NR + j] = 0.0;
+                }
+            }
+            b_pack += kc * NR;
+            continue;
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            const E* wiersz = b + p * rsb + j0 * csb;
+            bool skopiowany = false;
+            if constexpr (std::is_same_v<E, double>) {
+                if (csb == 1) {
+                    std::memcpy(b_pack, wiersz, nr * sizeof(double));
+                    skopiowany = true;
+                }
+            }
+            if (!skopiowany) {
+                for (std::size_t j = 0; j < nr; ++j) {
+                    b_pack[j] = wiersz[j * csb];
+                }
+            }
+            for (std::size_t j = nr; j < NR; ++j) {
+                b_pack[j] = 0.0;
+            }
+            b_pack += NR;
+        }
+    }
+}
+
+/**
+ * @brief Makro-jądro: przechodzi po kafelkach bloku mc × nc
+ *
+ * Pełne kafelki są liczone bezpośrednio w C, brzegowe w buforze
+ * tymczasowym zainicjowanym bieżącą zawartością C, aby mikro-jądro nie
+ * musiało obsługiwać krawędzi. Nadmiarowe elementy bufora (z wierszy
+ * i kolumn dopełniających paski) nie są przepisywane do C.
+ */
+void makro_jadro(const mikro_jadro& jadro, std::size_t mc, std::size_t nc, std::size_t kc,
+                 const double* a_pack, const double* b_pack,
+                 double* c, std::ptrdiff_t rsc) {
+    const std::size_t MR = jadro.mr, NR = jadro.nr;
+    for (std::size_t j0 = 0; j0 < nc; j0 += NR) {
+        const std::size_t nr = std::min(NR, nc - j0);
+        const double* b_pasek = b_pack + j0 * kc;
+        for (std::size_t i0 = 0; i0 < mc; i0 += MR) {
+            const std::size_t mr = std::min(MR, mc - i0);
+            const double* a_pasek = a_pack + i0 * kc;
+            double* c_kafel = c + i0 * rsc + j0;
+            if (mr == MR && nr == NR) {
+                jadro.f(kc, a_pasek, b_pasek, c_kafel, rsc);
+                continue;
+            }
+            double tmp[simd_mr_max * simd_nr_max];
+            for (std::size_t i = 0; i < MR; ++i) {
+                for (std::size_t j = 0; j < NR; ++j) {
+                    tmp[i * NR + j] = i < mr && j < nr ? c_kafel[i * rsc + j] : 0.0;
+                }
+            }
+            jadro.f(kc, a_pasek, b_pasek, tmp, static_cast<std::ptrdiff_t>(NR));
+            for (std::size_t i = 0; i < mr; ++i) {
+                std::memcpy(c_kafel + i * rsc, tmp + i * NR, nr * sizeof(double));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Blokowe mnożenie macierzy z pakowaniem paneli w jednym wątku: C = C ⊕ alpha · A ⊗ B
+ *
+ * Pętle w kolejności GotoBLAS: panel kolumn B (NC) → blok wspólnego
+ * wymiaru (KC, pakowanie B) → blok wierszy A (MC, pakowanie A) →
+ * makro-jądro. Bufory pakowania są lokalne dla wątku i wielokrotnie
+ * używane, więc w stanie ustalonym mnożenie nie alokuje pamięci.
+ *
+ * @complexity O(m × n × k)
+ */
+template <typename E>
+void gemm_szeregowo(const mikro_jadro& jadro, std::size_t m, std::size_t n, std::size_t k, double alpha,
+                    const E* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                    const E* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                    double* c, std::ptrdiff_t rsc) {
+    thread_local bufor_roboczy bufor_a;
+    thread_local bufor_roboczy bufor_b;
+
+    const std::size_t MR = jadro.mr, NR = jadro.nr;
+    // Bloki MC i NC są wielokrotnościami MR i NR, aby tylko ostatni kafelek był niepełny
+    const std::size_t mc_blok = gemm_mc / MR * MR;
+    const std::size_t nc_blok = gemm_nc / NR * NR;
+
+    const std::size_t nc_max = std::min(nc_blok, (n + NR - 1) / NR * NR);
+    const std::size_t mc_max = std::min(mc_blok, (m + MR - 1) / MR * MR);
+    const std::size_t kc_max = std::min(gemm_kc, k);
+    double* a_pack = bufor_a.zapewnij(mc_max * kc_max);
+    double* b_pack = bufor_b.zapewnij(kc_max * nc_max);
+
+    for (std::size_t jc = 0; jc < n; jc += nc_blok) {
+        const std::size_t nc = std::min(nc_blok, n - jc);
+        for (std::size_t pc = 0; pc < k; pc += gemm_kc) {
+            const std::size_t kc = std::min(gemm_kc, k - pc);
+            pakuj_b(kc, nc, NR, b + pc * rsb + jc * csb, rsb, csb, b_pack);
+            for (std::size_t ic = 0; ic < m; ic += mc_blok) {
+                const std::size_t mc = std::min(mc_blok, m - ic);
+                pakuj_a(mc, kc, MR, alpha, a + ic * rsa + pc * csa, rsa, csa, a_pack);
+                makro_jadro(jadro, mc, nc, kc, a_pack, b_pack, c + ic * rsc + jc, rsc);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Blokowe mnożenie macierzy z pakowaniem paneli: C = C ⊕ alpha · A ⊗ B
+ *
+ * Duże iloczyny dzielone są na dwuwymiarowe kafelki wyniku (wielokrotności
+ * MC × NR), które wątki puli pobierają i kradną sobie nawzajem. Kafelki
+ * są rozłączne w C, więc nie wymagają synchronizacji; każdy wątek pakuje
+ * własne fragmenty A i B do swoich buforów. Praca poniżej progu
+ * thread_pool::get_serial_cutoff() wykonywana jest w jednym wątku.
+ *
+ * @complexity O(m × n × k)
+ */
+template <typename E>
+void gemm_blocked_impl(const mikro_jadro& jadro, std::size_t m, std::size_t n, std::size_t k, double alpha,
+                       const E* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                       const E* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                       double* c, std::ptrdiff_t rsc) {
+    if (m == 0 || n == 0 || k == 0) {
+        return;
+    }
+
+    thread_pool& pula = thread_pool::instance();
+    if (!pula.should_parallelize(m * n * k)) {
+        gemm_szeregowo(jadro, m, n, k, alpha, a, rsa, csa, b, rsb, csb, c, rsc);
+        return;
+    }
+
+    // Kafelki zaczynają od MC × 512 i są zmniejszane, aż każdy wątek dostanie kilka
+    const std::size_t MR = jadro.mr, NR = jadro.nr;
+    const std::size_t cel = pula.get_threads() * 4;
+    std::size_t kafel_m = gemm_mc / MR * MR;
+    std::size_t kafel_n = 512 / NR * NR;
+    auto liczba_kafli = [&] {
+        return ((m + kafel_m - 1) / kafel_m) * ((n + kafel_n - 1) / kafel_n);
+    };
+    while (liczba_kafli() < cel && (kafel_n > NR || kafel_m > MR)) {
+        if (kafel_n >= kafel_m && kafel_n > NR) {
+            kafel_n = std::max(NR, kafel_n / 2 / NR * NR);
+        } else {
+            kafel_m = std::max(MR, kafel_m / 2 / MR * MR);
+        }
+    }
+
+    const std::size_t kafle_w_wierszu = (n + kafel_n - 1) / kafel_n;
+    pula.parallel_for(liczba_kafli(), [&](std::size_t t) {
+        const std::size_t i0 = (t / kafle_w_wierszu) * kafel_m;
+        const std::size_t j0 = (t % kafle_w_wierszu) * kafel_n;
+        gemm_szeregowo(jadro, std::min(kafel_m, m - i0), std::min(kafel_n, n - j0), k, alpha,
+                       a + i0 * rsa, rsa, csa,
+                       b + j0 * csb, rsb, csb,
+                       c + i0 * rsc + j0, rsc);
+    });
+}
+
+/// @brief Mikro-jadro GEMM z tablicy detail::kernels()
+mikro_jadro jadro_gemm() {
+    const simd_kernels& k = kernels();
+    return {k.mr, k.nr, k.gemm_micro};
+}
+
+} // namespace
+
+void gemm_blocked(std::size_t m, std::size_t n, std::size_t k, double alpha,
+                  const double* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                  const double* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                  double* c, std::ptrdiff_t rsc) {
+    gemm_blocked_impl(jadro_gemm(), m, n, k, alpha, a, rsa, csa, b, rsb, csb, c, rsc);
+}
+
+void gemm_blocked(std::size_t m, std::size_t n, std::size_t k, double alpha,
+                  const float* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                  const float* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                  double* c, std::ptrdiff_t rsc) {
+    gemm_blocked_impl(jadro_gemm(), m, n, k, alpha, a, rsa, csa, b, rsb, csb, c, rsc);
+}
+
+void gemm_blocked(const mikro_jadro& jadro, std::size_t m, std::size_t n, std::size_t k,
+                  const double* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                  const double* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                  double* c, std::ptrdiff_t rsc) {
+    gemm_blocked_impl(jadro, m, n, k, 1.0, a, rsa, csa, b, rsb, csb, c, rsc);
+}
+
+/**
+ * @brief Mnożenie w konwencji BLAS: C = alpha * A * B + beta * C
+ *
+ * Najpierw C jest skalowane przez beta (dla beta == 0 zerowane, więc
+ * wartości NaN w niezainicjalizowanym C nie przechodzą do wyniku),
+ * a następnie iloczyn jest akumulowany. Małe iloczyny (m·n·k < gemm_prog)
+ * liczone są prostą pętlą, większe przez gemm_blocked(). Prosta pętla
+ * dobiera kolejność do układu B: i-k-j, gdy wiersze B są ciągłe, oraz
+ * iloczyny skalarne i-j-k, gdy B jest transponowane (A * Bᵀ), tak aby
+ * najbardziej wewnętrzna pętla zawsze czytała pamięć sekwencyjnie.
+ *
+ * @complexity O(m × n × k)
+ */
+void gemm(std::size_t m, std::size_t n, std::size_t k, double alpha,
+          const double* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+          const double* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+          double beta, double* c, std::ptrdiff_t rsc) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+
+    if (beta != 1.0) {
+        const simd_kernels& jadra = kernels();
+        thread_pool::instance().parallel_rows(m, n, [&](std::size_t r0, std::size_t r1) {
+            for (std::size_t i = r0; i < r1; ++i) {
+                if (beta == 0.0) {
+                    std::fill_n(c + i * rsc, n, 0.0);
+                } else {
+                    jadra.mul_scalar(n, c + i * rsc, beta, c + i * rsc);
+                }
+            }
+        });
+    }
+    if (k == 0 || alpha == 0.0) {
+        return;
+    }
+
+    if (m * n * k >= gemm_prog) {
+        gemm_blocked(m, n, k, alpha, a, rsa, csa, b, rsb, csb, c, rsc);
+        return;
+    }
+    if (csb != 1 && rsb == 1) {
+        for (std::size_t i = 0; i < m; i++) {
+            double* wynik = c + i * rsc;
+            for (std::size_t j = 0; j < n; j++) {
+                const double* kolumna_b = b + j * csb;
+                double suma = 0.0;
+                for (std::size_t p = 0; p < k; p++) {
+                    suma += a[i * rsa + p * csa] * kolumna_b[p];
+                }
+                wynik[j] += alpha * suma;
+            }
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < m; i++) {
+        double* wynik = c + i * rsc;
+        for (std::size_t p = 0; p < k; p++) {
+            const double aip = alpha * a[i * rsa + p * csa];
+            const double* wiersz_b = b + p * rsb;
+            for (std::size_t j = 0; j < n; j++) {
+                wynik[j] += aip * wiersz_b[j * csb];
+            }
+        }
+    }
+}
+
+} // namespace detail
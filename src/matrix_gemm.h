@@ -0,0 +1,182 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/// @file matrix_gemm.h
+/// @brief Wewnetrzny silnik mnozenia macierzy (GEMM) z blokowaniem pod cache
+///
+/// Silnik dzieli iloczyn C += A * B na bloki dopasowane do hierarchii pamieci:
+/// panel B (KC x NC) miesci sie w L3, blok A (MC x KC) w L2, a pojedynczy
+/// pasek B (KC x NR) w L1. Bloki sa pakowane do ciaglych buforow, a
+/// mikro-jadro liczy kafelek MR x NR wyniku w rejestrach. Mikro-jadro (i wraz
+/// z nim MR, NR) pochodzi z tablicy detail::kernels() wybranej przy starcie.
+///
+/// Macierze opisywane sa wskaznikiem i dwoma krokami (row stride, col stride),
+/// dzieki czemu ten sam kod obsluguje dowolne rozmieszczenie elementow w pamieci.
+namespace detail {
+
+/// @brief Wyrownany do linii cache bufor roboczy (na panele GEMM, przestrzen Strassena)
+/// Bufor rosnie tylko wtedy, gdy zadany rozmiar przekracza dotychczasowy,
+/// wiec kolejne mnozenia tego samego rozmiaru nie alokuja pamieci.
+struct bufor_roboczy {
+    double* ptr = nullptr;
+    std::size_t pojemnosc = 0;
+
+    bufor_roboczy() = default;
+    bufor_roboczy(const bufor_roboczy&) = delete;
+    bufor_roboczy& operator=(const bufor_roboczy&) = delete;
+
+    ~bufor_roboczy() {
+        ::operator delete[](ptr, std::align_val_t{64});
+    }
+
+    /// @brief Zwraca bufor na co najmniej n elementow (poprzednia zawartosc jest tracona)
+    double* zapewnij(std::size_t n) {
+        if (n > pojemnosc) {
+            ::operator delete[](ptr, std::align_val_t{64});
+            ptr = nullptr;
+            pojemnosc = 0;
+            ptr = static_cast<double*>(::operator new[](n * sizeof(double), std::align_val_t{64}));
+            pojemnosc = n;
+        }
+        return ptr;
+    }
+};
+
+/// @brief Wysokosc bloku A trzymanego w L2
+constexpr std::size_t gemm_mc = 128;
+
+/// @brief Glebokosc blokow A i B (wspolny wymiar)
+constexpr std::size_t gemm_kc = 256;
+
+/// @brief Szerokosc panelu B trzymanego w L3
+constexpr std::size_t gemm_nc = 4096;
+
+/// @brief Liczba operacji m*n*k, od ktorej operator* uzywa silnika blokowego
+/// Ponizej tego progu koszt pakowania przewyzsza zysk i wystarcza prosta petla.
+constexpr std::size_t gemm_prog = 32 * 32 * 32;
+
+/// @brief Mikro-jadro silnika blokowego: kafelek mr x nr wyniku C = C (+) A_pack (x) B_pack
+/// (+) i (x) to dodawanie i mnozenie (GEMM) albo dzialania polpierscienia.
+/// Paski A_pack (kc x mr, kolumnami) i B_pack (kc x nr, wierszami) sa
+/// przygotowane przez pakowanie silnika.
+struct mikro_jadro {
+    std::size_t mr; ///< liczba wierszy kafelka (<= simd_mr_max)
+    std::size_t nr; ///< liczba kolumn kafelka (<= simd_nr_max)
+    void (*f)(std::size_t kc, const double* a_pack, const double* b_pack,
+              double* c, std::ptrdiff_t rsc);
+};
+
+/// @brief Mnozenie z akumulacja: C += alpha * A * B
+/// @param m Liczba wierszy A i C
+/// @param n Liczba kolumn B i C
+/// @param k Liczba kolumn A i wierszy B
+/// @param alpha Mnoznik iloczynu (stosowany przy pakowaniu A)
+/// @param a Wskaznik na element A(0, 0)
+/// @param rsa Odstep miedzy wierszami A (w elementach)
+/// @param csa Odstep miedzy kolumnami A (w elementach)
+/// @param b Wskaznik na element B(0, 0)
+/// @param rsb Odstep miedzy wierszami B (w elementach)
+/// @param csb Odstep miedzy kolumnami B (w elementach)
+/// @param c Wskaznik na element C(0, 0)
+/// @param rsc Odstep miedzy wierszami C (kolumny C musza byc ciagle)
+void gemm_blocked(std::size_t m, std::size_t n, std::size_t k, double alpha,
+                  const double* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                  const double* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                  double* c, std::ptrdiff_t rsc);
+
+/// @brief Mnozenie z akumulacja dla operandow float: C += alpha * A * B
+/// Elementy A i B sa rozszerzane do double przy pakowaniu paneli, wiec
+/// z pamieci czytana jest polowa bajtow, a sumy liczone sa w double.
+void gemm_blocked(std::size_t m, std::size_t n, std::size_t k, double alpha,
+                  const float* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                  const float* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                  double* c, std::ptrdiff_t rsc);
+
+/// @brief Silnik blokowy z wlasnym mikro-jadrem: C = C (+) A (x) B
+/// Ten sam podzial na kafelki miedzy watki, petle NC -> KC -> MC i pakowanie
+/// co gemm_blocked() dla GEMM, ale kafelki liczy `jadro` (np. polpierscienia).
+/// Wiersze i kolumny dopelniajace paski trafiaja tylko do nadmiarowych
+/// elementow kafelkow brzegowych, ktore nie sa zapisywane do C, wiec
+/// dzialania nie potrzebuja elementu neutralnego przy pakowaniu; C musi byc
+/// wczesniej wypelnione zerem polpierscienia.
+/// @param jadro Mikro-jadro i wymiary jego kafelka
+/// @param m Liczba wierszy A i C
+/// @param n Liczba kolumn B i C
+/// @param k Liczba kolumn A i wierszy B (0 - C bez zmian)
+/// @param a Wskaznik na element A(0, 0)
+/// @param rsa Odstep miedzy wierszami A (w elementach)
+/// @param csa Odstep miedzy kolumnami A (w elementach)
+/// @param b Wskaznik na element B(0, 0)
+/// @param rsb Odstep miedzy wierszami B (w elementach)
+/// @param csb Odstep miedzy kolumnami B (w elementach)
+/// @param c Wskaznik na element C(0, 0)
+/// @param rsc Odstep miedzy wierszami C (kolumny C musza byc ciagle)
+void gemm_blocked(const mikro_jadro& jadro, std::size_t m, std::size_t n, std::size_t k,
+                  const double* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                  const double* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                  double* c, std::ptrdiff_t rsc);
+
+/// @brief Mnozenie w konwencji BLAS: C = alpha * A * B + beta * C
+/// Wybiera prosta petle dla malych iloczynow i gemm_blocked() dla duzych.
+/// Transpozycja operandu to zamiana jego krokow (rs, cs).
+/// @param m Liczba wierszy A i C
+/// @param n Liczba kolumn B i C
+/// @param k Liczba kolumn A i wierszy B
+/// @param alpha Mnoznik iloczynu
+/// @param a Wskaznik na element A(0, 0)
+/// @param rsa Odstep miedzy wierszami A (w elementach)
+/// @param csa Odstep miedzy kolumnami A (w elementach)
+/// @param b Wskaznik na element B(0, 0)
+/// @param rsb Odstep miedzy wierszami B (w elementach)
+/// @param csb Odstep miedzy kolumnami B (w elementach)
+/// @param beta Mnoznik dotychczasowej zawartosci C (0 - C jest nadpisywane)
+/// @param c Wskaznik na element C(0, 0)
+/// @param rsc Odstep miedzy wierszami C (kolumny C musza byc ciagle)
+void gemm(std::size_t m, std::size_t n, std::size_t k, double alpha,
+          const double* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+          const double* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+          double beta, double* c, std::ptrdiff_t rsc);
+
+/// @brief Mnozenie metoda Strassena-Winograda: C = A * B
+/// Rekurencja dzieli macierze na cwiartki, az najmniejszy wymiar spadnie
+/// do `prog_przejscia`; ponizej liczy klasyczny gemm(). Nieparzyste wymiary
+/// sa obslugiwane przez odciecie ostatniego wiersza/kolumny. Przestrzen
+/// robocza dla wszystkich poziomow jest alokowana raz, przed rekurencja.
+/// @param m Liczba wierszy A i C
+/// @param n Liczba kolumn B i C
+/// @param k Liczba kolumn A i wierszy B
+/// @param a Wskaznik na element A(0, 0) (kolumny ciagle)
+/// @param rsa Odstep miedzy wierszami A
+/// @param b Wskaznik na element B(0, 0) (kolumny ciagle)
+/// @param rsb Odstep miedzy wierszami B
+/// @param c Wskaznik na element C(0, 0) (kolumny ciagle, nie moze nakladac sie na A i B)
+/// @param rsc Odstep miedzy wierszami C
+/// @param prog_przejscia Rozmiar, ponizej ktorego uzywany jest algorytm klasyczny (>= 1)
+void gemm_strassen(std::size_t m, std::size_t n, std::size_t k,
+                   const double* a, std::ptrdiff_t rsa,
+                   const double* b, std::ptrdiff_t rsb,
+                   double* c, std::ptrdiff_t rsc,
+                   std::size_t prog_przejscia);
+
+/// @brief Mnozenie macierzy int8 z akumulacja w int32: C = A * B
+/// B jest przepakowywane do par int16 przeplecionych wzdluz wspolnego wymiaru,
+/// dzieki czemu jedna instrukcja PMADDWD liczy dwa kroki sumy. Wynik jest
+/// dokladny, dopoki |suma| < 2^31, czyli zawsze dla k < 131072 (k * 128^2 < 2^31;
+/// przy k = 131072 i wszystkich elementach -128 suma wynosi dokladnie 2^31).
+/// @param m Liczba wierszy A i C
+/// @param n Liczba kolumn B i C
+/// @param k Liczba kolumn A i wierszy B
+/// @param a Wskaznik na element A(0, 0) (kolumny ciagle)
+/// @param rsa Odstep miedzy wierszami A
+/// @param b Wskaznik na element B(0, 0) (kolumny ciagle)
+/// @param rsb Odstep miedzy wierszami B
+/// @param c Wskaznik na element C(0, 0) (kolumny ciagle, C jest nadpisywane)
+/// @param rsc Odstep miedzy wierszami C
+void gemm_i8(std::size_t m, std::size_t n, std::size_t k,
+             const std::int8_t* a, std::ptrdiff_t rsa,
+             const std::int8_t* b, std::ptrdiff_t rsb,
+             std::int32_t* c, std::ptrdiff_t rsc);
+
+} // namespace detail
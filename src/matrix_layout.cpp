@@ -0,0 +1,388 @@
+#include "../include/layout_matrix.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t tile = layout_matrix::tile;
+
+/// @brief Dlugosc fragmentu tablicy danych przetwarzanego przez jedno zadanie
+constexpr std::size_t fragment = 4096;
+
+/// @brief Krok wiersza/kolumny - n zaokraglone do pelnej linii cache (8 double)
+std::size_t zaokraglij(std::size_t n) noexcept { return (n + 7) / 8 * 8; }
+
+/// @brief Indeks Mortona (kolejnosc Z): bity ti i tj na przemian
+std::uint64_t morton(std::uint32_t ti, std::uint32_t tj) noexcept {
+    std::uint64_t z = 0;
+    for (unsigned b = 0; b < 32; ++b) {
+        z |= static_cast<std::uint64_t>((tj >> b) & 1u) << (2 * b);
+        z |= static_cast<std::uint64_t>((ti >> b) & 1u) << (2 * b + 1);
+    }
+    return z;
+}
+
+/// @brief Wykonuje f(ti, tj) dla kazdego kafelka siatki kr x kc (rownolegle, jesli praca jest duza)
+template <typename F>
+void po_kafelkach(std::size_t kr, std::size_t kc, std::size_t praca, F f) {
+    auto& pula = thread_pool::instance();
+    if (kr * kc < 2 || !pula.should_parallelize(praca)) {
+        for (std::size_t ti = 0; ti < kr; ++ti) {
+            for (std::size_t tj = 0; tj < kc; ++tj) f(ti, tj);
+        }
+        return;
+    }
+    pula.parallel_for(kr * kc, [&](std::size_t t) { f(t / kc, t % kc); });
+}
+
+/// @brief Suma n kolejnych liczb (cztery niezalezne akumulatory)
+double suma(const double* x, std::size_t n) noexcept {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += x[i];
+        s1 += x[i + 1];
+        s2 += x[i + 2];
+        s3 += x[i + 3];
+    }
+    for (; i < n; ++i) s0 += x[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief Dodaje sumy kolumn fragmentu do s[0..cols)
+ *
+ * Kolumny ciągłe są sumowane bezpośrednio, a przy wierszach ciągłych
+ * kolejne wiersze są dodawane do wektora sum jądrem axpy - w obu
+ * przypadkach pamięć jest czytana sekwencyjnie.
+ */
+void dodaj_sumy_kolumn(const_matrix_view v, double* s) {
+    if (v.contiguous_rows()) {
+        const auto& k = detail::kernels();
+        for (std::size_t i = 0; i < v.get_rows(); ++i) {
+            k.axpy(v.get_cols(), 1.0, v.row_ptr(i), s);
+        }
+        return;
+    }
+    for (std::size_t j = 0; j < v.get_cols(); ++j) {
+        if (v.contiguous_cols()) {
+            s[j] += suma(&v(0, j), v.get_rows());
+        } else {
+            for (std::size_t i = 0; i < v.get_rows(); ++i) s[j] += v(i, j);
+        }
+    }
+}
+
+/// @brief Rzuca wyjatek, jesli wymiary macierzy sie nie zgadzaja
+void wymagaj_wymiarow(const layout_matrix& a, const layout_matrix& b) {
+    if (a.get_rows() != b.get_rows() || a.get_cols() != b.get_cols())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor macierzy zerowej o zadanym układzie
+ *
+ * W układzie tiled kafelki brzegowe zajmują pełne tile × tile elementów
+ * (dopełnienie zerami), a kolejność kafelków w pamięci wyznacza
+ * posortowanie ich indeksów Mortona - sąsiedzi w obu kierunkach leżą
+ * blisko siebie także dla macierzy prostokątnych.
+ *
+ * @param rows liczba wierszy
+ * @param cols liczba kolumn
+ * @param layout układ elementów
+ */
+layout_matrix::layout_matrix(std::size_t rows, std::size_t cols, storage_layout layout)
+    : rows(rows), cols(cols), uklad(layout),
+      kafle_r((rows + tile - 1) / tile), kafle_c((cols + tile - 1) / tile) {
+    switch (uklad) {
+    case storage_layout::row_major:
+        ld = zaokraglij(cols);
+        dane.assign(rows * ld, 0.0);
+        break;
+    case storage_layout::col_major:
+        ld = zaokraglij(rows);
+        dane.assign(cols * ld, 0.0);
+        break;
+    case storage_layout::tiled: {
+        const std::size_t n = kafle_r * kafle_c;
+        std::vector<std::size_t> wg_z(n);
+        std::iota(wg_z.begin(), wg_z.end(), std::size_t{0});
+        std::sort(wg_z.begin(), wg_z.end(), [&](std::size_t a, std::size_t b) {
+            return morton(static_cast<std::uint32_t>(a / kafle_c), static_cast<std::uint32_t>(a % kafle_c)) <
+                   morton(static_cast<std::uint32_t>(b / kafle_c), static_cast<std::uint32_t>(b % kafle_c));
+        });
+        kolejnosc.resize(n);
+        for (std::size_t p = 0; p < n; ++p) kolejnosc[wg_z[p]] = p;
+        dane.assign(n * tile * tile, 0.0);
+        break;
+    }
+    }
+}
+
+/**
+ * @brief Kopia macierzy lub fragmentu w zadanym układzie
+ *
+ * Kafelki są przepisywane równolegle przypisaniem widoków, więc sposób
+ * kopiowania (memcpy wierszy, blokowa transpozycja) zależy od kroków
+ * źródła i celu.
+ *
+ * @param m macierz lub widok źródłowy
+ * @param layout układ elementów
+ */
+layout_matrix::layout_matrix(const_matrix_view m, storage_layout layout)
+    : layout_matrix(m.get_rows(), m.get_cols(), layout) {
+    po_kafelkach(kafle_r, kafle_c, rows * cols, [&](std::size_t ti, std::size_t tj) {
+        matrix_view w = tile_view(ti, tj);
+        w = m.block(ti * tile, tj * tile, w.get_rows(), w.get_cols());
+    });
+}
+
+matrix_view layout_matrix::view() {
+    switch (uklad) {
+    case storage_layout::row_major:
+        return matrix_view(dane.data(), rows, cols, static_cast<std::ptrdiff_t>(ld), 1);
+    case storage_layout::col_major:
+        return matrix_view(dane.data(), rows, cols, 1, static_cast<std::ptrdiff_t>(ld));
+    default:
+        throw std::runtime_error("Układ kafelkowy nie ma widoku całej macierzy");
+    }
+}
+
+const_matrix_view layout_matrix::view() const {
+    return const_cast<layout_matrix*>(this)->view();
+}
+
+/**
+ * @brief Kafelek (ti, tj) jako widok
+ *
+ * @param ti wiersz kafelka (0 .. tile_rows() - 1)
+ * @param tj kolumna kafelka (0 .. tile_cols() - 1)
+ *
+ * @return widok min(tile, rows - ti·tile) × min(tile, cols - tj·tile)
+ *
+ * @throw std::runtime_error jeśli kafelek wykracza poza macierz
+ */
+matrix_view layout_matrix::tile_view(std::size_t ti, std::size_t tj) {
+    if (ti >= kafle_r || tj >= kafle_c) throw std::runtime_error("Fragment wykracza poza macierz");
+    const std::size_t i0 = ti * tile, j0 = tj * tile;
+    const std::size_t h = std::min(tile, rows - i0), w = std::min(tile, cols - j0);
+    const std::ptrdiff_t l = static_cast<std::ptrdiff_t>(ld);
+    switch (uklad) {
+    case storage_layout::row_major: return matrix_view(dane.data() + i0 * ld + j0, h, w, l, 1);
+    case storage_layout::col_major: return matrix_view(dane.data() + j0 * ld + i0, h, w, 1, l);
+    default:
+        return matrix_view(dane.data() + kolejnosc[ti * kafle_c + tj] * (tile * tile), h, w,
+                           static_cast<std::ptrdiff_t>(tile), 1);
+    }
+}
+
+const_matrix_view layout_matrix::tile_view(std::size_t ti, std::size_t tj) const {
+    return const_cast<layout_matrix*>(this)->tile_view(ti, tj);
+}
+
+/**
+ * @brief Ta sama macierz w innym układzie
+ *
+ * Kafelki są przepisywane równolegle. Między row_major a tiled kopiowane
+ * są całe wiersze kafelka, a przejście między wierszami i kolumnami
+ * (col_major ↔ row_major / tiled) to transpozycja kafelka jądrem SIMD.
+ *
+ * @param layout układ wyniku
+ *
+ * @return nowa macierz (kopia, jeśli układ się nie zmienia)
+ *
+ * @complexity O(rows × cols)
+ */
+layout_matrix layout_matrix::to_layout(storage_layout layout) const {
+    if (layout == uklad) return *this;
+    layout_matrix wynik(rows, cols, layout);
+    po_kafelkach(kafle_r, kafle_c, rows * cols, [&](std::size_t ti, std::size_t tj) {
+        wynik.tile_view(ti, tj) = tile_view(ti, tj);
+    });
+    return wynik;
+}
+
+/**
+ * @brief Zamiana na matrix
+ *
+ * @return nowa macierz z wierszami ciągłymi
+ */
+matrix layout_matrix::to_matrix() const {
+    matrix m(rows, cols, bez_zerowania);
+    po_kafelkach(kafle_r, kafle_c, rows * cols, [&](std::size_t ti, std::size_t tj) {
+        const_matrix_view z = tile_view(ti, tj);
+        m.block(ti * tile, tj * tile, z.get_rows(), z.get_cols()) = z;
+    });
+    return m;
+}
+
+/**
+ * @brief Sumy kolumn
+ *
+ * Pasy kolumn szerokości tile są rozdzielane między wątki; w każdym
+ * pasie kafelki są sumowane sposobem dobranym do ich kroków (kolumny
+ * ciągłe w col_major, axpy po wierszach w row_major i tiled).
+ *
+ * @return wektor cols sum
+ */
+std::vector<double> layout_matrix::col_sums() const {
+    std::vector<double> s(cols, 0.0);
+    po_kafelkach(1, kafle_c, rows * cols, [&](std::size_t, std::size_t tj) {
+        for (std::size_t ti = 0; ti < kafle_r; ++ti) {
+            dodaj_sumy_kolumn(tile_view(ti, tj), s.data() + tj * tile);
+        }
+    });
+    return s;
+}
+
+/**
+ * @brief Sumy wierszy
+ *
+ * Sumy wierszy to sumy kolumn transpozycji, więc każdy kafelek jest
+ * przekazywany jako widok transponowany (bez kopii); w row_major wiersze
+ * są wtedy czytane ciągle, w col_major kolumny są dodawane jądrem axpy.
+ *
+ * @return wektor rows sum
+ */
+std::vector<double> layout_matrix::row_sums() const {
+    std::vector<double> s(rows, 0.0);
+    po_kafelkach(kafle_r, 1, rows * cols, [&](std::size_t ti, std::size_t) {
+        for (std::size_t tj = 0; tj < kafle_c; ++tj) {
+            dodaj_sumy_kolumn(tile_view(ti, tj).transpose(), s.data() + ti * tile);
+        }
+    });
+    return s;
+}
+
+/// @brief f(z, w, n) na kolejnych fragmentach danych tej macierzy (w) i `m` (z, moze byc nullptr)
+template <typename F>
+void layout_matrix::po_danych(const layout_matrix* m, F f) {
+    const std::size_t n = dane.size();
+    const std::size_t fragmenty = (n + fragment - 1) / fragment;
+    thread_pool::instance().parallel_rows(fragmenty, fragment, [&](std::size_t f0, std::size_t f1) {
+        for (std::size_t p = f0; p < f1; ++p) {
+            const std::size_t o = p * fragment, len = std::min(fragment, n - o);
+            f(m ? m->dane.data() + o : nullptr, dane.data() + o, len);
+        }
+    });
+}
+
+/**
+ * @brief Dodaje macierz element po elemencie
+ *
+ * Przy tym samym układzie obie tablice danych mają identyczne
+ * rozmieszczenie elementów, więc są dodawane liniowo jądrem SIMD
+ * (razem z dopełnieniem, które nie jest nigdy odczytywane jako element).
+ * Macierz o innym układzie jest najpierw konwertowana (to_layout()).
+ *
+ * @param m macierz o tych samych wymiarach
+ *
+ * @return referencja na bieżącą macierz
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają
+ */
+layout_matrix& layout_matrix::operator+=(const layout_matrix& m) {
+    wymagaj_wymiarow(*this, m);
+    const layout_matrix* z = &m;
+    layout_matrix tmp;
+    if (m.uklad != uklad) z = &(tmp = m.to_layout(uklad));
+    const auto& k = detail::kernels();
+    po_danych(z, [&](const double* b, double* a, std::size_t n) { k.add(n, a, b, a); });
+    return *this;
+}
+
+/**
+ * @brief Odejmuje macierz element po elemencie
+ *
+ * @param m macierz o tych samych wymiarach (dowolny układ)
+ *
+ * @return referencja na bieżącą macierz
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają
+ *
+ * @see operator+=(const layout_matrix&)
+ */
+layout_matrix& layout_matrix::operator-=(const layout_matrix& m) {
+    wymagaj_wymiarow(*this, m);
+    const layout_matrix* z = &m;
+    layout_matrix tmp;
+    if (m.uklad != uklad) z = &(tmp = m.to_layout(uklad));
+    const auto& k = detail::kernels();
+    po_danych(z, [&](const double* b, double* a, std::size_t n) { k.sub(n, a, b, a); });
+    return *this;
+}
+
+layout_matrix& layout_matrix::operator+=(double a) noexcept {
+    const auto& k = detail::kernels();
+    po_danych(nullptr, [&](const double*, double* w, std::size_t n) { k.add_scalar(n, w, a, w); });
+    return *this;
+}
+
+layout_matrix& layout_matrix::operator*=(double a) noexcept {
+    const auto& k = detail::kernels();
+    po_danych(nullptr, [&](const double*, double* w, std::size_t n) { k.mul_scalar(n, w, a, w); });
+    return *this;
+}
+
+/**
+ * @brief Iloczyn macierzy o dowolnych układach
+ *
+ * Bez układu tiled całe macierze trafiają do gemm() jako widoki: silnik
+ * pakuje panele zgodnie z krokami (kolumny col_major są czytane ciągle),
+ * a wynik col_major jest liczony jako transpozycja iloczynu.
+ *
+ * Z układem tiled praca jest dzielona kafelkami wyniku: wątek liczy
+ * C(ti, tj) = Σ_p A(ti, p) · B(p, tj) na kafelkach mieszczących się
+ * w L2, a żaden kafelek wyniku nie jest współdzielony.
+ *
+ * @param A lewy operand (dowolny układ)
+ * @param B prawy operand (dowolny układ)
+ *
+ * @return nowa macierz A.rows × B.cols w układzie A
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ *
+ * @complexity O(m × n × k)
+ */
+layout_matrix operator*(const layout_matrix& A, const layout_matrix& B) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    layout_matrix C(A.get_rows(), B.get_cols(), A.layout());
+    if (A.layout() != storage_layout::tiled && B.layout() != storage_layout::tiled) {
+        gemm(C.view(), A.view(), B.view());
+        return C;
+    }
+    const std::size_t kt = A.tile_cols();
+    po_kafelkach(C.tile_rows(), C.tile_cols(), C.get_rows() * C.get_cols() * A.get_cols(),
+                 [&](std::size_t ti, std::size_t tj) {
+        matrix_view c = C.tile_view(ti, tj);
+        for (std::size_t p = 0; p < kt; ++p) {
+            gemm(c, A.tile_view(ti, p), B.tile_view(p, tj), 1.0, p ? 1.0 : 0.0);
+        }
+    });
+    return C;
+}
+
+/**
+ * @brief Porównanie wszystkich elementów
+ *
+ * Porównywane są kafelki (widoki), więc dopełnienie tablic danych nie
+ * wpływa na wynik, a macierze mogą mieć różne układy.
+ *
+ * @return prawda, jeśli wymiary i wszystkie elementy są równe
+ */
+bool operator==(const layout_matrix& A, const layout_matrix& B) {
+    if (A.get_rows() != B.get_rows() || A.get_cols() != B.get_cols()) return false;
+    for (std::size_t ti = 0; ti < A.tile_rows(); ++ti) {
+        for (std::size_t tj = 0; tj < A.tile_cols(); ++tj) {
+            if (!(A.tile_view(ti, tj) == B.tile_view(ti, tj))) return false;
+        }
+    }
+    return true;
+}
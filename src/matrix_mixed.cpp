@@ -0,0 +1,215 @@
+#include "../include/matrix.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/// @brief Szerokosc bloku kolumn wyniku liczonego naraz
+constexpr std::size_t blok_kolumn = 256;
+
+/// @brief Liczba wierszy wyniku liczonych naraz (akumulatory 16 x 1 KiB w L1)
+constexpr std::size_t blok_wierszy = 16;
+
+/// @brief Glebokosc bloku B (blok_k x blok_kolumn float = 128 KiB w L2)
+constexpr std::size_t blok_k = 128;
+
+/// @brief Liczba skladnikow sumowanych kolejno w lisciu drzewa sumowania parami
+constexpr std::size_t lisc_parami = 32;
+
+/// @brief Wiersze akumulatorow jednego rodzaju (suma, poprawka, poziom stosu)
+constexpr std::size_t akumulatory = blok_wierszy * blok_kolumn;
+
+/**
+ * @brief Iloczyn liczony blokami wyniku blok_wierszy × blok_kolumn
+ *
+ * Kolejność i-k-j: bloki wierszy wyniku są akumulatorami, do których
+ * dodawane są kolejne wiersze B przemnożone przez A(i, p). Fragment
+ * wiersza B jest czytany raz dla całego bloku wierszy A, sekwencyjnie
+ * i wektorowo. Blok liczy `f(mb, nb, a, lda, b, ldb, bufory, c, ldc)`,
+ * gdzie a, b, c to początki bloków A, B i C, a bufory - `rodzajow`
+ * zestawów akumulatorów po blok_wierszy × blok_kolumn elementów
+ * (f sama je zeruje).
+ */
+template <typename F>
+void blokami(const matrix_f32& A, const matrix_f32& B, matrix_f32& C,
+             std::size_t rodzajow, F f) {
+    const std::size_t m = A.get_rows(), k = A.get_cols(), n = B.get_cols();
+    const std::size_t bloki_wierszy = (m + blok_wierszy - 1) / blok_wierszy;
+    thread_pool::instance().parallel_rows(bloki_wierszy, blok_wierszy * n * k, [&](std::size_t r0, std::size_t r1) {
+        thread_local std::vector<float> bufory;
+        if (bufory.size() < rodzajow * akumulatory) bufory.resize(rodzajow * akumulatory);
+        for (std::size_t jc = 0; jc < n; jc += blok_kolumn) {
+            const std::size_t nb = std::min(blok_kolumn, n - jc);
+            for (std::size_t i0 = r0 * blok_wierszy; i0 < std::min(m, r1 * blok_wierszy); i0 += blok_wierszy) {
+                const std::size_t mb = std::min(blok_wierszy, m - i0);
+                f(mb, nb, A.row_ptr(i0), A.get_stride(), B.data.get() + jc, B.get_stride(),
+                  bufory.data(), C.row_ptr(i0) + jc, C.get_stride());
+            }
+        }
+    });
+}
+
+/// @brief Przepisuje mb wierszy akumulatorow do wyniku
+void zapisz(std::size_t mb, std::size_t nb, const float* s, float* c, std::size_t ldc) {
+    for (std::size_t r = 0; r < mb; ++r) {
+        std::memcpy(c + r * ldc, s + r * blok_kolumn, nb * sizeof(float));
+    }
+}
+
+/**
+ * @brief Akumulatory += A[mb × k] * B[k × nb] jądrem gemm_f32
+ *
+ * Wspólny wymiar przechodzony jest blokami blok_k, a w bloku - grupami
+ * po simd_f32_mr wierszy, więc blok B czytany przez kolejne grupy
+ * pozostaje w L2. Podział nie zmienia kolejności sumowania elementu.
+ */
+void dodaj_iloczyn(const detail::simd_kernels& jadra, std::size_t mb, std::size_t k, std::size_t nb,
+                   const float* a, std::size_t lda, const float* b, std::size_t ldb, float* s) {
+    for (std::size_t pc = 0; pc < k; pc += blok_k) {
+        const std::size_t kc = std::min(blok_k, k - pc);
+        for (std::size_t r = 0; r < mb; r += detail::simd_f32_mr) {
+            jadra.gemm_f32(std::min(detail::simd_f32_mr, mb - r), kc, nb, a + r * lda + pc, lda,
+                           b + pc * ldb, ldb, s + r * blok_kolumn, blok_kolumn);
+        }
+    }
+}
+
+/// @brief Suma w float: c += a * b
+void iloczyn_f32(const matrix_f32& A, const matrix_f32& B, matrix_f32& C) {
+    const auto& jadra = detail::kernels();
+    const std::size_t k = A.get_cols();
+    blokami(A, B, C, 1, [&](std::size_t mb, std::size_t nb, const float* a, std::size_t lda,
+                            const float* b, std::size_t ldb, float* s, float* c, std::size_t ldc) {
+        std::fill_n(s, akumulatory, 0.0f);
+        dodaj_iloczyn(jadra, mb, k, nb, a, lda, b, ldb, s);
+        zapisz(mb, nb, s, c, ldc);
+    });
+}
+
+/// @brief Suma w float z kompensacja Kahana (akumulatory: sumy, poprawki)
+void iloczyn_kahan(const matrix_f32& A, const matrix_f32& B, matrix_f32& C) {
+    const auto& jadra = detail::kernels();
+    const std::size_t k = A.get_cols();
+    blokami(A, B, C, 2, [&](std::size_t mb, std::size_t nb, const float* a, std::size_t lda,
+                            const float* b, std::size_t ldb, float* s, float* c, std::size_t ldc) {
+        std::fill_n(s, 2 * akumulatory, 0.0f);
+        for (std::size_t pc = 0; pc < k; pc += blok_k) {
+            const std::size_t kc = std::min(blok_k, k - pc);
+            for (std::size_t r = 0; r < mb; r += detail::simd_f32_mr) {
+                jadra.gemm_f32_kahan(std::min(detail::simd_f32_mr, mb - r), kc, nb, a + r * lda + pc, lda,
+                                     b + pc * ldb, ldb, s + r * blok_kolumn,
+                                     s + akumulatory + r * blok_kolumn, blok_kolumn);
+            }
+        }
+        zapisz(mb, nb, s, c, ldc);
+    });
+}
+
+/**
+ * @brief Suma w float parami
+ *
+ * Kolejne liście po `lisc_parami` kroków sumowane są do osobnego zestawu
+ * akumulatorów i odkładane na stos, a sumy łączone jak w liczniku
+ * binarnym: gdy dwie na szczycie mają ten sam poziom, są dodawane.
+ * Daje to drzewo sum o głębokości log2(k / lisc_parami), bez rekurencji
+ * i z pamięcią O(log k) zestawów akumulatorów.
+ */
+void iloczyn_parami(const matrix_f32& A, const matrix_f32& B, matrix_f32& C) {
+    const auto& jadra = detail::kernels();
+    const std::size_t k = A.get_cols();
+    // Stos ma najwyzej log2(liczba lisci) + 1 sum czesciowych
+    std::size_t pojemnosc = 1;
+    while ((lisc_parami << (pojemnosc - 1)) < k) ++pojemnosc;
+
+    auto dodaj = [&](std::size_t mb, std::size_t nb, const float* z, float* do_) {
+        for (std::size_t r = 0; r < mb; ++r) {
+            jadra.axpy_f32(nb, 1.0f, z + r * blok_kolumn, do_ + r * blok_kolumn);
+        }
+    };
+    blokami(A, B, C, pojemnosc, [&](std::size_t mb, std::size_t nb, const float* a, std::size_t lda,
+                                    const float* b, std::size_t ldb, float* stos, float* c, std::size_t ldc) {
+        unsigned poziomy[64];
+        std::size_t wysokosc = 0;
+        for (std::size_t p0 = 0; p0 < k; p0 += lisc_parami) {
+            float* lisc = stos + wysokosc * akumulatory;
+            std::fill_n(lisc, akumulatory, 0.0f);
+            const std::size_t p1 = std::min(k, p0 + lisc_parami);
+            dodaj_iloczyn(jadra, mb, p1 - p0, nb, a + p0, lda, b + p0 * ldb, ldb, lisc);
+            poziomy[wysokosc++] = 0;
+            while (wysokosc >= 2 && poziomy[wysokosc - 1] == poziomy[wysokosc - 2]) {
+                float* gorny = stos + (wysokosc - 1) * akumulatory;
+                dodaj(mb, nb, gorny, gorny - akumulatory);
+                --wysokosc;
+                ++poziomy[wysokosc - 1];
+            }
+        }
+        // Pozostale sumy czesciowe scalane od najmniejszej
+        for (; wysokosc >= 2; --wysokosc) {
+            float* gorny = stos + (wysokosc - 1) * akumulatory;
+            dodaj(mb, nb, gorny, gorny - akumulatory);
+        }
+        zapisz(mb, nb, stos, c, ldc);
+    });
+}
+
+} // namespace
+
+/**
+ * @brief Iloczyn macierzy float z wybraną akumulacją
+ *
+ * - acc_policy::f64: blokowy silnik detail::gemm_blocked() z pakowaniem,
+ *   które rozszerza panele float do double; mikro-jądro i sumy są w double,
+ *   a wynik zaokrąglany do float raz, na końcu;
+ * - acc_policy::f32, kahan, pairwise: bloki wyniku liczone jądrami SIMD
+ *   float, które trzymają akumulatory w rejestrach (simd_kernels::gemm_f32,
+ *   gemm_f32_kahan).
+ *
+ * Mnożenie przez jedynkę przy scalaniu sum częściowych (axpy z a = 1)
+ * jest dokładne, więc nie zmienia ograniczenia błędu.
+ *
+ * @param A lewy operand
+ * @param B prawy operand
+ * @param polityka sposób sumowania
+ *
+ * @return nowa macierz float z iloczynem
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ *
+ * @complexity O(n × m × p)
+ *
+ * @example
+ * @code
+ * matrix_f32 A(1000, 100000), B(100000, 10);
+ * matrix_f32 C = multiply(A, B, acc_policy::kahan);  // długie iloczyny skalarne
+ * @endcode
+ */
+matrix_f32 multiply(const matrix_f32& A, const matrix_f32& B, acc_policy polityka) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t m = A.get_rows(), k = A.get_cols(), n = B.get_cols();
+
+    if (polityka == acc_policy::f64) {
+        matrix suma(m, n);
+        detail::gemm_blocked(m, n, k, 1.0,
+                             A.data.get(), A.get_stride(), 1,
+                             B.data.get(), B.get_stride(), 1,
+                             suma.data.get(), suma.get_stride());
+        return matrix_f32(suma);
+    }
+
+    if (k == 0) {
+        return matrix_f32(m, n);
+    }
+    matrix_f32 wynik(m, n, bez_zerowania);
+    switch (polityka) {
+    case acc_policy::kahan:    iloczyn_kahan(A, B, wynik); break;
+    case acc_policy::pairwise: iloczyn_parami(A, B, wynik); break;
+    default:                   iloczyn_f32(A, B, wynik); break;
+    }
+    return wynik;
+}
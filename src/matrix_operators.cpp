@@ -1,49 +1,144 @@
 #include "../include/matrix.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+/**
+ * @brief Wywołuje f(i) dla każdego wiersza, dzieląc wiersze między wątki puli
+ *
+ * Zakresy wierszy są rozłączne, więc operacje element po elemencie
+ * nie wymagają synchronizacji. Małe macierze (poniżej progu
+ * thread_pool::get_serial_cutoff()) przetwarzane są w wątku wywołującym.
+ */
+template <typename F>
+void dla_wierszy(std::size_t rows, std::size_t cols, F&& f) {
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) f(i);
+    });
+}
+
+/**
+ * @brief Sprawdza predykat f(i) dla wszystkich wierszy (semantyka ALL)
+ *
+ * Pierwszy wiersz niespełniający warunku przerywa pracę wszystkich wątków.
+ */
+template <typename F>
+bool dla_wszystkich_wierszy(std::size_t rows, std::size_t cols, F&& f) {
+    std::atomic<bool> wynik{true};
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1 && wynik.load(std::memory_order_relaxed); ++i) {
+            if (!f(i)) wynik.store(false, std::memory_order_relaxed);
+        }
+    });
+    return wynik.load();
+}
+
+/// @brief Czy dla typu elementu sa dostepne jadra SIMD (detail::kernels())
+template <typename T>
+constexpr bool ma_jadra_v = std::is_same_v<T, double>;
+
+/**
+ * @brief Wykonuje f(x, y) dla każdej pary elementów wiersza (wersja ogólna)
+ *
+ * Używana dla typów bez jąder SIMD; pętla po ciągłym wierszu jest
+ * wektoryzowana przez kompilator.
+ */
+template <typename T, typename F>
+void dla_elementow(basic_matrix<T>& a, const basic_matrix<T>* b, F f) {
+    const std::size_t cols = a.get_cols();
+    dla_wierszy(a.get_rows(), cols, [&](std::size_t i) {
+        T* x = a.row_ptr(i);
+        const T* y = b ? b->row_ptr(i) : x;
+        for (std::size_t j = 0; j < cols; ++j) f(x[j], y[j]);
+    });
+}
+
+/// @brief Sprawdza warunek p(x, y) dla wszystkich par elementów (wersja ogólna)
+template <typename T, typename P>
+bool dla_wszystkich_elementow(const basic_matrix<T>& a, const basic_matrix<T>& b, P p) {
+    const std::size_t cols = a.get_cols();
+    return dla_wszystkich_wierszy(a.get_rows(), cols, [&](std::size_t i) {
+        const T* x = a.row_ptr(i);
+        const T* y = b.row_ptr(i);
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (!p(x[j], y[j])) return false;
+        }
+        return true;
+    });
+}
+
+} // namespace
 
 /**
- * @brief Operator dodawania macierzy - A + B
+ * @brief Operator przypisania z dodawaniem macierzy - A += B
  * 
- * Dodaje dwie macierze tego samego rozmiaru, zwracając nową macierz
- * zawierającą sumę elementów. Operacja odbywa się element po elemencie.
+ * Dodaje macierz `m` element po elemencie, w miejscu.
  * 
- * @param m macierz do dodania (prawy operand)
+ * @param m macierz do dodania
  * 
- * @return referencja na nową macierz zawierającą sumę A + B
+ * @return referencja na bieżącą macierz (po modyfikacji)
  * 
  * @throw std::runtime_error jeśli wymiary macierzy nie są zgodne
- *        (rows lub cols się różnią)
  * 
- * @pre this->rows == m.rows && this->cols == m.cols
- * @post wynikowa macierz[i][j] = this[i][j] + m[i][j]
+ * @post this[i][j] = this[i][j] + m[i][j]
  * @complexity O(n × m) gdzie n = rows, m = cols
  * 
  * @example
  * @code
- * matrix A(2, 2);
- * A(0, 0) = 1; A(0, 1) = 2;
- * A(1, 0) = 3; A(1, 1) = 4;
- * 
- * matrix B(2, 2);
- * B(0, 0) = 5; B(0, 1) = 6;
- * B(1, 0) = 7; B(1, 1) = 8;
- * 
- * matrix C = A + B;  // C[0][0] = 6, C[0][1] = 8, ...
+ * matrix A(2, 2, 1.0);
+ * matrix B(2, 2, 2.0);
+ * A += B;  // wszystkie elementy = 3.0
  * @endcode
- * 
- * @warning Używa `release()` na unique_ptr - być ostrożnym z zarządzaniem pamięcią!
  */
-matrix& matrix::operator+(matrix& m) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator+=(const basic_matrix& m) {
     if (rows != m.rows || cols != m.cols)
         throw std::runtime_error("Nieprawidłowe wymiary dla dodawania");
-    auto result = std::make_unique<matrix>(rows, cols);
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            result->data[i][j] = this->data[i][j] + m.data[i][j];
-        }
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        dla_wierszy(rows, cols, [&](std::size_t i) {
+            k.add(cols, row_ptr(i), m.row_ptr(i), row_ptr(i));
+        });
+    } else {
+        dla_elementow(*this, &m, [](T& x, T y) { x += y; });
+    }
+    return *this;
+}
+
+/**
+ * @brief Operator przypisania z odejmowaniem macierzy - A -= B
+ *
+ * Odejmuje macierz `m` element po elemencie, w miejscu.
+ *
+ * @param m macierz do odjęcia
+ *
+ * @return referencja na bieżącą macierz (po modyfikacji)
+ *
+ * @throw std::runtime_error jeśli wymiary macierzy nie są zgodne
+ *
+ * @post this[i][j] = this[i][j] - m[i][j]
+ * @complexity O(n × m) gdzie n = rows, m = cols
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator-=(const basic_matrix& m) {
+    if (rows != m.rows || cols != m.cols)
+        throw std::runtime_error("Nieprawidłowe wymiary dla odejmowania");
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        dla_wierszy(rows, cols, [&](std::size_t i) {
+            k.sub(cols, row_ptr(i), m.row_ptr(i), row_ptr(i));
+        });
+    } else {
+        dla_elementow(*this, &m, [](T& x, T y) { x -= y; });
     }
-    return *result.release();
+    return *this;
 }
 
 /**
@@ -53,9 +148,15 @@ matrix& matrix::operator+(matrix& m) {
  * Wynikowa macierz ma wymiary (rows × m.cols).
  * Liczba kolumn macierzy A musi równać się liczbie wierszy macierzy B.
  * 
+ * Dla małych macierzy (m·n·k < detail::gemm_prog) używana jest prosta
+ * pętla w kolejności i-k-j, która czyta wiersze B sekwencyjnie.
+ * Większe iloczyny trafiają do blokowego silnika detail::gemm_blocked(),
+ * który pakuje panele A i B do ciągłych buforów dopasowanych do L1/L2/L3
+ * i dzieli wynik na kafelki liczone równolegle przez thread_pool.
+ * 
  * @param m macierz mnożnika (prawy operand)
  * 
- * @return referencja na nową macierz zawierającą iloczyn A * B
+ * @return nowa macierz zawierającą iloczyn A * B
  * 
  * @throw std::runtime_error jeśli this->cols != m.rows
  * 
@@ -71,197 +172,314 @@ matrix& matrix::operator+(matrix& m) {
  * @endcode
  * 
  * @note Mnożenie macierzy nie jest przemienne: A*B ≠ B*A
- * @warning Używa `release()` na unique_ptr - być ostrożnym z zarządzaniem pamięcią!
+ * @note Iloczyn matrix_f32 to multiply(A, B, acc_policy::f32), a iloczyn
+ *       matrix_i8 liczy detail::gemm_i8() (pary int16 i PMADDWD).
+ * @note Dla pozostałych typów innych niż double iloczyn liczony jest równoległą pętlą
+ *       i-k-j z sumowaniem w akumulator_t<T> (int8 → int32, int32 → int64),
+ *       więc iloczyny macierzy całkowitych nie przepełniają się dla k
+ *       rzędu tysięcy.
  */
-matrix& matrix::operator*(matrix& m) {
+template <typename T>
+basic_matrix<akumulator_t<T>> basic_matrix<T>::operator*(const basic_matrix& m) const {
     if (cols != m.rows)
         throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
-    auto result = std::make_unique<matrix>(rows, m.cols);
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < m.cols; j++) {
-            result->data[i][j] = 0;
-            for(int k = 0; k < cols; k++) {
-                result->data[i][j] += this->data[i][k] * m.data[k][j];
+    if constexpr (ma_jadra_v<T>) {
+        basic_matrix result(rows, m.cols, bez_zerowania);
+        detail::gemm(rows, m.cols, cols, 1.0,
+                     data.get(), stride, 1,
+                     m.data.get(), m.stride, 1,
+                     0.0, result.data.get(), result.stride);
+        return result;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return multiply(*this, m, acc_policy::f32);
+    } else if constexpr (std::is_same_v<T, std::int8_t>) {
+        basic_matrix<std::int32_t> result(rows, m.cols, bez_zerowania);
+        detail::gemm_i8(rows, m.cols, cols,
+                        data.get(), stride, m.data.get(), m.stride,
+                        result.data.get(), result.stride);
+        return result;
+    } else {
+        using A = akumulator_t<T>;
+        basic_matrix<A> result(rows, m.cols);
+        const std::size_t n = m.cols, k = cols;
+        dla_wierszy(rows, n * k, [&](std::size_t i) {
+            const T* a = row_ptr(i);
+            A* c = result.row_ptr(i);
+            for (std::size_t p = 0; p < k; ++p) {
+                const A aip = a[p];
+                const T* b = m.row_ptr(p);
+                for (std::size_t j = 0; j < n; ++j) c[j] += aip * static_cast<A>(b[j]);
             }
-        }
+        });
+        return result;
     }
-    return *result.release();
 }
 
+namespace {
+
+/// @brief Liczba wierszy operandu po operacji `t`
+std::size_t wiersze_op(const matrix& x, trans t) noexcept {
+    return t == trans::none ? x.get_rows() : x.get_cols();
+}
+
+/// @brief Liczba kolumn operandu po operacji `t`
+std::size_t kolumny_op(const matrix& x, trans t) noexcept {
+    return t == trans::none ? x.get_cols() : x.get_rows();
+}
+
+} // namespace
+
 /**
- * @brief Operator dodawania skalara - A + a
- * 
- * Dodaje skalar `a` do każdego elementu macierzy.
- * Zwraca nową macierz tego samego rozmiaru.
- * 
- * @param a skalar do dodania do każdego elementu
- * 
- * @return referencja na nową macierz zawierającą wynik
- * 
- * @post wynikowa macierz[i][j] = this[i][j] + a
- * @complexity O(n × m) gdzie n = rows, m = cols
- * 
- * @example
- * @code
- * matrix A(2, 2, 1.0);  // wszystkie elementy = 1.0
- * matrix B = A + 5;     // wszystkie elementy = 6.0
- * @endcode
+ * @brief Iloczyn zapisywany do istniejącej macierzy - C = op(A) * op(B)
+ *
+ * Jeśli C ma już wymiary wyniku, jego bufor jest używany ponownie;
+ * w przeciwnym razie C jest realokowane (bez zerowania, bo wynik
+ * nadpisuje wszystkie elementy). Gdy C jest przy tym jednym z operandów,
+ * wynik powstaje w nowej macierzy, która zastępuje C po mnożeniu.
+ *
+ * @param C macierz wynikowa
+ * @param A lewy operand
+ * @param B prawy operand
+ * @param ta operacja na A
+ * @param tb operacja na B
+ *
+ * @return referencja na C
+ *
+ * @throw std::runtime_error jeśli wymiary są niezgodne
  */
-matrix& matrix::operator+(int a) {
-    auto result = std::make_unique<matrix>(rows, cols);
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            result->data[i][j] = this->data[i][j] + a;
-        }
+matrix& gemm_into(matrix& C, const matrix& A, const matrix& B, trans ta, trans tb) {
+    const std::size_t m = wiersze_op(A, ta), n = kolumny_op(B, tb);
+    if (C.get_rows() != m || C.get_cols() != n) {
+        matrix wynik(m, n, bez_zerowania);
+        gemm(wynik, A, B, 1.0, 0.0, ta, tb);
+        C = std::move(wynik);
+        return C;
     }
-    return *result.release();
+    gemm(C, A, B, 1.0, 0.0, ta, tb);
+    return C;
 }
 
 /**
- * @brief Operator mnożenia przez skalar - A * a
- * 
- * Mnoży każdy element macierzy przez skalar `a`.
- * Zwraca nową macierz tego samego rozmiaru.
- * 
- * @param a skalar mnożnika
- * 
- * @return referencja na nową macierz zawierającą wynik
- * 
- * @post wynikowa macierz[i][j] = this[i][j] * a
- * @complexity O(n × m) gdzie n = rows, m = cols
- * 
+ * @brief Iloczyn z transponowanym lewym operandem - Aᵀ * B
+ *
+ * Typowe zastosowanie to macierz Grama (mul_tn(A, A)) i równania
+ * normalne w metodzie najmniejszych kwadratów. A jest czytane
+ * kolumnami bezpośrednio z oryginalnego bufora, bez kopii.
+ *
+ * @param A lewy operand (k × m)
+ * @param B prawy operand (k × n)
+ *
+ * @return nowa macierz m × n
+ *
+ * @throw std::runtime_error jeśli A.rows != B.rows
+ *
  * @example
  * @code
- * matrix A(2, 2, 2.0);
- * matrix B = A * 3;  // wszystkie elementy mnożone przez 3
+ * matrix G = mul_tn(X, X);  // XᵀX
  * @endcode
  */
-matrix& matrix::operator*(int a) {
-    auto result = std::make_unique<matrix>(rows, cols);
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            result->data[i][j] = this->data[i][j] * a;
-        }
-    }
-    return *result.release();
+matrix mul_tn(const matrix& A, const matrix& B) {
+    matrix result(A.get_cols(), B.get_cols(), bez_zerowania);
+    gemm(result, A, B, 1.0, 0.0, trans::transpose, trans::none);
+    return result;
 }
 
 /**
- * @brief Operator odejmowania skalara - A - a
- * 
- * Odejmuje skalar `a` od każdego elementu macierzy.
- * Zwraca nową macierz tego samego rozmiaru.
- * 
- * @param a skalar do odjęcia od każdego elementu
- * 
- * @return referencja na nową macierz zawierającą wynik
- * 
- * @post wynikowa macierz[i][j] = this[i][j] - a
- * @complexity O(n × m) gdzie n = rows, m = cols
- * 
- * @example
- * @code
- * matrix A(2, 2, 10.0);
- * matrix B = A - 3;  // wszystkie elementy zmniejszone o 3
- * @endcode
+ * @brief Iloczyn z transponowanym prawym operandem - A * Bᵀ
+ *
+ * Wiersze B są kolumnami Bᵀ, więc każdy element wyniku to iloczyn
+ * skalarny dwóch ciągłych wierszy; B nie jest kopiowane.
+ *
+ * @param A lewy operand (m × k)
+ * @param B prawy operand (n × k)
+ *
+ * @return nowa macierz m × n
+ *
+ * @throw std::runtime_error jeśli A.cols != B.cols
  */
-matrix& matrix::operator-(int a) {
-    auto result = std::make_unique<matrix>(rows, cols);
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            result->data[i][j] = this->data[i][j] - a;
-        }
-    }
-    return *result.release();
+matrix mul_nt(const matrix& A, const matrix& B) {
+    matrix result(A.get_rows(), B.get_rows(), bez_zerowania);
+    gemm(result, A, B, 1.0, 0.0, trans::none, trans::transpose);
+    return result;
 }
 
 /**
- * @brief Friend operator dodawania skalara - a + A
- * 
- * Dodaje skalar `a` do każdego elementu macierzy `m`.
- * Operacja jest przemienna: a + A = A + a
- * 
- * @param a skalar (lewy operand)
- * @param m macierz (prawy operand)
- * 
- * @return nowa macierz zawierająca wynik a + m
- * 
- * @post wynikowa macierz[i][j] = a + m[i][j]
- * @complexity O(n × m) gdzie n = m.rows, m = m.cols
- * 
+ * @brief Mnożenie w konwencji BLAS - C = alpha * op(A) * op(B) + beta * C
+ *
+ * Operandy i wynik są macierzami lub widokami; ich kroki trafiają wprost
+ * do silnika GEMM, więc bloki, zakresy wierszy i kolumn ani transpozycje
+ * nie są kopiowane. Mnożnik alpha jest stosowany przy pakowaniu A, a beta
+ * przez jedno przeskalowanie C przed akumulacją. Silnik wymaga ciągłych wierszy C;
+ * gdy ciągłe są kolumny C (np. C to kolumna macierzy), liczony jest
+ * iloczyn transponowany Cᵀ = op(B)ᵀ * op(A)ᵀ na tych samych buforach.
+ * Tylko wtedy, gdy C może współdzielić elementy z A lub B albo nie ma
+ * żadnego ciągłego wymiaru, wynik powstaje w macierzy tymczasowej.
+ *
+ * @param C fragment wynikowy (op(A).rows × op(B).cols)
+ * @param A lewy operand
+ * @param B prawy operand
+ * @param alpha mnożnik iloczynu
+ * @param beta mnożnik dotychczasowej zawartości C (0 - nadpisanie)
+ * @param ta operacja na A
+ * @param tb operacja na B
+ *
+ * @throw std::runtime_error jeśli wymiary są niezgodne
+ *
+ * @complexity O(m × n × k)
+ *
  * @example
  * @code
- * matrix A(2, 2, 1.0);
- * matrix B = 5 + A;  // równoważne A + 5
+ * matrix C(A.get_rows(), B.get_cols());
+ * for (int it = 0; it < 1000; ++it) {
+ *     gemm(C, A, B, 1.0, 0.5);  // C = A*B + 0.5*C, bez alokacji
+ * }
+ *
+ * // C = A * B liczone blokami wierszy, bez kopiowania bloków
+ * for (std::size_t i = 0; i < m; i += 256) {
+ *     const std::size_t h = std::min<std::size_t>(256, m - i);
+ *     gemm(C.row_block(i, h), A.row_block(i, h), B);
+ * }
  * @endcode
  */
-matrix operator+(int a, matrix& m) {
-    matrix result(m.rows, m.cols);
-    for(int i = 0; i < m.rows; i++) {
-        for(int j = 0; j < m.cols; j++) {
-            result.data[i][j] = a + m.data[i][j];
-        }
+void gemm(matrix_view C, const_matrix_view A, const_matrix_view B, double alpha, double beta,
+          trans ta, trans tb) {
+    const bool ta_t = ta == trans::transpose, tb_t = tb == trans::transpose;
+    const std::size_t m = ta_t ? A.get_cols() : A.get_rows();
+    const std::size_t k = ta_t ? A.get_rows() : A.get_cols();
+    const std::size_t n = tb_t ? B.get_rows() : B.get_cols();
+    if ((tb_t ? B.get_cols() : B.get_rows()) != k)
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    if (C.get_rows() != m || C.get_cols() != n)
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy wynikowej");
+
+    const bool bezposrednio = C.contiguous_rows() || C.row_stride() == 1 || m <= 1;
+    if (!bezposrednio || detail::moga_sie_nakladac<double>(C, A) || detail::moga_sie_nakladac<double>(C, B)) {
+        matrix tmp(m, n, bez_zerowania);
+        if (beta != 0.0) tmp.view() = C;
+        gemm(tmp, A, B, alpha, beta, ta, tb);
+        C = tmp;
+        return;
     }
+
+    const std::ptrdiff_t rsa = ta_t ? A.col_stride() : A.row_stride();
+    const std::ptrdiff_t csa = ta_t ? A.row_stride() : A.col_stride();
+    const std::ptrdiff_t rsb = tb_t ? B.col_stride() : B.row_stride();
+    const std::ptrdiff_t csb = tb_t ? B.row_stride() : B.col_stride();
+    if (C.contiguous_rows()) {
+        detail::gemm(m, n, k, alpha, A.data(), rsa, csa, B.data(), rsb, csb,
+                     beta, C.data(), C.row_stride());
+    } else {
+        detail::gemm(n, m, k, alpha, B.data(), csb, rsb, A.data(), csa, rsa,
+                     beta, C.data(), C.col_stride());
+    }
+}
+
+/**
+ * @brief Iloczyn fragmentów macierzy - A * B
+ *
+ * @param A lewy operand (np. blok, zakres wierszy lub kolumn)
+ * @param B prawy operand
+ *
+ * @return nowa macierz A.rows × B.cols
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ */
+matrix operator*(const_matrix_view A, const_matrix_view B) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    matrix result(A.get_rows(), B.get_cols(), bez_zerowania);
+    gemm(result, A, B);
     return result;
 }
 
 /**
- * @brief Friend operator mnożenia skalara - a * A
- * 
- * Mnoży każdy element macierzy `m` przez skalar `a`.
- * Operacja jest przemienna: a * A = A * a
- * 
- * @param a skalar (lewy operand)
- * @param m macierz (prawy operand)
- * 
- * @return nowa macierz zawierająca wynik a * m
- * 
- * @post wynikowa macierz[i][j] = a * m[i][j]
- * @complexity O(n × m) gdzie n = m.rows, m = m.cols
- * 
- * @example
- * @code
- * matrix A(2, 2, 2.0);
- * matrix B = 3 * A;  // równoważne A * 3
- * @endcode
+ * @brief Porównanie fragmentów macierzy element po elemencie
+ *
+ * Wiersze ciągłe porównuje jądro SIMD, pozostałe - zwykła pętla.
+ * Dwa fragmenty o ciągłych kolumnach (np. A.transpose() == B.transpose())
+ * są porównywane jako ich transpozycje, czyli też wierszami ciągłymi.
+ *
+ * @param A pierwszy fragment
+ * @param B drugi fragment
+ *
+ * @return prawda, jeśli wymiary i wszystkie elementy są równe
  */
-matrix operator*(int a, matrix& m) {
-    matrix result(m.rows, m.cols);
-    for(int i = 0; i < m.rows; i++) {
-        for(int j = 0; j < m.cols; j++) {
-            result.data[i][j] = a * m.data[i][j];
-        }
+bool operator==(const_matrix_view A, const_matrix_view B) {
+    if (A.get_rows() != B.get_rows() || A.get_cols() != B.get_cols()) return false;
+    if (!(A.contiguous_rows() && B.contiguous_rows()) && A.contiguous_cols() && B.contiguous_cols()) {
+        A = A.transpose();
+        B = B.transpose();
     }
-    return result;
+    const std::size_t cols = A.get_cols();
+    const auto& k = detail::kernels();
+    const bool ciagle = A.contiguous_rows() && B.contiguous_rows();
+    return dla_wszystkich_wierszy(A.get_rows(), cols, [&](std::size_t i) {
+        if (ciagle) return k.all_eq(cols, A.row_ptr(i), B.row_ptr(i));
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (!(A(i, j) == B(i, j))) return false;
+        }
+        return true;
+    });
+}
+
+namespace {
+
+/// @brief Prog przejscia Strassena (zob. set_strassen_crossover())
+std::atomic<std::size_t> prog_strassena{512};
+
+} // namespace
+
+void set_strassen_crossover(std::size_t n) noexcept {
+    prog_strassena.store(n ? n : 1, std::memory_order_relaxed);
+}
+
+std::size_t get_strassen_crossover() noexcept {
+    return prog_strassena.load(std::memory_order_relaxed);
 }
 
 /**
- * @brief Friend operator odejmowania skalara - a - A
- * 
- * Odejmuje każdy element macierzy `m` od skalara `a`.
- * Operacja nie jest przemienna: a - A ≠ A - a
- * 
- * @param a skalar (lewy operand)
- * @param m macierz (prawy operand)
- * 
- * @return nowa macierz zawierająca wynik a - m
- * 
- * @post wynikowa macierz[i][j] = a - m[i][j]
- * @complexity O(n × m) gdzie n = m.rows, m = m.cols
- * 
+ * @brief Iloczyn A * B wybranym algorytmem
+ *
+ * mul_algo::classic to zwykłe A * B. mul_algo::strassen uruchamia
+ * rekurencję Strassena-Winograda (detail::gemm_strassen()) aż do progu
+ * get_strassen_crossover(); dla mniejszych macierzy wynik jest identyczny
+ * z klasycznym. mul_algo::automatic wybiera Strassena tylko wtedy, gdy
+ * rekurencja wykona co najmniej dwa poziomy, tzn. każdy z wymiarów
+ * m, n, k jest co najmniej czterokrotnością progu. Pojedynczy poziom
+ * oszczędza najwyżej 1/8 mnożeń, co w pomiarach (AVX-512, n = 2048)
+ * ginie w koszcie dodawań ćwiartek; przy n = 4096 i progu 512
+ * Strassen jest o ok. 30% szybszy.
+ *
+ * @param A lewy operand
+ * @param B prawy operand
+ * @param algo algorytm
+ *
+ * @return nowa macierz z iloczynem
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ *
  * @example
  * @code
- * matrix A(2, 2, 1.0);
- * matrix B = 10 - A;  // każdy element = 10 - A[i][j]
+ * set_strassen_crossover(256);
+ * matrix C = multiply(A, B, mul_algo::strassen);
  * @endcode
  */
-matrix operator-(int a, matrix& m) {
-    matrix result(m.rows, m.cols);
-    for(int i = 0; i < m.rows; i++) {
-        for(int j = 0; j < m.cols; j++) {
-            result.data[i][j] = a - m.data[i][j];
-        }
+matrix multiply(const matrix& A, const matrix& B, mul_algo algo) {
+    const std::size_t m = A.get_rows(), k = A.get_cols(), n = B.get_cols();
+    const std::size_t prog = get_strassen_crossover();
+    if (algo == mul_algo::automatic) {
+        algo = std::min({m, n, k}) >= 4 * prog ? mul_algo::strassen : mul_algo::classic;
+    }
+    if (algo == mul_algo::classic) {
+        return A * B;
     }
+    if (k != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    matrix result(m, n, bez_zerowania);
+    detail::gemm_strassen(m, n, k,
+                          A.data.get(), A.get_stride(),
+                          B.data.get(), B.get_stride(),
+                          result.data.get(), result.get_stride(), prog);
     return result;
 }
 
@@ -285,11 +503,15 @@ matrix operator-(int a, matrix& m) {
  * A++;  // wszystkie elementy = 2.0
  * @endcode
  */
-matrix& matrix::operator++(int) {
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            this->data[i][j]++;
-        }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator++(int) {
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        dla_wierszy(rows, cols, [&](std::size_t i) {
+            k.add_scalar(cols, row_ptr(i), 1.0, row_ptr(i));
+        });
+    } else {
+        dla_elementow<T>(*this, nullptr, [](T& x, T) { x += T(1); });
     }
     return *this;
 }
@@ -314,11 +536,15 @@ matrix& matrix::operator++(int) {
  * A--;  // wszystkie elementy = 4.0
  * @endcode
  */
-matrix& matrix::operator--(int) {
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            this->data[i][j]--;
-        }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator--(int) {
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        dla_wierszy(rows, cols, [&](std::size_t i) {
+            k.add_scalar(cols, row_ptr(i), -1.0, row_ptr(i));
+        });
+    } else {
+        dla_elementow<T>(*this, nullptr, [](T& x, T) { x -= T(1); });
     }
     return *this;
 }
@@ -342,11 +568,15 @@ matrix& matrix::operator--(int) {
  * A += 5;  // wszystkie elementy = 6.0
  * @endcode
  */
-matrix& matrix::operator+=(int a) {
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            this->data[i][j] += a;
-        }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator+=(T a) {
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        dla_wierszy(rows, cols, [&](std::size_t i) {
+            k.add_scalar(cols, row_ptr(i), a, row_ptr(i));
+        });
+    } else {
+        dla_elementow<T>(*this, nullptr, [a](T& x, T) { x += a; });
     }
     return *this;
 }
@@ -370,11 +600,15 @@ matrix& matrix::operator+=(int a) {
  * A -= 3;  // wszystkie elementy = 7.0
  * @endcode
  */
-matrix& matrix::operator-=(int a) {
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            this->data[i][j] -= a;
-        }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator-=(T a) {
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        dla_wierszy(rows, cols, [&](std::size_t i) {
+            k.add_scalar(cols, row_ptr(i), -a, row_ptr(i));
+        });
+    } else {
+        dla_elementow<T>(*this, nullptr, [a](T& x, T) { x -= a; });
     }
     return *this;
 }
@@ -398,11 +632,15 @@ matrix& matrix::operator-=(int a) {
  * A *= 3;  // wszystkie elementy = 6.0
  * @endcode
  */
-matrix& matrix::operator*=(int a) {
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            this->data[i][j] *= a;
-        }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator*=(T a) {
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        dla_wierszy(rows, cols, [&](std::size_t i) {
+            k.mul_scalar(cols, row_ptr(i), a, row_ptr(i));
+        });
+    } else {
+        dla_elementow<T>(*this, nullptr, [a](T& x, T) { x *= a; });
     }
     return *this;
 }
@@ -429,14 +667,10 @@ matrix& matrix::operator*=(int a) {
  * 
  * @note Część ułamkowa (0.7) jest ignorowana
  */
-matrix& matrix::operator()(double value) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator()(double value) {
     int intPart = static_cast<int>(value);
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            this->data[i][j] += intPart;
-        }
-    }
-    return *this;
+    return *this += static_cast<T>(intPart);
 }
 
 /**
@@ -463,11 +697,15 @@ matrix& matrix::operator()(double value) {
  * // 1 2 3
  * // 4 5 6
  * @endcode
+ *
+ * @note Elementy są wypisywane z promocją całkowitoliczbową (`+m(i, j)`),
+ *       dzięki czemu matrix_i8 wypisuje liczby, a nie znaki.
  */
-ostream& operator<<(ostream& o, matrix& m) {
+template <typename T>
+ostream& operator<<(ostream& o, const basic_matrix<T>& m) {
     for(int i = 0; i < m.rows; i++) {
         for(int j = 0; j < m.cols; j++) {
-            o << m.data[i][j];
+            o << +m(i, j);
             if(j < m.cols - 1) o << " ";
         }
         o << endl;
@@ -500,14 +738,17 @@ ostream& operator<<(ostream& o, matrix& m) {
  * 
  * @note Użyteczne do porównywania macierzy o pełnych danych
  */
-bool matrix::operator==(const matrix& m) {
+template <typename T>
+bool basic_matrix<T>::operator==(const basic_matrix& m) const {
     if(rows != m.rows || cols != m.cols) return false;
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            if(this->data[i][j] != m.data[i][j]) return false;
-        }
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        return dla_wszystkich_wierszy(rows, cols, [&](std::size_t i) {
+            return k.all_eq(cols, row_ptr(i), m.row_ptr(i));
+        });
+    } else {
+        return dla_wszystkich_elementow(*this, m, [](T x, T y) { return x == y; });
     }
-    return true;
 }
 
 /**
@@ -538,14 +779,17 @@ bool matrix::operator==(const matrix& m) {
  * 
  * @note Wymaga, aby KAŻDY element spełniał warunek (semantyka ALL)
  */
-bool matrix::operator>(const matrix& m) {
+template <typename T>
+bool basic_matrix<T>::operator>(const basic_matrix& m) const {
     if(rows != m.rows || cols != m.cols) return false;
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            if(this->data[i][j] <= m.data[i][j]) return false;
-        }
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        return dla_wszystkich_wierszy(rows, cols, [&](std::size_t i) {
+            return k.all_gt(cols, row_ptr(i), m.row_ptr(i));
+        });
+    } else {
+        return dla_wszystkich_elementow(*this, m, [](T x, T y) { return x > y; });
     }
-    return true;
 }
 
 /**
@@ -576,12 +820,37 @@ bool matrix::operator>(const matrix& m) {
  * 
  * @note Wymaga, aby KAŻDY element spełniał warunek (semantyka ALL)
  */
-bool matrix::operator<(const matrix& m) {
+template <typename T>
+bool basic_matrix<T>::operator<(const basic_matrix& m) const {
     if(rows != m.rows || cols != m.cols) return false;
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            if(this->data[i][j] >= m.data[i][j]) return false;
-        }
+    if constexpr (ma_jadra_v<T>) {
+        const auto& k = detail::kernels();
+        return dla_wszystkich_wierszy(rows, cols, [&](std::size_t i) {
+            return k.all_lt(cols, row_ptr(i), m.row_ptr(i));
+        });
+    } else {
+        return dla_wszystkich_elementow(*this, m, [](T x, T y) { return x < y; });
     }
-    return true;
-}
\ No newline at end of file
+}
+
+// Jawne konkretyzacje składowych zdefiniowanych w tym pliku
+#define MATRIX_KONKRETYZUJ_OPERATORY(T)                                                     \
+    template basic_matrix<T>& basic_matrix<T>::operator+=(const basic_matrix<T>&);          \
+    template basic_matrix<T>& basic_matrix<T>::operator-=(const basic_matrix<T>&);          \
+    template basic_matrix<akumulator_t<T>> basic_matrix<T>::operator*(const basic_matrix<T>&) const; \
+    template basic_matrix<T>& basic_matrix<T>::operator++(int);                             \
+    template basic_matrix<T>& basic_matrix<T>::operator--(int);                             \
+    template basic_matrix<T>& basic_matrix<T>::operator+=(T);                               \
+    template basic_matrix<T>& basic_matrix<T>::operator-=(T);                               \
+    template basic_matrix<T>& basic_matrix<T>::operator*=(T);                               \
+    template basic_matrix<T>& basic_matrix<T>::operator()(double);                          \
+    template bool basic_matrix<T>::operator==(const basic_matrix<T>&) const;                \
+    template bool basic_matrix<T>::operator>(const basic_matrix<T>&) const;                 \
+    template bool basic_matrix<T>::operator<(const basic_matrix<T>&) const;                 \
+    template ostream& operator<<(ostream&, const basic_matrix<T>&);
+
+MATRIX_KONKRETYZUJ_OPERATORY(double)
+MATRIX_KONKRETYZUJ_OPERATORY(float)
+MATRIX_KONKRETYZUJ_OPERATORY(std::int8_t)
+MATRIX_KONKRETYZUJ_OPERATORY(std::int32_t)
+MATRIX_KONKRETYZUJ_OPERATORY(std::int64_t)
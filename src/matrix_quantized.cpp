@@ -0,0 +1,265 @@
+#include "../include/quantized_matrix.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace detail {
+
+namespace {
+
+/// @brief Liczba wierszy A pakowanych naraz przez jeden watek
+constexpr std::size_t i8_mc = 32;
+
+/// @brief Liczba par wspolnego wymiaru w bloku B (blok i8_kp x i8_nc int32 miesci sie w L2)
+constexpr std::size_t i8_kp = 128;
+
+/// @brief Liczba kolumn w bloku B
+constexpr std::size_t i8_nc = 256;
+
+/// @brief Dwa elementy int8 jako para int16 w jednym int32 (a0 - mlodsza polowa)
+inline std::int32_t para(std::int8_t a0, std::int8_t a1) noexcept {
+    const std::uint32_t lo = static_cast<std::uint16_t>(a0);
+    const std::uint32_t hi = static_cast<std::uint16_t>(a1);
+    return static_cast<std::int32_t>(lo | hi << 16);
+}
+
+} // namespace
+
+/**
+ * @brief Mnożenie macierzy int8 z akumulacją w int32: C = A * B
+ *
+ * B jest pakowane raz, do par (B[2q][j], B[2q+1][j]) rozszerzonych do int16,
+ * a wiersze A - do par (A[i][2q], A[i][2q+1]) w jednym int32. Jądro
+ * simd_kernels::gemm_i8 mnoży wtedy pary instrukcją PMADDWD i sumuje
+ * od razu do int32, używając każdego odczytu B dla simd_i8_mr wierszy A.
+ * Każdy wątek liczy swój zakres wierszy blokami i8_mc × i8_nc, przechodząc
+ * po wspólnym wymiarze blokami i8_kp par, więc blok B jest czytany z L2
+ * przez kolejne wiersze A.
+ *
+ * Przy nieparzystym k ostatnia para jest dopełniona zerem.
+ *
+ * @complexity O(m × n × k)
+ */
+void gemm_i8(std::size_t m, std::size_t n, std::size_t k,
+             const std::int8_t* a, std::ptrdiff_t rsa,
+             const std::int8_t* b, std::ptrdiff_t rsb,
+             std::int32_t* c, std::ptrdiff_t rsc) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+    const std::size_t kp = (k + 1) / 2;
+    const std::size_t ldb = 2 * n;
+
+    thread_local std::vector<std::int16_t> pakiet_b;
+    if (pakiet_b.size() < kp * ldb) pakiet_b.resize(kp * ldb);
+    std::int16_t* pb = pakiet_b.data();
+    thread_pool::instance().parallel_rows(kp, ldb, [&](std::size_t q0, std::size_t q1) {
+        for (std::size_t q = q0; q < q1; ++q) {
+            const std::int8_t* b0 = b + static_cast<std::ptrdiff_t>(2 * q) * rsb;
+            const std::int8_t* b1 = 2 * q + 1 < k ? b0 + rsb : nullptr;
+            std::int16_t* w = pb + q * ldb;
+            for (std::size_t j = 0; j < n; ++j) {
+                w[2 * j] = b0[j];
+                w[2 * j + 1] = b1 ? b1[j] : 0;
+            }
+        }
+    });
+
+    const auto& jadra = kernels();
+    thread_pool::instance().parallel_rows(m, n * k, [&](std::size_t r0, std::size_t r1) {
+        thread_local std::vector<std::int32_t> pakiet_a;
+        if (pakiet_a.size() < i8_mc * kp) pakiet_a.resize(i8_mc * kp);
+        std::int32_t* pa = pakiet_a.data();
+
+        for (std::size_t i0 = r0; i0 < r1; i0 += i8_mc) {
+            const std::size_t mb = std::min(i8_mc, r1 - i0);
+            for (std::size_t i = 0; i < mb; ++i) {
+                const std::int8_t* wiersz = a + static_cast<std::ptrdiff_t>(i0 + i) * rsa;
+                std::int32_t* w = pa + i * kp;
+                for (std::size_t q = 0; q < kp; ++q) {
+                    w[q] = para(wiersz[2 * q], 2 * q + 1 < k ? wiersz[2 * q + 1] : std::int8_t{0});
+                }
+                std::fill_n(c + static_cast<std::ptrdiff_t>(i0 + i) * rsc, n, 0);
+            }
+            for (std::size_t jc = 0; jc < n; jc += i8_nc) {
+                const std::size_t nb = std::min(i8_nc, n - jc);
+                for (std::size_t pc = 0; pc < kp; pc += i8_kp) {
+                    const std::size_t kb = std::min(i8_kp, kp - pc);
+                    for (std::size_t i = 0; i < mb; i += simd_i8_mr) {
+                        jadra.gemm_i8(std::min(simd_i8_mr, mb - i), kb, nb,
+                                      pa + i * kp + pc, kp, pb + pc * ldb + 2 * jc, ldb,
+                                      c + static_cast<std::ptrdiff_t>(i0 + i) * rsc + jc, rsc);
+                    }
+                }
+            }
+        }
+    });
+}
+
+} // namespace detail
+
+namespace {
+
+/// @brief Najwiekszy modul wartosci skwantowanej (zakres symetryczny)
+constexpr double q_max = 127.0;
+
+/// @brief Skala dla wartosci o najwiekszym module `maks`
+double skala_dla(double maks) noexcept {
+    return maks > 0.0 ? maks / q_max : 1.0;
+}
+
+/// @brief round(x / s) obciete do [-127, 127]
+std::int8_t kwantyzuj(double x, double odwrotnosc) noexcept {
+    const double v = std::clamp(x * odwrotnosc, -q_max, q_max);
+    return static_cast<std::int8_t>(std::lround(v));
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor z gotowych wartości i skal
+ *
+ * @throw std::runtime_error jeśli liczba skal nie odpowiada liczbie
+ *        wierszy (per_row) lub kolumn (per_col)
+ */
+quantized_matrix::quantized_matrix(matrix_i8 q, std::vector<double> s, quant_axis o)
+    : wartosci(std::move(q)), skale(std::move(s)), os(o) {
+    const std::size_t oczekiwane = os == quant_axis::per_row ? wartosci.get_rows() : wartosci.get_cols();
+    if (skale.size() != oczekiwane)
+        throw std::runtime_error("Liczba skal nie odpowiada wymiarom macierzy");
+}
+
+/**
+ * @brief Kwantyzacja symetryczna macierzy do int8
+ *
+ * Skala wiersza (kolumny) to największy moduł jego elementów podzielony
+ * przez 127, więc zakres [-127, 127] jest wykorzystany w całości,
+ * a zero przechodzi dokładnie na zero. Wartość -128 nie jest używana,
+ * dzięki czemu zakres jest symetryczny.
+ *
+ * @param m macierz źródłowa
+ * @param os wymiar skal
+ *
+ * @return macierz skwantowana
+ *
+ * @complexity O(n × m)
+ *
+ * @example
+ * @code
+ * quantized_matrix qX = quantize(X, quant_axis::per_row);
+ * quantized_matrix qW = quantize(W, quant_axis::per_col);
+ * matrix Y = qX * qW;  // ≈ X * W
+ * @endcode
+ */
+quantized_matrix quantize(const matrix& m, quant_axis os) {
+    const std::size_t rows = m.get_rows(), cols = m.get_cols();
+    matrix_i8 q(rows, cols, bez_zerowania);
+    std::vector<double> skale;
+
+    if (os == quant_axis::per_row) {
+        skale.resize(rows);
+        thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+            for (std::size_t i = r0; i < r1; ++i) {
+                const double* x = m.row_ptr(i);
+                double maks = 0.0;
+                for (std::size_t j = 0; j < cols; ++j) maks = std::max(maks, std::fabs(x[j]));
+                skale[i] = skala_dla(maks);
+                const double odwrotnosc = 1.0 / skale[i];
+                std::int8_t* w = q.row_ptr(i);
+                for (std::size_t j = 0; j < cols; ++j) w[j] = kwantyzuj(x[j], odwrotnosc);
+            }
+        });
+    } else {
+        std::vector<double> maks(cols, 0.0);
+        for (std::size_t i = 0; i < rows; ++i) {
+            const double* x = m.row_ptr(i);
+            for (std::size_t j = 0; j < cols; ++j) maks[j] = std::max(maks[j], std::fabs(x[j]));
+        }
+        skale.resize(cols);
+        std::vector<double> odwrotnosci(cols);
+        for (std::size_t j = 0; j < cols; ++j) {
+            skale[j] = skala_dla(maks[j]);
+            odwrotnosci[j] = 1.0 / skale[j];
+        }
+        thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+            for (std::size_t i = r0; i < r1; ++i) {
+                const double* x = m.row_ptr(i);
+                std::int8_t* w = q.row_ptr(i);
+                for (std::size_t j = 0; j < cols; ++j) w[j] = kwantyzuj(x[j], odwrotnosci[j]);
+            }
+        });
+    }
+    return quantized_matrix(std::move(q), std::move(skale), os);
+}
+
+/**
+ * @brief Odtwarza macierz double z wartości skwantowanych
+ *
+ * @param q macierz skwantowana
+ *
+ * @return macierz z elementami q(i, j) · skala
+ *
+ * @complexity O(n × m)
+ */
+matrix dequantize(const quantized_matrix& q) {
+    const std::size_t rows = q.get_rows(), cols = q.get_cols();
+    const std::vector<double>& skale = q.scales();
+    const bool wierszami = q.axis() == quant_axis::per_row;
+    matrix wynik(rows, cols, bez_zerowania);
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const std::int8_t* x = q.values().row_ptr(i);
+            double* w = wynik.row_ptr(i);
+            if (wierszami) {
+                for (std::size_t j = 0; j < cols; ++j) w[j] = x[j] * skale[i];
+            } else {
+                for (std::size_t j = 0; j < cols; ++j) w[j] = x[j] * skale[j];
+            }
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn macierzy skwantowanych - A * B
+ *
+ * Część całkowitoliczbowa liczona jest przez detail::gemm_i8() (int8 × int8
+ * z akumulacją int32, czyli dokładnie), a skale wiersza A i kolumny B
+ * mnożone są dopiero przez gotową sumę. Operandy zajmują 8 razy mniej
+ * pamięci niż macierze double, więc w cache mieszczą się 8 razy większe
+ * bloki. Błąd wyniku wynika wyłącznie z kwantyzacji operandów.
+ *
+ * @param A lewy operand (quant_axis::per_row)
+ * @param B prawy operand (quant_axis::per_col)
+ *
+ * @return macierz double A.rows × B.cols
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ * @throw std::runtime_error jeśli A nie ma skal wierszy lub B skal kolumn
+ *
+ * @complexity O(n × m × p)
+ */
+matrix operator*(const quantized_matrix& A, const quantized_matrix& B) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    if (A.axis() != quant_axis::per_row || B.axis() != quant_axis::per_col)
+        throw std::runtime_error("Mnożenie skwantowane wymaga skal wierszy A i skal kolumn B");
+
+    const std::size_t rows = A.get_rows(), cols = B.get_cols();
+    const matrix_i32 suma = A.values() * B.values();
+    const std::vector<double>& sa = A.scales();
+    const std::vector<double>& sb = B.scales();
+    matrix wynik(rows, cols, bez_zerowania);
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const std::int32_t* s = suma.row_ptr(i);
+            double* w = wynik.row_ptr(i);
+            for (std::size_t j = 0; j < cols; ++j) w[j] = sa[i] * sb[j] * s[j];
+        }
+    });
+    return wynik;
+}
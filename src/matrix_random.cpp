@@ -0,0 +1,317 @@
+#include "../include/counter_rng.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/// @brief Liczba blokow generowanych naraz przez jeden watek (1024 elementy, 8 KiB)
+constexpr std::size_t paczka_blokow = 512;
+
+/// @brief 2^-53 - krok liczb double z [0, 1) zbudowanych z 53 bitow
+constexpr double dwa_do_minus_53 = 1.0 / 9007199254740992.0;
+
+/**
+ * @brief Wypełnia macierz liczbami wyliczanymi z kolejnych bloków generatora
+ *
+ * Wiersze są dzielone między wątki puli; każdy wątek generuje swój zakres
+ * elementów paczkami po paczka_blokow bloków (jądro Philox SIMD), zamienia
+ * je na wartości funkcją `przeksztalc(u, bloki, w)` (2 wartości na blok)
+ * i kopiuje odcinkami wierszy. Element nr k = i · cols + j zawsze pochodzi
+ * z bloku position() + k / 2, więc podział na wątki nie wpływa na wynik.
+ */
+template <typename T, typename F>
+void wypelnij(basic_matrix<T>& m, philox_rng& g, F przeksztalc) {
+    const std::size_t rows = m.get_rows(), cols = m.get_cols();
+    const std::uint64_t poczatek = g.position(), strumien = g.stream(), klucz = g.seed();
+    const auto& k = detail::kernels();
+
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        thread_local std::vector<std::uint64_t> losowe;
+        thread_local std::vector<T> wartosci;
+        losowe.resize(2 * paczka_blokow);
+        wartosci.resize(2 * paczka_blokow);
+
+        std::size_t e = r0 * cols;
+        const std::size_t koniec = r1 * cols;
+        std::size_t i = r0, j = 0;
+        while (e < koniec) {
+            const std::size_t b0 = e / 2;
+            const std::size_t e1 = std::min(koniec, 2 * (b0 + paczka_blokow));
+            const std::size_t bloki = (e1 + 1) / 2 - b0;
+            k.philox(bloki, poczatek + b0, strumien, klucz, losowe.data());
+            przeksztalc(losowe.data(), bloki, wartosci.data());
+
+            // Odcinki wierszy [j, j + n) z wartosci od pozycji e - 2 * b0
+            while (e < e1) {
+                const std::size_t n = std::min(e1 - e, cols - j);
+                std::memcpy(m.row_ptr(i) + j, wartosci.data() + (e - 2 * b0), n * sizeof(T));
+                e += n;
+                j += n;
+                if (j == cols) {
+                    j = 0;
+                    ++i;
+                }
+            }
+        }
+    });
+    g.discard((static_cast<std::uint64_t>(rows) * cols + 1) / 2);
+}
+
+/// @brief Wspolny generator dla losuj(); ziarno z std::random_device przy pierwszym uzyciu
+struct wspolny_generator {
+    std::mutex blokada;
+    philox_rng g{(static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}()};
+};
+
+wspolny_generator& wspolny() {
+    static wspolny_generator w;
+    return w;
+}
+
+/**
+ * @brief Rezerwuje `bloki` bloków wspólnego generatora
+ *
+ * Zwraca kopię generatora ustawioną na początku zarezerwowanego fragmentu;
+ * blokada jest trzymana tylko na czas przesunięcia pozycji, więc równoległe
+ * wywołania losuj() dostają rozłączne fragmenty ciągu.
+ */
+philox_rng zarezerwuj(std::uint64_t bloki) {
+    auto& w = wspolny();
+    std::lock_guard<std::mutex> lock(w.blokada);
+    philox_rng kopia = w.g;
+    w.g.discard(bloki);
+    return kopia;
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca następny blok generatora (cztery słowa 32-bitowe)
+ *
+ * @return słowa w0..w3 bloku position(); generator przesuwa się o 1
+ */
+std::array<std::uint32_t, 4> philox_rng::operator()() noexcept {
+    std::uint64_t u[2];
+    generate(u, 1);
+    return {static_cast<std::uint32_t>(u[0]), static_cast<std::uint32_t>(u[0] >> 32),
+            static_cast<std::uint32_t>(u[1]), static_cast<std::uint32_t>(u[1] >> 32)};
+}
+
+/**
+ * @brief Generuje n kolejnych bloków jądrem Philox wybranym dla procesora
+ *
+ * Wynik nie zależy od ISA: SSE2, AVX2 i AVX-512 liczą 4, 8 i 16 bloków
+ * naraz dokładnie tą samą funkcją co wariant skalarny.
+ *
+ * @param out bufor na 2n liczb 64-bitowych
+ * @param n liczba bloków
+ */
+void philox_rng::generate(std::uint64_t* out, std::size_t n) noexcept {
+    detail::kernels().philox(n, pozycja, strumien, klucz, out);
+    pozycja += n;
+}
+
+/**
+ * @brief Wypełnia macierz liczbami o rozkładzie jednostajnym na [lo, hi)
+ *
+ * Każda liczba 64-bitowa daje 53 bity mantysy: u = (x >> 11) · 2⁻⁵³.
+ *
+ * @param m macierz wypełniana
+ * @param g generator (przesuwany o ⌈rows · cols / 2⌉ bloków)
+ * @param lo dolna granica
+ * @param hi górna granica
+ *
+ * @return referencja na m
+ *
+ * @example
+ * @code
+ * philox_rng g(42);
+ * matrix a(1000, 1000);
+ * fill_uniform(a, g, -1.0, 1.0);  // ten sam wynik przy każdej liczbie wątków
+ * @endcode
+ */
+template <typename T>
+basic_matrix<T>& fill_uniform(basic_matrix<T>& m, philox_rng& g, double lo, double hi) {
+    const double skala = (hi - lo) * dwa_do_minus_53;
+    wypelnij(m, g, [=](const std::uint64_t* u, std::size_t bloki, T* w) {
+        for (std::size_t t = 0; t < 2 * bloki; ++t) {
+            w[t] = static_cast<T>(lo + static_cast<double>(u[t] >> 11) * skala);
+        }
+    });
+    return m;
+}
+
+/**
+ * @brief Wypełnia macierz liczbami o rozkładzie normalnym N(mean, stddev²)
+ *
+ * Metoda Boxa-Mullera: z bloku (x₀, x₁) powstają u₁ ∈ (0, 1] i u₂ ∈ [0, 1),
+ * a para elementów 2b, 2b + 1 dostaje r · cos(2πu₂) i r · sin(2πu₂),
+ * gdzie r = √(−2 ln u₁). Generowanie bloków jest wektorowe, funkcje
+ * log / sin / cos liczone są skalarnie.
+ *
+ * @param m macierz wypełniana
+ * @param g generator (przesuwany o ⌈rows · cols / 2⌉ bloków)
+ * @param mean wartość oczekiwana
+ * @param stddev odchylenie standardowe
+ *
+ * @return referencja na m
+ */
+template <typename T>
+basic_matrix<T>& fill_normal(basic_matrix<T>& m, philox_rng& g, double mean, double stddev) {
+    constexpr double dwa_pi = 6.283185307179586476925286766559;
+    wypelnij(m, g, [=](const std::uint64_t* u, std::size_t bloki, T* w) {
+        for (std::size_t b = 0; b < bloki; ++b) {
+            const double u1 = static_cast<double>((u[2 * b] >> 11) + 1) * dwa_do_minus_53;
+            const double u2 = static_cast<double>(u[2 * b + 1] >> 11) * dwa_do_minus_53;
+            const double r = stddev * std::sqrt(-2.0 * std::log(u1));
+            w[2 * b] = static_cast<T>(mean + r * std::cos(dwa_pi * u2));
+            w[2 * b + 1] = static_cast<T>(mean + r * std::sin(dwa_pi * u2));
+        }
+    });
+    return m;
+}
+
+/**
+ * @brief Wypełnia macierz liczbami całkowitymi z [lo, hi]
+ *
+ * Zakres z = hi − lo + 1 jest mapowany mnożeniem 64 × 64 → 128 bitów:
+ * wartość = lo + ⌊x · z / 2⁶⁴⌋, bez dzielenia modulo. Pełny zakres
+ * int64 (z = 2⁶⁴) przepisuje x bez zmian.
+ *
+ * @param m macierz wypełniana
+ * @param g generator (przesuwany o ⌈rows · cols / 2⌉ bloków)
+ * @param lo najmniejsza wartość
+ * @param hi największa wartość
+ *
+ * @return referencja na m
+ *
+ * @throw std::runtime_error jeśli lo > hi lub zakres nie mieści się w typie T
+ */
+template <typename T>
+basic_matrix<T>& fill_integers(basic_matrix<T>& m, philox_rng& g, std::int64_t lo, std::int64_t hi) {
+    if (lo > hi) {
+        throw std::runtime_error("Pusty zakres liczb losowych");
+    }
+    if constexpr (std::is_integral_v<T>) {
+        if (lo < static_cast<std::int64_t>(std::numeric_limits<T>::min()) ||
+            hi > static_cast<std::int64_t>(std::numeric_limits<T>::max())) {
+            throw std::runtime_error("Zakres liczb losowych nie mieści się w typie elementu");
+        }
+    }
+    const std::uint64_t z = static_cast<std::uint64_t>(hi) - static_cast<std::uint64_t>(lo) + 1;
+    const std::uint64_t baza = static_cast<std::uint64_t>(lo);
+    wypelnij(m, g, [=](const std::uint64_t* u, std::size_t bloki, T* w) {
+        for (std::size_t t = 0; t < 2 * bloki; ++t) {
+            const std::uint64_t x = z ? static_cast<std::uint64_t>((static_cast<unsigned __int128>(u[t]) * z) >> 64)
+                                      : u[t];
+            w[t] = static_cast<T>(static_cast<std::int64_t>(baza + x));
+        }
+    });
+    return m;
+}
+
+/**
+ * @brief Ustawia ziarno wspólnego generatora losuj() i cofa go na pozycję 0
+ *
+ * @param seed ziarno
+ */
+void seed_random(std::uint64_t seed) noexcept {
+    auto& w = wspolny();
+    std::lock_guard<std::mutex> lock(w.blokada);
+    w.g = philox_rng(seed);
+}
+
+/**
+ * @brief Wypełnia macierz losowymi cyframi 0-9
+ *
+ * Korzysta ze wspólnego generatora Philox (zob. seed_random()): wywołanie
+ * rezerwuje ⌈rows · cols / 2⌉ jego bloków, więc kolejne wywołania (także
+ * w tej samej sekundzie i z różnych wątków) dają różne macierze.
+ * Wypełnianie jest równoległe i wektorowe jak w fill_integers().
+ *
+ * @return referencja na bieżącą macierz (wypełnioną)
+ *
+ * @post każdy element macierzy zawiera losową wartość z zakresu [0, 9]
+ * @complexity O(n × m) gdzie n = rows, m = cols
+ *
+ * @example
+ * @code
+ * matrix m(3, 3);
+ * m.losuj();  // macierz zawiera losowe cyfry 0-9
+ *
+ * seed_random(7);
+ * matrix a(3, 3), b(3, 3);
+ * a.losuj();  // po seed_random(7) zawsze ta sama para a, b
+ * b.losuj();
+ * @endcode
+ *
+ * @see fill_integers(), fill_uniform(), fill_normal()
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::losuj() {
+    philox_rng g = zarezerwuj((static_cast<std::uint64_t>(get_rows()) * get_cols() + 1) / 2);
+    return fill_integers(*this, g, 0, 9);
+}
+
+/**
+ * @brief Losuje `x` par współrzędnych i wstawia losowe cyfry
+ *
+ * Wybiera `x` losowych pozycji w macierzy i wstawia w nich losowe cyfry 0-9.
+ * Pozycje mogą się powtarzać (losowanie ze zwracaniem). Każda pozycja
+ * zużywa jeden blok wspólnego generatora: słowa w0, w1 i w2 wybierają
+ * wiersz, kolumnę i wartość mnożeniem (w · zakres) >> 32.
+ *
+ * @param x liczba pozycji do wylosowania i wypełnienia
+ *
+ * @return referencja na bieżącą macierz (zmodyfikowaną)
+ *
+ * @post co najwyżej `x` losowych elementów zawiera losowe wartości z [0, 9]
+ * @complexity O(x)
+ *
+ * @example
+ * @code
+ * matrix m(5, 5, 0.0);
+ * m.losuj(10);  // wypełni co najwyżej 10 losowych pozycji
+ * @endcode
+ *
+ * @note Liczba faktycznie zmienionych elementów może być mniejsza niż `x`
+ *       ze względu na losowe powtórzenia pozycji
+ *
+ * @see losuj()
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::losuj(int x) {
+    if (x <= 0 || rows == 0 || cols == 0) {
+        return *this;
+    }
+    philox_rng g = zarezerwuj(static_cast<std::uint64_t>(x));
+    for (int i = 0; i < x; ++i) {
+        const auto w = g();
+        const std::size_t row = (static_cast<std::uint64_t>(w[0]) * get_rows()) >> 32;
+        const std::size_t col = (static_cast<std::uint64_t>(w[1]) * get_cols()) >> 32;
+        (*this)(row, col) = static_cast<T>((static_cast<std::uint64_t>(w[2]) * 10) >> 32);
+    }
+    return *this;
+}
+
+// Jawne konkretyzacje generatora
+#define MATRIX_KONKRETYZUJ_LOSOWANIE(T)                                                              \
+    template basic_matrix<T>& fill_uniform(basic_matrix<T>&, philox_rng&, double, double);           \
+    template basic_matrix<T>& fill_normal(basic_matrix<T>&, philox_rng&, double, double);            \
+    template basic_matrix<T>& fill_integers(basic_matrix<T>&, philox_rng&, std::int64_t, std::int64_t); \
+    template basic_matrix<T>& basic_matrix<T>::losuj();                                              \
+    template basic_matrix<T>& basic_matrix<T>::losuj(int);
+
+MATRIX_KONKRETYZUJ_LOSOWANIE(double)
+MATRIX_KONKRETYZUJ_LOSOWANIE(float)
+MATRIX_KONKRETYZUJ_LOSOWANIE(std::int8_t)
+MATRIX_KONKRETYZUJ_LOSOWANIE(std::int32_t)
+MATRIX_KONKRETYZUJ_LOSOWANIE(std::int64_t)
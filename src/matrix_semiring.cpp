@@ -0,0 +1,179 @@
+// S::add / S::mul zwracajace wektory AVX sa konkretyzowane tylko w tym pliku
+// i wstawiane w miejscu wywolania, wiec ostrzezenie o zmianie ABI (zglaszane
+// w semiring.h) nie dotyczy zadnego wywolania miedzy plikami
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#include "../include/semiring.h"
+#include "../include/bool_matrix.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+/// @brief Wektor GCC o B bajtach; dla B == sizeof(double) zwykly double
+template <std::size_t B>
+struct wektor {
+    typedef double typ __attribute__((vector_size(B)));
+};
+
+template <>
+struct wektor<sizeof(double)> {
+    using typ = double;
+};
+
+/// @brief Wektor V wypelniony wartoscia x
+template <typename V>
+__attribute__((always_inline)) inline V rozglos(double x) {
+    if constexpr (std::is_same_v<V, double>) {
+        return x;
+    } else {
+        V v;
+        for (std::size_t l = 0; l < sizeof(V) / sizeof(double); ++l) {
+            v[l] = x;
+        }
+        return v;
+    }
+}
+
+/**
+ * @brief Mikro-jądro: C[MR × NV·L] = C ⊕ (A_pack ⊗ B_pack)
+ *
+ * Kafelek wyniku leży w MR × NV akumulatorach wektorowych po L = B / 8
+ * elementów. W każdym kroku p element A(i, p) jest rozgłaszany na wektor
+ * i łączony z NV wektorami wiersza paska B. Wymiary są stałymi szablonu,
+ * więc pętle po i i v są w pełni rozwinięte, a akumulatory zostają
+ * w rejestrach. Funkcja jest wstawiana do wariantów z atrybutem `target`,
+ * dzięki czemu te same operacje S::add / S::mul kompilują się do
+ * instrukcji SSE2, AVX2 lub AVX-512.
+ */
+template <typename S, std::size_t MR, std::size_t NV, std::size_t B>
+__attribute__((always_inline)) inline
+void mikro(std::size_t kc, const double* a_pack, const double* b_pack,
+           double* c, std::ptrdiff_t rsc) {
+    using V = typename wektor<B>::typ;
+    constexpr std::size_t L = B / sizeof(double);
+
+    V t[MR][NV];
+#pragma GCC unroll 8
+    for (std::size_t i = 0; i < MR; ++i) {
+#pragma GCC unroll 2
+        for (std::size_t v = 0; v < NV; ++v) {
+            std::memcpy(&t[i][v], c + i * rsc + v * L, B);
+        }
+    }
+    for (std::size_t p = 0; p < kc; ++p) {
+        V b[NV];
+#pragma GCC unroll 2
+        for (std::size_t v = 0; v < NV; ++v) {
+            std::memcpy(&b[v], b_pack + (p * NV + v) * L, B);
+        }
+#pragma GCC unroll 8
+        for (std::size_t i = 0; i < MR; ++i) {
+            const V a = rozglos<V>(a_pack[p * MR + i]);
+#pragma GCC unroll 2
+            for (std::size_t v = 0; v < NV; ++v) {
+                t[i][v] = S::add(t[i][v], S::mul(a, b[v]));
+            }
+        }
+    }
+#pragma GCC unroll 8
+    for (std::size_t i = 0; i < MR; ++i) {
+#pragma GCC unroll 2
+        for (std::size_t v = 0; v < NV; ++v) {
+            std::memcpy(c + i * rsc + v * L, &t[i][v], B);
+        }
+    }
+}
+
+template <typename S>
+void mikro_scalar(std::size_t kc, const double* a, const double* b, double* c, std::ptrdiff_t rsc) {
+    mikro<S, 4, 4, sizeof(double)>(kc, a, b, c, rsc);
+}
+
+#ifdef MATRIX_X86_SIMD
+template <typename S>
+__attribute__((target("sse2")))
+void mikro_sse2(std::size_t kc, const double* a, const double* b, double* c, std::ptrdiff_t rsc) {
+    mikro<S, 4, 2, 16>(kc, a, b, c, rsc);
+}
+
+template <typename S>
+__attribute__((target("avx2,fma")))
+void mikro_avx2(std::size_t kc, const double* a, const double* b, double* c, std::ptrdiff_t rsc) {
+    mikro<S, 6, 2, 32>(kc, a, b, c, rsc);
+}
+
+template <typename S>
+__attribute__((target("avx512f")))
+void mikro_avx512(std::size_t kc, const double* a, const double* b, double* c, std::ptrdiff_t rsc) {
+    mikro<S, 8, 2, 64>(kc, a, b, c, rsc);
+}
+#endif // MATRIX_X86_SIMD
+
+/// @brief Mikro-jądro dla zestawu instrukcji wybranego przez detail::kernels()
+template <typename S>
+detail::mikro_jadro wybierz_jadro() {
+    switch (detail::kernels().poziom) {
+#ifdef MATRIX_X86_SIMD
+    case detail::isa::avx512: return {8, 16, mikro_avx512<S>};
+    case detail::isa::avx2:   return {6, 8, mikro_avx2<S>};
+    case detail::isa::sse2:   return {4, 4, mikro_sse2<S>};
+#endif
+    default:                  return {4, 4, mikro_scalar<S>};
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Iloczyn macierzy nad półpierścieniem S
+ *
+ * C jest wypełniane S::zero, a iloczyn liczy silnik detail::gemm_blocked
+ * (pakowanie paneli, pętle NC → KC → MC, kafelki wyniku rozdzielane między
+ * wątki puli) z mikro-jądrem półpierścienia zamiast mikro-jądra GEMM.
+ *
+ * @param A Lewy operand
+ * @param B Prawy operand
+ * @return Nowa macierz z iloczynem
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ * @complexity O(m × n × k)
+ */
+template <typename S>
+matrix multiply(const matrix& A, const matrix& B, S) {
+    if (A.get_cols() != B.get_rows()) {
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    }
+    const std::size_t m = A.get_rows(), n = B.get_cols(), k = A.get_cols();
+    matrix C(m, n, S::zero);
+    if (m == 0 || n == 0 || k == 0) {
+        return C;
+    }
+    detail::gemm_blocked(wybierz_jadro<S>(), m, n, k,
+                         A.row_ptr(0), static_cast<std::ptrdiff_t>(A.get_stride()), 1,
+                         B.row_ptr(0), static_cast<std::ptrdiff_t>(B.get_stride()), 1,
+                         C.row_ptr(0), static_cast<std::ptrdiff_t>(C.get_stride()));
+    return C;
+}
+
+template matrix multiply(const matrix&, const matrix&, plus_times);
+template matrix multiply(const matrix&, const matrix&, min_plus);
+template matrix multiply(const matrix&, const matrix&, max_plus);
+
+/**
+ * @brief Iloczyn nad półpierścieniem logicznym (OR, AND)
+ *
+ * Element różny od zera jest prawdą. Zamiast mikro-jądra na double
+ * iloczyn liczy bool_matrix - 64 elementy w słowie, metodą „czterech
+ * Rosjan” - więc operandy zajmują 64 razy mniej pamięci.
+ *
+ * @return macierz 0/1
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ * @complexity O(m × n × k / (64 × 8)) operacji na słowach
+ */
+template <>
+matrix multiply(const matrix& A, const matrix& B, or_and) {
+    return (bool_matrix(A) * bool_matrix(B)).to_matrix();
+}
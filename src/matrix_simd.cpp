@@ -0,0 +1,1518 @@
+#include "matrix_simd.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef MATRIX_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace detail {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Wariant skalarny - działa na każdej architekturze
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Skalarne mikro-jądro GEMM 4 × 8
+ *
+ * Akumulatory mają stały rozmiar, więc przy -O2 kompilator i tak
+ * trzyma je w rejestrach; wariant służy jako punkt odniesienia
+ * i zapas dla procesorów spoza rodziny x86.
+ */
+void gemm_micro_scalar(std::size_t kc, const double* a, const double* b,
+                       double* c, std::ptrdiff_t rsc) {
+    constexpr std::size_t MR = 4, NR = 8;
+    double acc[MR][NR] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+        for (std::size_t i = 0; i < MR; ++i) {
+            const double ai = a[i];
+            for (std::size_t j = 0; j < NR; ++j) {
+                acc[i][j] += ai * b[j];
+            }
+        }
+        a += MR;
+        b += NR;
+    }
+    for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t j = 0; j < NR; ++j) {
+            c[i * rsc + j] += acc[i][j];
+        }
+    }
+}
+
+/**
+ * @brief Wsadowe mnożenie małych macierzy, wariant skalarny: C[g] = A[g] * B[g]
+ *
+ * Służy też do obsługi końcówki wsadu w wariantach SIMD.
+ */
+void batch_gemm_scalar(std::size_t count, std::size_t m, std::size_t n, std::size_t k,
+                       const double* a, const double* b, double* c) {
+    for (std::size_t g = 0; g < count; ++g) {
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                double suma = 0.0;
+                for (std::size_t p = 0; p < k; ++p) {
+                    suma += a[i * k + p] * b[p * n + j];
+                }
+                c[i * n + j] = suma;
+            }
+        }
+        a += m * k;
+        b += k * n;
+        c += m * n;
+    }
+}
+
+void add_scalar_isa(std::size_t n, const double* a, const double* b, double* out) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+void sub_scalar_isa(std::size_t n, const double* a, const double* b, double* out) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = a[i] - b[i];
+}
+
+void adds_scalar_isa(std::size_t n, const double* a, double s, double* out) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + s;
+}
+
+void muls_scalar_isa(std::size_t n, const double* a, double s, double* out) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = a[i] * s;
+}
+
+void rsubs_scalar_isa(std::size_t n, const double* a, double s, double* out) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = s - a[i];
+}
+
+bool eq_scalar_isa(std::size_t n, const double* a, const double* b) {
+    for (std::size_t i = 0; i < n; ++i) if (a[i] != b[i]) return false;
+    return true;
+}
+
+bool gt_scalar_isa(std::size_t n, const double* a, const double* b) {
+    for (std::size_t i = 0; i < n; ++i) if (a[i] <= b[i]) return false;
+    return true;
+}
+
+bool lt_scalar_isa(std::size_t n, const double* a, const double* b) {
+    for (std::size_t i = 0; i < n; ++i) if (a[i] >= b[i]) return false;
+    return true;
+}
+
+/**
+ * @brief Skalarne jądro iloczynu int8 (zob. simd_kernels::gemm_i8)
+ */
+void gemm_i8_scalar(std::size_t mr, std::size_t kp, std::size_t n,
+                    const std::int32_t* a, std::size_t lda,
+                    const std::int16_t* b, std::size_t ldb,
+                    std::int32_t* c, std::ptrdiff_t rsc) {
+    for (std::size_t r = 0; r < mr; ++r) {
+        std::int32_t* cr = c + static_cast<std::ptrdiff_t>(r) * rsc;
+        for (std::size_t q = 0; q < kp; ++q) {
+            const std::uint32_t para = static_cast<std::uint32_t>(a[r * lda + q]);
+            const std::int32_t a0 = static_cast<std::int16_t>(para & 0xFFFFu);
+            const std::int32_t a1 = static_cast<std::int16_t>(para >> 16);
+            const std::int16_t* w = b + q * ldb;
+            for (std::size_t j = 0; j < n; ++j) {
+                cr[j] += a0 * w[2 * j] + a1 * w[2 * j + 1];
+            }
+        }
+    }
+}
+
+void axpy_scalar(std::size_t n, double a, const double* b, double* c) {
+    for (std::size_t i = 0; i < n; ++i) c[i] += a * b[i];
+}
+
+void axpy_f32_scalar(std::size_t n, float a, const float* b, float* c) {
+    for (std::size_t i = 0; i < n; ++i) c[i] += a * b[i];
+}
+
+/**
+ * @brief Skalarne jądro iloczynu float: C[mr x n] += A[mr x kc] * B[kc x n]
+ *
+ * Każdy element C jest sumowany po kolei po p, jak w wariantach SIMD.
+ */
+template <std::size_t MR>
+void gemm_f32_scalar_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                        const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    for (std::size_t r = 0; r < MR; ++r) {
+        for (std::size_t p = 0; p < kc; ++p) {
+            axpy_f32_scalar(n, a[r * lda + p], b + p * ldb, c + r * ldc);
+        }
+    }
+}
+
+/**
+ * @brief Skalarne sumowanie Kahana: S[mr x n] += A[mr x kc] * B[kc x n]
+ *
+ * Poprawka K zbiera błąd zaokrąglenia każdego dodawania i jest
+ * odejmowana od następnego składnika, więc błąd sumy nie rośnie
+ * z liczbą składników.
+ */
+template <std::size_t MR>
+void gemm_f32_kahan_scalar_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                              const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    for (std::size_t r = 0; r < MR; ++r) {
+        float* sr = s + r * ldc;
+        float* kr = k + r * ldc;
+        for (std::size_t p = 0; p < kc; ++p) {
+            const float ap = a[r * lda + p];
+            const float* w = b + p * ldb;
+            for (std::size_t j = 0; j < n; ++j) {
+                const float y = ap * w[j] - kr[j];
+                const float t = sr[j] + y;
+                kr[j] = (t - sr[j]) - y;
+                sr[j] = t;
+            }
+        }
+    }
+}
+
+void gemm_f32_scalar(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                     const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    for (std::size_t r = 0; r < mr; ++r) {
+        gemm_f32_scalar_mr<1>(kc, n, a + r * lda, lda, b, ldb, c + r * ldc, ldc);
+    }
+}
+
+void gemm_f32_kahan_scalar(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                           const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    for (std::size_t r = 0; r < mr; ++r) {
+        gemm_f32_kahan_scalar_mr<1>(kc, n, a + r * lda, lda, b, ldb, s + r * ldc, k + r * ldc, ldc);
+    }
+}
+
+/**
+ * @brief Skalarna transpozycja bloku elementów o rozmiarze sizeof(W)
+ *
+ * Elementy są przenoszone przez memcpy, więc typ W określa tylko
+ * rozmiar i nie musi zgadzać się z typem elementów macierzy.
+ */
+template <typename W>
+void transpose_scalar_w(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                        void* b, std::size_t ldb) {
+    const unsigned char* z = static_cast<const unsigned char*>(a);
+    unsigned char* w = static_cast<unsigned char*>(b);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            std::memcpy(w + (j * ldb + i) * sizeof(W), z + (i * lda + j) * sizeof(W), sizeof(W));
+        }
+    }
+}
+
+void transpose_b64_scalar(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                          void* b, std::size_t ldb) {
+    transpose_scalar_w<std::uint64_t>(rows, cols, a, lda, b, ldb);
+}
+
+void transpose_b32_scalar(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                          void* b, std::size_t ldb) {
+    transpose_scalar_w<std::uint32_t>(rows, cols, a, lda, b, ldb);
+}
+
+/**
+ * @brief Transpozycja bloku kafelkami T × T z brzegiem liczonym skalarnie
+ *
+ * `kafelek(z, lda, w, ldb)` transponuje pełny kafelek T × T w rejestrach.
+ * Pozostałe kolumny (cols % T) i wiersze (rows % T) obsługuje wariant
+ * skalarny.
+ */
+template <std::size_t T, typename W, typename F>
+inline void transpose_kafelkami(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                                void* b, std::size_t ldb, F kafelek) {
+    const W* z = static_cast<const W*>(a);
+    W* w = static_cast<W*>(b);
+    const std::size_t rows_t = rows / T * T, cols_t = cols / T * T;
+    for (std::size_t i = 0; i < rows_t; i += T) {
+        for (std::size_t j = 0; j < cols_t; j += T) {
+            kafelek(z + i * lda + j, lda, w + j * ldb + i, ldb);
+        }
+        transpose_scalar_w<W>(T, cols - cols_t, z + i * lda + cols_t, lda, w + cols_t * ldb + i, ldb);
+    }
+    transpose_scalar_w<W>(rows - rows_t, cols, z + rows_t * lda, lda, w + rows_t, ldb);
+}
+
+/// @brief Stale mnozenia i przyrostu klucza Philox4x32 (Salmon i in., "Parallel Random Numbers: As Easy as 1, 2, 3")
+constexpr std::uint32_t philox_m0 = 0xD2511F53u, philox_m1 = 0xCD9E8D57u;
+constexpr std::uint32_t philox_w0 = 0x9E3779B9u, philox_w1 = 0xBB67AE85u;
+
+/**
+ * @brief Jeden blok Philox4x32-10 dla licznika c i klucza (k0, k1)
+ *
+ * Runda mnoży słowa 0 i 2 przez stałe (32 × 32 → 64 bity), miesza
+ * połówki iloczynów ze słowami 1 i 3 oraz kluczem; klucz rośnie
+ * o stałe Weyla między rundami.
+ */
+inline void philox_blok(std::uint32_t c[4], std::uint32_t k0, std::uint32_t k1) noexcept {
+    for (int r = 0; r < 10; ++r) {
+        if (r) {
+            k0 += philox_w0;
+            k1 += philox_w1;
+        }
+        const std::uint64_t p0 = static_cast<std::uint64_t>(philox_m0) * c[0];
+        const std::uint64_t p1 = static_cast<std::uint64_t>(philox_m1) * c[2];
+        const std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0;
+        const std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1;
+        c[1] = static_cast<std::uint32_t>(p1);
+        c[3] = static_cast<std::uint32_t>(p0);
+        c[0] = n0;
+        c[2] = n2;
+    }
+}
+
+void philox_scalar(std::size_t n, std::uint64_t licznik, std::uint64_t strumien,
+                   std::uint64_t klucz, std::uint64_t* out) {
+    const std::uint32_t k0 = static_cast<std::uint32_t>(klucz), k1 = static_cast<std::uint32_t>(klucz >> 32);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint64_t l = licznik + i;
+        std::uint32_t c[4] = {static_cast<std::uint32_t>(l), static_cast<std::uint32_t>(l >> 32),
+                              static_cast<std::uint32_t>(strumien), static_cast<std::uint32_t>(strumien >> 32)};
+        philox_blok(c, k0, k1);
+        out[2 * i] = static_cast<std::uint64_t>(c[1]) << 32 | c[0];
+        out[2 * i + 1] = static_cast<std::uint64_t>(c[3]) << 32 | c[2];
+    }
+}
+
+/**
+ * @brief Philox kolejnymi grupami po L bloków z resztą liczoną skalarnie
+ *
+ * `grupa(licznik, out)` liczy L bloków o licznikach licznik .. licznik + L - 1,
+ * zakładając, że młodsze 32 bity licznika nie przepełniają się w grupie;
+ * grupy z przeniesieniem do starszego słowa liczy wariant skalarny.
+ */
+template <std::size_t L, typename F>
+inline void philox_grupami(std::size_t n, std::uint64_t licznik, std::uint64_t strumien,
+                           std::uint64_t klucz, std::uint64_t* out, F grupa) {
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        const std::uint64_t l = licznik + i;
+        if (static_cast<std::uint32_t>(l) > UINT32_MAX - (L - 1)) {
+            philox_scalar(L, l, strumien, klucz, out + 2 * i);
+        } else {
+            grupa(l, out + 2 * i);
+        }
+    }
+    philox_scalar(n - i, licznik + i, strumien, klucz, out + 2 * i);
+}
+
+const simd_kernels jadra_scalar = {
+    isa::scalar, "scalar", 4, 8, gemm_micro_scalar, batch_gemm_scalar,
+    add_scalar_isa, sub_scalar_isa, adds_scalar_isa, muls_scalar_isa, rsubs_scalar_isa,
+    eq_scalar_isa, gt_scalar_isa, lt_scalar_isa, gemm_i8_scalar,
+    axpy_scalar, axpy_f32_scalar, gemm_f32_scalar, gemm_f32_kahan_scalar,
+    transpose_b64_scalar, transpose_b32_scalar, philox_scalar
+};
+
+#ifdef MATRIX_X86_SIMD
+
+// ---------------------------------------------------------------------------
+// SSE2 - 2 double na rejestr
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Mikro-jądro SSE2 4 × 4 (8 akumulatorów xmm)
+ */
+__attribute__((target("sse2")))
+void gemm_micro_sse2(std::size_t kc, const double* a, const double* b,
+                     double* c, std::ptrdiff_t rsc) {
+    __m128d acc[4][2];
+#pragma GCC unroll 4
+    for (int i = 0; i < 4; ++i) {
+        acc[i][0] = _mm_setzero_pd();
+        acc[i][1] = _mm_setzero_pd();
+    }
+    for (std::size_t p = 0; p < kc; ++p) {
+        const __m128d b0 = _mm_load_pd(b);
+        const __m128d b1 = _mm_load_pd(b + 2);
+#pragma GCC unroll 4
+        for (int i = 0; i < 4; ++i) {
+            const __m128d ai = _mm_set1_pd(a[i]);
+            acc[i][0] = _mm_add_pd(acc[i][0], _mm_mul_pd(ai, b0));
+            acc[i][1] = _mm_add_pd(acc[i][1], _mm_mul_pd(ai, b1));
+        }
+        a += 4;
+        b += 4;
+    }
+#pragma GCC unroll 4
+    for (int i = 0; i < 4; ++i) {
+        double* ci = c + i * rsc;
+        _mm_storeu_pd(ci, _mm_add_pd(_mm_loadu_pd(ci), acc[i][0]));
+        _mm_storeu_pd(ci + 2, _mm_add_pd(_mm_loadu_pd(ci + 2), acc[i][1]));
+    }
+}
+
+/**
+ * @brief Wsadowe mnożenie SSE2: jeden rejestr niesie ten sam element dwóch macierzy
+ *
+ * Elementy dwóch kolejnych macierzy wsadu są łączone w pary (układ
+ * "struktura tablic" w rejestrach), więc każda instrukcja liczy ten sam
+ * krok dla dwóch iloczynów naraz, bez przetasowań wewnątrz macierzy.
+ */
+__attribute__((target("sse2")))
+void batch_gemm_sse2(std::size_t count, std::size_t m, std::size_t n, std::size_t k,
+                     const double* a, const double* b, double* c) {
+    const std::size_t sa = m * k, sb = k * n, sc = m * n;
+    __m128d va[simd_batch_max * simd_batch_max];
+    __m128d vb[simd_batch_max * simd_batch_max];
+    std::size_t g = 0;
+    for (; g + 2 <= count; g += 2) {
+        for (std::size_t e = 0; e < sa; ++e) va[e] = _mm_set_pd(a[sa + e], a[e]);
+        for (std::size_t e = 0; e < sb; ++e) vb[e] = _mm_set_pd(b[sb + e], b[e]);
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                __m128d acc = _mm_setzero_pd();
+                for (std::size_t p = 0; p < k; ++p) {
+                    acc = _mm_add_pd(acc, _mm_mul_pd(va[i * k + p], vb[p * n + j]));
+                }
+                _mm_storel_pd(c + i * n + j, acc);
+                _mm_storeh_pd(c + sc + i * n + j, acc);
+            }
+        }
+        a += 2 * sa;
+        b += 2 * sb;
+        c += 2 * sc;
+    }
+    batch_gemm_scalar(count - g, m, n, k, a, b, c);
+}
+
+/// Element-wise SSE2: pętla główna po 2 elementy, reszta skalarnie.
+#define MATRIX_SSE2_BINARY(nazwa, op_wek, op)                                        \
+    __attribute__((target("sse2")))                                                 \
+    void nazwa(std::size_t n, const double* a, const double* b, double* out) {      \
+        std::size_t i = 0;                                                          \
+        for (; i + 2 <= n; i += 2)                                                  \
+            _mm_storeu_pd(out + i, op_wek(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i))); \
+        for (; i < n; ++i) out[i] = a[i] op b[i];                                   \
+    }
+
+MATRIX_SSE2_BINARY(add_sse2, _mm_add_pd, +)
+MATRIX_SSE2_BINARY(sub_sse2, _mm_sub_pd, -)
+
+__attribute__((target("sse2")))
+void adds_sse2(std::size_t n, const double* a, double s, double* out) {
+    const __m128d vs = _mm_set1_pd(s);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), vs));
+    for (; i < n; ++i) out[i] = a[i] + s;
+}
+
+__attribute__((target("sse2")))
+void muls_sse2(std::size_t n, const double* a, double s, double* out) {
+    const __m128d vs = _mm_set1_pd(s);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), vs));
+    for (; i < n; ++i) out[i] = a[i] * s;
+}
+
+__attribute__((target("sse2")))
+void rsubs_sse2(std::size_t n, const double* a, double s, double* out) {
+    const __m128d vs = _mm_set1_pd(s);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_sub_pd(vs, _mm_loadu_pd(a + i)));
+    for (; i < n; ++i) out[i] = s - a[i];
+}
+
+/// Porównania SSE2: fałsz, gdy choć jedna para spełnia warunek przeciwny.
+#define MATRIX_SSE2_COMPARE(nazwa, cmp_wek, przeciwny)                              \
+    __attribute__((target("sse2")))                                                 \
+    bool nazwa(std::size_t n, const double* a, const double* b) {                   \
+        std::size_t i = 0;                                                          \
+        for (; i + 2 <= n; i += 2)                                                  \
+            if (_mm_movemask_pd(cmp_wek(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)))) \
+                return false;                                                       \
+        for (; i < n; ++i) if (a[i] przeciwny b[i]) return false;                   \
+        return true;                                                                \
+    }
+
+MATRIX_SSE2_COMPARE(eq_sse2, _mm_cmpneq_pd, !=)
+MATRIX_SSE2_COMPARE(gt_sse2, _mm_cmple_pd, <=)
+MATRIX_SSE2_COMPARE(lt_sse2, _mm_cmpge_pd, >=)
+
+/**
+ * @brief Jądro iloczynu int8 SSE2: MR wierszy × 8 kolumn (2·MR akumulatorów xmm)
+ *
+ * PMADDWD mnoży pary int16 i sumuje je do int32, więc jedna instrukcja
+ * przetwarza dwa kroki wspólnego wymiaru dla czterech kolumn. Każdy
+ * odczyt B jest użyty dla MR wierszy A.
+ */
+template <std::size_t MR>
+__attribute__((target("sse2")))
+void gemm_i8_sse2_mr(std::size_t kp, std::size_t n,
+                     const std::int32_t* a, std::size_t lda,
+                     const std::int16_t* b, std::size_t ldb,
+                     std::int32_t* c, std::ptrdiff_t rsc) {
+    std::size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m128i acc[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            acc[r][0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + r * rsc + j));
+            acc[r][1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + r * rsc + j + 4));
+        }
+        for (std::size_t q = 0; q < kp; ++q) {
+            const std::int16_t* w = b + q * ldb + 2 * j;
+            const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w));
+            const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + 8));
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m128i va = _mm_set1_epi32(a[r * lda + q]);
+                acc[r][0] = _mm_add_epi32(acc[r][0], _mm_madd_epi16(va, b0));
+                acc[r][1] = _mm_add_epi32(acc[r][1], _mm_madd_epi16(va, b1));
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c + r * rsc + j), acc[r][0]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c + r * rsc + j + 4), acc[r][1]);
+        }
+    }
+    gemm_i8_scalar(MR, kp, n - j, a, lda, b + 2 * j, ldb, c + j, rsc);
+}
+
+__attribute__((target("sse2")))
+void gemm_i8_sse2(std::size_t mr, std::size_t kp, std::size_t n,
+                  const std::int32_t* a, std::size_t lda,
+                  const std::int16_t* b, std::size_t ldb,
+                  std::int32_t* c, std::ptrdiff_t rsc) {
+    switch (mr) {
+    case 4: gemm_i8_sse2_mr<4>(kp, n, a, lda, b, ldb, c, rsc); break;
+    case 3: gemm_i8_sse2_mr<3>(kp, n, a, lda, b, ldb, c, rsc); break;
+    case 2: gemm_i8_sse2_mr<2>(kp, n, a, lda, b, ldb, c, rsc); break;
+    case 1: gemm_i8_sse2_mr<1>(kp, n, a, lda, b, ldb, c, rsc); break;
+    default: break;
+    }
+}
+
+__attribute__((target("sse2")))
+void axpy_sse2(std::size_t n, double a, const double* b, double* c) {
+    const __m128d va = _mm_set1_pd(a);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(c + i, _mm_add_pd(_mm_loadu_pd(c + i), _mm_mul_pd(va, _mm_loadu_pd(b + i))));
+    axpy_scalar(n - i, a, b + i, c + i);
+}
+
+__attribute__((target("sse2")))
+void axpy_f32_sse2(std::size_t n, float a, const float* b, float* c) {
+    const __m128 va = _mm_set1_ps(a);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(c + i, _mm_add_ps(_mm_loadu_ps(c + i), _mm_mul_ps(va, _mm_loadu_ps(b + i))));
+    axpy_f32_scalar(n - i, a, b + i, c + i);
+}
+
+/**
+ * @brief Jądra iloczynu float SSE2: MR wierszy × 8 kolumn w rejestrach
+ *
+ * Akumulatory (a dla Kahana także poprawki) pozostają w rejestrach przez
+ * cały wspólny wymiar, a każdy odczyt B jest użyty dla MR wierszy A.
+ */
+template <std::size_t MR>
+__attribute__((target("sse2")))
+void gemm_f32_sse2_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                     const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    std::size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m128 acc[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            acc[r][0] = _mm_loadu_ps(c + r * ldc + j);
+            acc[r][1] = _mm_loadu_ps(c + r * ldc + j + 4);
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            const float* w = b + p * ldb + j;
+            const __m128 b0 = _mm_loadu_ps(w);
+            const __m128 b1 = _mm_loadu_ps(w + 4);
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m128 va = _mm_set1_ps(a[r * lda + p]);
+                acc[r][0] = _mm_add_ps(_mm_mul_ps(va, b0), acc[r][0]);
+                acc[r][1] = _mm_add_ps(_mm_mul_ps(va, b1), acc[r][1]);
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            _mm_storeu_ps(c + r * ldc + j, acc[r][0]);
+            _mm_storeu_ps(c + r * ldc + j + 4, acc[r][1]);
+        }
+    }
+    gemm_f32_scalar_mr<MR>(kc, n - j, a, lda, b + j, ldb, c + j, ldc);
+}
+
+template <std::size_t MR>
+__attribute__((target("sse2")))
+void gemm_f32_kahan_sse2_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                           const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    std::size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m128 suma[MR][2], popr[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            for (std::size_t v = 0; v < 2; ++v) {
+                suma[r][v] = _mm_loadu_ps(s + r * ldc + j + v * 4);
+                popr[r][v] = _mm_loadu_ps(k + r * ldc + j + v * 4);
+            }
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            const float* w = b + p * ldb + j;
+            const __m128 bv[2] = {_mm_loadu_ps(w), _mm_loadu_ps(w + 4)};
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m128 va = _mm_set1_ps(a[r * lda + p]);
+#pragma GCC unroll 2
+                for (std::size_t v = 0; v < 2; ++v) {
+                    const __m128 y = _mm_sub_ps(_mm_mul_ps(va, bv[v]), popr[r][v]);
+                    const __m128 t = _mm_add_ps(suma[r][v], y);
+                    popr[r][v] = _mm_sub_ps(_mm_sub_ps(t, suma[r][v]), y);
+                    suma[r][v] = t;
+                }
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            for (std::size_t v = 0; v < 2; ++v) {
+                _mm_storeu_ps(s + r * ldc + j + v * 4, suma[r][v]);
+                _mm_storeu_ps(k + r * ldc + j + v * 4, popr[r][v]);
+            }
+        }
+    }
+    gemm_f32_kahan_scalar_mr<MR>(kc, n - j, a, lda, b + j, ldb, s + j, k + j, ldc);
+}
+
+__attribute__((target("sse2")))
+void gemm_f32_sse2(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                  const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    switch (mr) {
+    case 4: gemm_f32_sse2_mr<4>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 3: gemm_f32_sse2_mr<3>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 2: gemm_f32_sse2_mr<2>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 1: gemm_f32_sse2_mr<1>(kc, n, a, lda, b, ldb, c, ldc); break;
+    default: break;
+    }
+}
+
+__attribute__((target("sse2")))
+void gemm_f32_kahan_sse2(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                        const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    switch (mr) {
+    case 4: gemm_f32_kahan_sse2_mr<4>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 3: gemm_f32_kahan_sse2_mr<3>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 2: gemm_f32_kahan_sse2_mr<2>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 1: gemm_f32_kahan_sse2_mr<1>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    default: break;
+    }
+}
+
+/**
+ * @brief Transpozycja 8-bajtowych elementów kafelkami 2 × 2 (UNPCKLPD / UNPCKHPD)
+ */
+__attribute__((target("sse2")))
+void transpose_b64_sse2(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                        void* b, std::size_t ldb) {
+    transpose_kafelkami<2, std::uint64_t>(rows, cols, a, lda, b, ldb,
+        [](const std::uint64_t* z, std::size_t lz, std::uint64_t* w, std::size_t lw)
+            __attribute__((target("sse2"))) {
+            const __m128d r0 = _mm_loadu_pd(reinterpret_cast<const double*>(z));
+            const __m128d r1 = _mm_loadu_pd(reinterpret_cast<const double*>(z + lz));
+            _mm_storeu_pd(reinterpret_cast<double*>(w), _mm_unpacklo_pd(r0, r1));
+            _mm_storeu_pd(reinterpret_cast<double*>(w + lw), _mm_unpackhi_pd(r0, r1));
+        });
+}
+
+/**
+ * @brief Transpozycja 4-bajtowych elementów kafelkami 4 × 4 (_MM_TRANSPOSE4_PS)
+ */
+__attribute__((target("sse2")))
+void transpose_b32_sse2(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                        void* b, std::size_t ldb) {
+    transpose_kafelkami<4, std::uint32_t>(rows, cols, a, lda, b, ldb,
+        [](const std::uint32_t* z, std::size_t lz, std::uint32_t* w, std::size_t lw)
+            __attribute__((target("sse2"))) {
+            __m128 r0 = _mm_loadu_ps(reinterpret_cast<const float*>(z));
+            __m128 r1 = _mm_loadu_ps(reinterpret_cast<const float*>(z + lz));
+            __m128 r2 = _mm_loadu_ps(reinterpret_cast<const float*>(z + 2 * lz));
+            __m128 r3 = _mm_loadu_ps(reinterpret_cast<const float*>(z + 3 * lz));
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(reinterpret_cast<float*>(w), r0);
+            _mm_storeu_ps(reinterpret_cast<float*>(w + lw), r1);
+            _mm_storeu_ps(reinterpret_cast<float*>(w + 2 * lw), r2);
+            _mm_storeu_ps(reinterpret_cast<float*>(w + 3 * lw), r3);
+        });
+}
+
+/**
+ * @brief Philox4x32-10 dla 4 bloków naraz (słowa bloków w osobnych rejestrach)
+ *
+ * SSE2 nie ma mnożenia 32 × 32 bitów na wszystkich liniach, więc iloczyny
+ * linii parzystych i nieparzystych liczy PMULUDQ osobno, a młodsze
+ * i starsze połówki są składane przestawieniami.
+ */
+__attribute__((target("sse2")))
+void philox_sse2(std::size_t n, std::uint64_t licznik, std::uint64_t strumien,
+                 std::uint64_t klucz, std::uint64_t* out) {
+    philox_grupami<4>(n, licznik, strumien, klucz, out,
+        [&](std::uint64_t l, std::uint64_t* w) __attribute__((target("sse2"))) {
+            const __m128i m0 = _mm_set1_epi32(static_cast<int>(philox_m0));
+            const __m128i m1 = _mm_set1_epi32(static_cast<int>(philox_m1));
+            auto mulhilo = [](__m128i a, __m128i m, __m128i& lo, __m128i& hi) __attribute__((target("sse2"))) {
+                const __m128i p = _mm_mul_epu32(a, m);                      // linie 0, 2
+                const __m128i q = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);  // linie 1, 3
+                lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(p, _MM_SHUFFLE(3, 1, 2, 0)),
+                                        _mm_shuffle_epi32(q, _MM_SHUFFLE(3, 1, 2, 0)));
+                hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(p, _MM_SHUFFLE(2, 0, 3, 1)),
+                                        _mm_shuffle_epi32(q, _MM_SHUFFLE(2, 0, 3, 1)));
+            };
+            const std::uint32_t l0 = static_cast<std::uint32_t>(l);
+            __m128i c0 = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(l0)), _mm_set_epi32(3, 2, 1, 0));
+            __m128i c1 = _mm_set1_epi32(static_cast<int>(l >> 32));
+            __m128i c2 = _mm_set1_epi32(static_cast<int>(strumien));
+            __m128i c3 = _mm_set1_epi32(static_cast<int>(strumien >> 32));
+            std::uint32_t k0 = static_cast<std::uint32_t>(klucz), k1 = static_cast<std::uint32_t>(klucz >> 32);
+            for (int r = 0; r < 10; ++r) {
+                if (r) {
+                    k0 += philox_w0;
+                    k1 += philox_w1;
+                }
+                __m128i lo0, hi0, lo1, hi1;
+                mulhilo(c0, m0, lo0, hi0);
+                mulhilo(c2, m1, lo1, hi1);
+                c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(static_cast<int>(k0)));
+                c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(static_cast<int>(k1)));
+                c1 = lo1;
+                c3 = lo0;
+            }
+            // Slowa (w0, w1) i (w2, w3) kazdego bloku jako pary 64-bitowe, bloki po kolei
+            const __m128i a = _mm_unpacklo_epi32(c0, c1), b = _mm_unpackhi_epi32(c0, c1);
+            const __m128i x = _mm_unpacklo_epi32(c2, c3), y = _mm_unpackhi_epi32(c2, c3);
+            __m128i* o = reinterpret_cast<__m128i*>(w);
+            _mm_storeu_si128(o, _mm_unpacklo_epi64(a, x));
+            _mm_storeu_si128(o + 1, _mm_unpackhi_epi64(a, x));
+            _mm_storeu_si128(o + 2, _mm_unpacklo_epi64(b, y));
+            _mm_storeu_si128(o + 3, _mm_unpackhi_epi64(b, y));
+        });
+}
+
+const simd_kernels jadra_sse2 = {
+    isa::sse2, "sse2", 4, 4, gemm_micro_sse2, batch_gemm_sse2,
+    add_sse2, sub_sse2, adds_sse2, muls_sse2, rsubs_sse2,
+    eq_sse2, gt_sse2, lt_sse2, gemm_i8_sse2,
+    axpy_sse2, axpy_f32_sse2, gemm_f32_sse2, gemm_f32_kahan_sse2,
+    transpose_b64_sse2, transpose_b32_sse2, philox_sse2
+};
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA - 4 double na rejestr
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Mikro-jądro AVX2+FMA 6 × 8 (12 akumulatorów ymm)
+ */
+__attribute__((target("avx2,fma")))
+void gemm_micro_avx2(std::size_t kc, const double* a, const double* b,
+                     double* c, std::ptrdiff_t rsc) {
+    __m256d acc[6][2];
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i) {
+        acc[i][0] = _mm256_setzero_pd();
+        acc[i][1] = _mm256_setzero_pd();
+    }
+    for (std::size_t p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_load_pd(b);
+        const __m256d b1 = _mm256_load_pd(b + 4);
+#pragma GCC unroll 6
+        for (int i = 0; i < 6; ++i) {
+            const __m256d ai = _mm256_broadcast_sd(a + i);
+            acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += 6;
+        b += 8;
+    }
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i) {
+        double* ci = c + i * rsc;
+        _mm256_storeu_pd(ci, _mm256_add_pd(_mm256_loadu_pd(ci), acc[i][0]));
+        _mm256_storeu_pd(ci + 4, _mm256_add_pd(_mm256_loadu_pd(ci + 4), acc[i][1]));
+    }
+}
+
+/**
+ * @brief Wsadowe mnożenie AVX2: cztery macierze na rejestr, ładowanie przez gather
+ *
+ * Element (i, p) czterech kolejnych macierzy wsadu jest zbierany jednym
+ * `vgatherqpd` (odstęp m·k elementów), a wyniki rozpraszane przez bufor,
+ * bo AVX2 nie ma instrukcji scatter.
+ */
+__attribute__((target("avx2,fma")))
+void batch_gemm_avx2(std::size_t count, std::size_t m, std::size_t n, std::size_t k,
+                     const double* a, const double* b, double* c) {
+    const std::size_t sa = m * k, sb = k * n, sc = m * n;
+    const __m256i ia = _mm256_set_epi64x(3 * sa, 2 * sa, sa, 0);
+    const __m256i ib = _mm256_set_epi64x(3 * sb, 2 * sb, sb, 0);
+    __m256d va[simd_batch_max * simd_batch_max];
+    __m256d vb[simd_batch_max * simd_batch_max];
+    alignas(32) double wynik[4];
+    std::size_t g = 0;
+    for (; g + 4 <= count; g += 4) {
+        for (std::size_t e = 0; e < sa; ++e) va[e] = _mm256_i64gather_pd(a + e, ia, 8);
+        for (std::size_t e = 0; e < sb; ++e) vb[e] = _mm256_i64gather_pd(b + e, ib, 8);
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                __m256d acc = _mm256_setzero_pd();
+                for (std::size_t p = 0; p < k; ++p) {
+                    acc = _mm256_fmadd_pd(va[i * k + p], vb[p * n + j], acc);
+                }
+                _mm256_store_pd(wynik, acc);
+                for (std::size_t l = 0; l < 4; ++l) c[l * sc + i * n + j] = wynik[l];
+            }
+        }
+        a += 4 * sa;
+        b += 4 * sb;
+        c += 4 * sc;
+    }
+    batch_gemm_scalar(count - g, m, n, k, a, b, c);
+}
+
+#define MATRIX_AVX2_BINARY(nazwa, op_wek, op)                                        \
+    __attribute__((target("avx2,fma")))                                             \
+    void nazwa(std::size_t n, const double* a, const double* b, double* out) {      \
+        std::size_t i = 0;                                                          \
+        for (; i + 4 <= n; i += 4)                                                  \
+            _mm256_storeu_pd(out + i,                                               \
+                             op_wek(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i))); \
+        for (; i < n; ++i) out[i] = a[i] op b[i];                                   \
+    }
+
+MATRIX_AVX2_BINARY(add_avx2, _mm256_add_pd, +)
+MATRIX_AVX2_BINARY(sub_avx2, _mm256_sub_pd, -)
+
+__attribute__((target("avx2,fma")))
+void adds_avx2(std::size_t n, const double* a, double s, double* out) {
+    const __m256d vs = _mm256_set1_pd(s);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), vs));
+    for (; i < n; ++i) out[i] = a[i] + s;
+}
+
+__attribute__((target("avx2,fma")))
+void muls_avx2(std::size_t n, const double* a, double s, double* out) {
+    const __m256d vs = _mm256_set1_pd(s);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), vs));
+    for (; i < n; ++i) out[i] = a[i] * s;
+}
+
+__attribute__((target("avx2,fma")))
+void rsubs_avx2(std::size_t n, const double* a, double s, double* out) {
+    const __m256d vs = _mm256_set1_pd(s);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_sub_pd(vs, _mm256_loadu_pd(a + i)));
+    for (; i < n; ++i) out[i] = s - a[i];
+}
+
+#define MATRIX_AVX2_COMPARE(nazwa, predykat, przeciwny)                             \
+    __attribute__((target("avx2,fma")))                                             \
+    bool nazwa(std::size_t n, const double* a, const double* b) {                   \
+        std::size_t i = 0;                                                          \
+        for (; i + 4 <= n; i += 4)                                                  \
+            if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i),            \
+                                                 _mm256_loadu_pd(b + i), predykat))) \
+                return false;                                                       \
+        for (; i < n; ++i) if (a[i] przeciwny b[i]) return false;                   \
+        return true;                                                                \
+    }
+
+MATRIX_AVX2_COMPARE(eq_avx2, _CMP_NEQ_UQ, !=)
+MATRIX_AVX2_COMPARE(gt_avx2, _CMP_LE_OQ, <=)
+MATRIX_AVX2_COMPARE(lt_avx2, _CMP_GE_OQ, >=)
+
+/**
+ * @brief Jądro iloczynu int8 AVX2: MR wierszy × 16 kolumn (2·MR akumulatorów ymm)
+ */
+template <std::size_t MR>
+__attribute__((target("avx2,fma")))
+void gemm_i8_avx2_mr(std::size_t kp, std::size_t n,
+                     const std::int32_t* a, std::size_t lda,
+                     const std::int16_t* b, std::size_t ldb,
+                     std::int32_t* c, std::ptrdiff_t rsc) {
+    std::size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m256i acc[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            acc[r][0] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + r * rsc + j));
+            acc[r][1] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + r * rsc + j + 8));
+        }
+        for (std::size_t q = 0; q < kp; ++q) {
+            const std::int16_t* w = b + q * ldb + 2 * j;
+            const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w));
+            const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + 16));
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m256i va = _mm256_set1_epi32(a[r * lda + q]);
+                acc[r][0] = _mm256_add_epi32(acc[r][0], _mm256_madd_epi16(va, b0));
+                acc[r][1] = _mm256_add_epi32(acc[r][1], _mm256_madd_epi16(va, b1));
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + r * rsc + j), acc[r][0]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + r * rsc + j + 8), acc[r][1]);
+        }
+    }
+    gemm_i8_sse2_mr<MR>(kp, n - j, a, lda, b + 2 * j, ldb, c + j, rsc);
+}
+
+__attribute__((target("avx2,fma")))
+void gemm_i8_avx2(std::size_t mr, std::size_t kp, std::size_t n,
+                  const std::int32_t* a, std::size_t lda,
+                  const std::int16_t* b, std::size_t ldb,
+                  std::int32_t* c, std::ptrdiff_t rsc) {
+    switch (mr) {
+    case 4: gemm_i8_avx2_mr<4>(kp, n, a, lda, b, ldb, c, rsc); break;
+    case 3: gemm_i8_avx2_mr<3>(kp, n, a, lda, b, ldb, c, rsc); break;
+    case 2: gemm_i8_avx2_mr<2>(kp, n, a, lda, b, ldb, c, rsc); break;
+    case 1: gemm_i8_avx2_mr<1>(kp, n, a, lda, b, ldb, c, rsc); break;
+    default: break;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void axpy_avx2(std::size_t n, double a, const double* b, double* c) {
+    const __m256d va = _mm256_set1_pd(a);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(c + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(b + i), _mm256_loadu_pd(c + i)));
+    for (; i < n; ++i) c[i] = std::fma(a, b[i], c[i]);
+}
+
+__attribute__((target("avx2,fma")))
+void axpy_f32_avx2(std::size_t n, float a, const float* b, float* c) {
+    const __m256 va = _mm256_set1_ps(a);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(c + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(b + i), _mm256_loadu_ps(c + i)));
+    for (; i < n; ++i) c[i] = std::fma(a, b[i], c[i]);
+}
+
+/**
+ * @brief Jądra iloczynu float AVX2: MR wierszy × 16 kolumn w rejestrach
+ *
+ * W sumowaniu Kahana iloczyn i odjęcie poprzedniej poprawki są połączone
+ * w jedno FMS; same dodawania kompensowane są osobnymi instrukcjami.
+ */
+template <std::size_t MR>
+__attribute__((target("avx2,fma")))
+void gemm_f32_avx2_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                     const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    std::size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m256 acc[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            acc[r][0] = _mm256_loadu_ps(c + r * ldc + j);
+            acc[r][1] = _mm256_loadu_ps(c + r * ldc + j + 8);
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            const float* w = b + p * ldb + j;
+            const __m256 b0 = _mm256_loadu_ps(w);
+            const __m256 b1 = _mm256_loadu_ps(w + 8);
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m256 va = _mm256_set1_ps(a[r * lda + p]);
+                acc[r][0] = _mm256_fmadd_ps(va, b0, acc[r][0]);
+                acc[r][1] = _mm256_fmadd_ps(va, b1, acc[r][1]);
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            _mm256_storeu_ps(c + r * ldc + j, acc[r][0]);
+            _mm256_storeu_ps(c + r * ldc + j + 8, acc[r][1]);
+        }
+    }
+    gemm_f32_sse2_mr<MR>(kc, n - j, a, lda, b + j, ldb, c + j, ldc);
+}
+
+template <std::size_t MR>
+__attribute__((target("avx2,fma")))
+void gemm_f32_kahan_avx2_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                           const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    std::size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m256 suma[MR][2], popr[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            for (std::size_t v = 0; v < 2; ++v) {
+                suma[r][v] = _mm256_loadu_ps(s + r * ldc + j + v * 8);
+                popr[r][v] = _mm256_loadu_ps(k + r * ldc + j + v * 8);
+            }
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            const float* w = b + p * ldb + j;
+            const __m256 bv[2] = {_mm256_loadu_ps(w), _mm256_loadu_ps(w + 8)};
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m256 va = _mm256_set1_ps(a[r * lda + p]);
+#pragma GCC unroll 2
+                for (std::size_t v = 0; v < 2; ++v) {
+                    const __m256 y = _mm256_fmsub_ps(va, bv[v], popr[r][v]);
+                    const __m256 t = _mm256_add_ps(suma[r][v], y);
+                    popr[r][v] = _mm256_sub_ps(_mm256_sub_ps(t, suma[r][v]), y);
+                    suma[r][v] = t;
+                }
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            for (std::size_t v = 0; v < 2; ++v) {
+                _mm256_storeu_ps(s + r * ldc + j + v * 8, suma[r][v]);
+                _mm256_storeu_ps(k + r * ldc + j + v * 8, popr[r][v]);
+            }
+        }
+    }
+    gemm_f32_kahan_sse2_mr<MR>(kc, n - j, a, lda, b + j, ldb, s + j, k + j, ldc);
+}
+
+__attribute__((target("avx2,fma")))
+void gemm_f32_avx2(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                  const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    switch (mr) {
+    case 4: gemm_f32_avx2_mr<4>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 3: gemm_f32_avx2_mr<3>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 2: gemm_f32_avx2_mr<2>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 1: gemm_f32_avx2_mr<1>(kc, n, a, lda, b, ldb, c, ldc); break;
+    default: break;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void gemm_f32_kahan_avx2(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                        const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    switch (mr) {
+    case 4: gemm_f32_kahan_avx2_mr<4>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 3: gemm_f32_kahan_avx2_mr<3>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 2: gemm_f32_kahan_avx2_mr<2>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 1: gemm_f32_kahan_avx2_mr<1>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    default: break;
+    }
+}
+
+/**
+ * @brief Transpozycja 8-bajtowych elementów kafelkami 4 × 4
+ *
+ * UNPCKLPD / UNPCKHPD przeplatają pary wierszy w obrębie połówek
+ * 128-bitowych, a VPERM2F128 składa z połówek kolumny kafelka.
+ */
+__attribute__((target("avx2,fma")))
+void transpose_b64_avx2(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                        void* b, std::size_t ldb) {
+    transpose_kafelkami<4, std::uint64_t>(rows, cols, a, lda, b, ldb,
+        [](const std::uint64_t* z, std::size_t lz, std::uint64_t* w, std::size_t lw)
+            __attribute__((target("avx2,fma"))) {
+            const __m256d r0 = _mm256_loadu_pd(reinterpret_cast<const double*>(z));
+            const __m256d r1 = _mm256_loadu_pd(reinterpret_cast<const double*>(z + lz));
+            const __m256d r2 = _mm256_loadu_pd(reinterpret_cast<const double*>(z + 2 * lz));
+            const __m256d r3 = _mm256_loadu_pd(reinterpret_cast<const double*>(z + 3 * lz));
+            const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+            const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+            const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+            const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+            _mm256_storeu_pd(reinterpret_cast<double*>(w), _mm256_permute2f128_pd(t0, t2, 0x20));
+            _mm256_storeu_pd(reinterpret_cast<double*>(w + lw), _mm256_permute2f128_pd(t1, t3, 0x20));
+            _mm256_storeu_pd(reinterpret_cast<double*>(w + 2 * lw), _mm256_permute2f128_pd(t0, t2, 0x31));
+            _mm256_storeu_pd(reinterpret_cast<double*>(w + 3 * lw), _mm256_permute2f128_pd(t1, t3, 0x31));
+        });
+}
+
+/**
+ * @brief Transpozycja 4-bajtowych elementów kafelkami 8 × 8
+ *
+ * Klasyczny schemat w trzech krokach: UNPCKLPS / UNPCKHPS (pary wierszy),
+ * SHUFPS (czwórki) i VPERM2F128 (zamiana połówek 128-bitowych).
+ */
+__attribute__((target("avx2,fma")))
+void transpose_b32_avx2(std::size_t rows, std::size_t cols, const void* a, std::size_t lda,
+                        void* b, std::size_t ldb) {
+    transpose_kafelkami<8, std::uint32_t>(rows, cols, a, lda, b, ldb,
+        [](const std::uint32_t* z, std::size_t lz, std::uint32_t* w, std::size_t lw)
+            __attribute__((target("avx2,fma"))) {
+            __m256 r[8], t[8];
+#pragma GCC unroll 8
+            for (int i = 0; i < 8; ++i) r[i] = _mm256_loadu_ps(reinterpret_cast<const float*>(z + i * lz));
+#pragma GCC unroll 4
+            for (int i = 0; i < 8; i += 2) {
+                t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+                t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+            }
+#pragma GCC unroll 2
+            for (int i = 0; i < 8; i += 4) {
+                r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+                r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+                r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+                r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+            }
+#pragma GCC unroll 4
+            for (int i = 0; i < 4; ++i) {
+                _mm256_storeu_ps(reinterpret_cast<float*>(w + i * lw), _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+                _mm256_storeu_ps(reinterpret_cast<float*>(w + (i + 4) * lw), _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+            }
+        });
+}
+
+/**
+ * @brief Philox4x32-10 dla 8 bloków naraz
+ *
+ * Jak wariant SSE2, ale połówki iloczynów linii parzystych i nieparzystych
+ * są składane jedną instrukcją VPBLENDD.
+ */
+__attribute__((target("avx2,fma")))
+void philox_avx2(std::size_t n, std::uint64_t licznik, std::uint64_t strumien,
+                 std::uint64_t klucz, std::uint64_t* out) {
+    philox_grupami<8>(n, licznik, strumien, klucz, out,
+        [&](std::uint64_t l, std::uint64_t* w) __attribute__((target("avx2,fma"))) {
+            const __m256i m0 = _mm256_set1_epi32(static_cast<int>(philox_m0));
+            const __m256i m1 = _mm256_set1_epi32(static_cast<int>(philox_m1));
+            auto mulhilo = [](__m256i a, __m256i m, __m256i& lo, __m256i& hi) __attribute__((target("avx2,fma"))) {
+                const __m256i p = _mm256_mul_epu32(a, m);                         // linie parzyste
+                const __m256i q = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);  // linie nieparzyste
+                lo = _mm256_blend_epi32(p, _mm256_slli_epi64(q, 32), 0xAA);
+                hi = _mm256_blend_epi32(_mm256_srli_epi64(p, 32), q, 0xAA);
+            };
+            const std::uint32_t l0 = static_cast<std::uint32_t>(l);
+            __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(l0)),
+                                          _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+            __m256i c1 = _mm256_set1_epi32(static_cast<int>(l >> 32));
+            __m256i c2 = _mm256_set1_epi32(static_cast<int>(strumien));
+            __m256i c3 = _mm256_set1_epi32(static_cast<int>(strumien >> 32));
+            std::uint32_t k0 = static_cast<std::uint32_t>(klucz), k1 = static_cast<std::uint32_t>(klucz >> 32);
+            for (int r = 0; r < 10; ++r) {
+                if (r) {
+                    k0 += philox_w0;
+                    k1 += philox_w1;
+                }
+                __m256i lo0, hi0, lo1, hi1;
+                mulhilo(c0, m0, lo0, hi0);
+                mulhilo(c2, m1, lo1, hi1);
+                c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+                c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+                c1 = lo1;
+                c3 = lo0;
+            }
+            // Bloki 0, 1 | 4, 5 i 2, 3 | 6, 7 w polowkach 128-bitowych - VPERM2I128 ustawia je po kolei
+            const __m256i a = _mm256_unpacklo_epi32(c0, c1), b = _mm256_unpackhi_epi32(c0, c1);
+            const __m256i x = _mm256_unpacklo_epi32(c2, c3), y = _mm256_unpackhi_epi32(c2, c3);
+            const __m256i p = _mm256_unpacklo_epi64(a, x), q = _mm256_unpackhi_epi64(a, x);
+            const __m256i r = _mm256_unpacklo_epi64(b, y), t = _mm256_unpackhi_epi64(b, y);
+            __m256i* o = reinterpret_cast<__m256i*>(w);
+            _mm256_storeu_si256(o, _mm256_permute2x128_si256(p, q, 0x20));
+            _mm256_storeu_si256(o + 1, _mm256_permute2x128_si256(r, t, 0x20));
+            _mm256_storeu_si256(o + 2, _mm256_permute2x128_si256(p, q, 0x31));
+            _mm256_storeu_si256(o + 3, _mm256_permute2x128_si256(r, t, 0x31));
+        });
+}
+
+const simd_kernels jadra_avx2 = {
+    isa::avx2, "avx2", 6, 8, gemm_micro_avx2, batch_gemm_avx2,
+    add_avx2, sub_avx2, adds_avx2, muls_avx2, rsubs_avx2,
+    eq_avx2, gt_avx2, lt_avx2, gemm_i8_avx2,
+    axpy_avx2, axpy_f32_avx2, gemm_f32_avx2, gemm_f32_kahan_avx2,
+    transpose_b64_avx2, transpose_b32_avx2, philox_avx2
+};
+
+// ---------------------------------------------------------------------------
+// AVX-512F - 8 double na rejestr, końcówki obsługiwane maskami
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Mikro-jądro AVX-512 8 × 16 (16 akumulatorów zmm)
+ */
+__attribute__((target("avx512f")))
+void gemm_micro_avx512(std::size_t kc, const double* a, const double* b,
+                       double* c, std::ptrdiff_t rsc) {
+    __m512d acc[8][2];
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i) {
+        acc[i][0] = _mm512_setzero_pd();
+        acc[i][1] = _mm512_setzero_pd();
+    }
+    for (std::size_t p = 0; p < kc; ++p) {
+        const __m512d b0 = _mm512_load_pd(b);
+        const __m512d b1 = _mm512_load_pd(b + 8);
+#pragma GCC unroll 8
+        for (int i = 0; i < 8; ++i) {
+            const __m512d ai = _mm512_set1_pd(a[i]);
+            acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += 8;
+        b += 16;
+    }
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i) {
+        double* ci = c + i * rsc;
+        _mm512_storeu_pd(ci, _mm512_add_pd(_mm512_loadu_pd(ci), acc[i][0]));
+        _mm512_storeu_pd(ci + 8, _mm512_add_pd(_mm512_loadu_pd(ci + 8), acc[i][1]));
+    }
+}
+
+/**
+ * @brief Wsadowe mnożenie AVX-512: osiem macierzy na rejestr, gather i scatter
+ */
+__attribute__((target("avx512f")))
+void batch_gemm_avx512(std::size_t count, std::size_t m, std::size_t n, std::size_t k,
+                       const double* a, const double* b, double* c) {
+    const long long sa = static_cast<long long>(m * k);
+    const long long sb = static_cast<long long>(k * n);
+    const long long sc = static_cast<long long>(m * n);
+    const __m512i ia = _mm512_set_epi64(7 * sa, 6 * sa, 5 * sa, 4 * sa, 3 * sa, 2 * sa, sa, 0);
+    const __m512i ib = _mm512_set_epi64(7 * sb, 6 * sb, 5 * sb, 4 * sb, 3 * sb, 2 * sb, sb, 0);
+    const __m512i ic = _mm512_set_epi64(7 * sc, 6 * sc, 5 * sc, 4 * sc, 3 * sc, 2 * sc, sc, 0);
+    const __m512d zero = _mm512_setzero_pd();
+    __m512d va[simd_batch_max * simd_batch_max];
+    __m512d vb[simd_batch_max * simd_batch_max];
+    std::size_t g = 0;
+    for (; g + 8 <= count; g += 8) {
+        // Gather z maska i jawnym zrodlem - wersja bez maski wywoluje falszywe
+        // ostrzezenie -Wmaybe-uninitialized w naglowkach GCC 12
+        for (long long e = 0; e < sa; ++e) va[e] = _mm512_mask_i64gather_pd(zero, 0xFF, ia, a + e, 8);
+        for (long long e = 0; e < sb; ++e) vb[e] = _mm512_mask_i64gather_pd(zero, 0xFF, ib, b + e, 8);
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                __m512d acc = _mm512_setzero_pd();
+                for (std::size_t p = 0; p < k; ++p) {
+                    acc = _mm512_fmadd_pd(va[i * k + p], vb[p * n + j], acc);
+                }
+                _mm512_i64scatter_pd(c + i * n + j, ic, acc, 8);
+            }
+        }
+        a += 8 * sa;
+        b += 8 * sb;
+        c += 8 * sc;
+    }
+    batch_gemm_scalar(count - g, m, n, k, a, b, c);
+}
+
+__attribute__((target("avx512f")))
+inline __mmask8 maska_konca(std::size_t reszta) {
+    return static_cast<__mmask8>((1u << reszta) - 1u);
+}
+
+#define MATRIX_AVX512_BINARY(nazwa, op_wek)                                          \
+    __attribute__((target("avx512f")))                                              \
+    void nazwa(std::size_t n, const double* a, const double* b, double* out) {      \
+        std::size_t i = 0;                                                          \
+        for (; i + 8 <= n; i += 8)                                                  \
+            _mm512_storeu_pd(out + i,                                               \
+                             op_wek(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i))); \
+        if (i < n) {                                                                \
+            const __mmask8 m = maska_konca(n - i);                                  \
+            _mm512_mask_storeu_pd(out + i, m,                                       \
+                                  op_wek(_mm512_maskz_loadu_pd(m, a + i),           \
+                                         _mm512_maskz_loadu_pd(m, b + i)));         \
+        }                                                                           \
+    }
+
+MATRIX_AVX512_BINARY(add_avx512, _mm512_add_pd)
+MATRIX_AVX512_BINARY(sub_avx512, _mm512_sub_pd)
+
+#define MATRIX_AVX512_SCALAR(nazwa, wyrazenie)                                       \
+    __attribute__((target("avx512f")))                                              \
+    void nazwa(std::size_t n, const double* a, double s, double* out) {             \
+        const __m512d vs = _mm512_set1_pd(s);                                       \
+        std::size_t i = 0;                                                          \
+        for (; i + 8 <= n; i += 8) {                                                \
+            const __m512d va = _mm512_loadu_pd(a + i);                              \
+            _mm512_storeu_pd(out + i, wyrazenie);                                   \
+        }                                                                           \
+        if (i < n) {                                                                \
+            const __mmask8 m = maska_konca(n - i);                                  \
+            const __m512d va = _mm512_maskz_loadu_pd(m, a + i);                     \
+            _mm512_mask_storeu_pd(out + i, m, wyrazenie);                           \
+        }                                                                           \
+    }
+
+MATRIX_AVX512_SCALAR(adds_avx512, _mm512_add_pd(va, vs))
+MATRIX_AVX512_SCALAR(muls_avx512, _mm512_mul_pd(va, vs))
+MATRIX_AVX512_SCALAR(rsubs_avx512, _mm512_sub_pd(vs, va))
+
+#define MATRIX_AVX512_COMPARE(nazwa, predykat)                                       \
+    __attribute__((target("avx512f")))                                              \
+    bool nazwa(std::size_t n, const double* a, const double* b) {                   \
+        std::size_t i = 0;                                                          \
+        for (; i + 8 <= n; i += 8)                                                  \
+            if (_mm512_cmp_pd_mask(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), predykat)) \
+                return false;                                                       \
+        if (i < n) {                                                                \
+            const __mmask8 m = maska_konca(n - i);                                  \
+            if (_mm512_mask_cmp_pd_mask(m, _mm512_maskz_loadu_pd(m, a + i),         \
+                                        _mm512_maskz_loadu_pd(m, b + i), predykat)) \
+                return false;                                                       \
+        }                                                                           \
+        return true;                                                                \
+    }
+
+MATRIX_AVX512_COMPARE(eq_avx512, _CMP_NEQ_UQ)
+MATRIX_AVX512_COMPARE(gt_avx512, _CMP_LE_OQ)
+MATRIX_AVX512_COMPARE(lt_avx512, _CMP_GE_OQ)
+
+__attribute__((target("avx512f")))
+inline __mmask16 maska_konca_f32(std::size_t reszta) {
+    return static_cast<__mmask16>((1u << reszta) - 1u);
+}
+
+__attribute__((target("avx512f")))
+void axpy_avx512(std::size_t n, double a, const double* b, double* c) {
+    const __m512d va = _mm512_set1_pd(a);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(c + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(b + i), _mm512_loadu_pd(c + i)));
+    if (i < n) {
+        const __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(c + i, m, _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(m, b + i),
+                                                        _mm512_maskz_loadu_pd(m, c + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+void axpy_f32_avx512(std::size_t n, float a, const float* b, float* c) {
+    const __m512 va = _mm512_set1_ps(a);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(c + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(b + i), _mm512_loadu_ps(c + i)));
+    if (i < n) {
+        const __mmask16 m = maska_konca_f32(n - i);
+        _mm512_mask_storeu_ps(c + i, m, _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, b + i),
+                                                        _mm512_maskz_loadu_ps(m, c + i)));
+    }
+}
+
+/// Jadra iloczynu float AVX-512: MR wierszy x 32 kolumny w rejestrach
+template <std::size_t MR>
+__attribute__((target("avx512f")))
+void gemm_f32_avx512_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                     const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    std::size_t j = 0;
+    for (; j + 32 <= n; j += 32) {
+        __m512 acc[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            acc[r][0] = _mm512_loadu_ps(c + r * ldc + j);
+            acc[r][1] = _mm512_loadu_ps(c + r * ldc + j + 16);
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            const float* w = b + p * ldb + j;
+            const __m512 b0 = _mm512_loadu_ps(w);
+            const __m512 b1 = _mm512_loadu_ps(w + 16);
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m512 va = _mm512_set1_ps(a[r * lda + p]);
+                acc[r][0] = _mm512_fmadd_ps(va, b0, acc[r][0]);
+                acc[r][1] = _mm512_fmadd_ps(va, b1, acc[r][1]);
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            _mm512_storeu_ps(c + r * ldc + j, acc[r][0]);
+            _mm512_storeu_ps(c + r * ldc + j + 16, acc[r][1]);
+        }
+    }
+    gemm_f32_avx2_mr<MR>(kc, n - j, a, lda, b + j, ldb, c + j, ldc);
+}
+
+template <std::size_t MR>
+__attribute__((target("avx512f")))
+void gemm_f32_kahan_avx512_mr(std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                           const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    std::size_t j = 0;
+    for (; j + 32 <= n; j += 32) {
+        __m512 suma[MR][2], popr[MR][2];
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            for (std::size_t v = 0; v < 2; ++v) {
+                suma[r][v] = _mm512_loadu_ps(s + r * ldc + j + v * 16);
+                popr[r][v] = _mm512_loadu_ps(k + r * ldc + j + v * 16);
+            }
+        }
+        for (std::size_t p = 0; p < kc; ++p) {
+            const float* w = b + p * ldb + j;
+            const __m512 bv[2] = {_mm512_loadu_ps(w), _mm512_loadu_ps(w + 16)};
+#pragma GCC unroll 4
+            for (std::size_t r = 0; r < MR; ++r) {
+                const __m512 va = _mm512_set1_ps(a[r * lda + p]);
+#pragma GCC unroll 2
+                for (std::size_t v = 0; v < 2; ++v) {
+                    const __m512 y = _mm512_fmsub_ps(va, bv[v], popr[r][v]);
+                    const __m512 t = _mm512_add_ps(suma[r][v], y);
+                    popr[r][v] = _mm512_sub_ps(_mm512_sub_ps(t, suma[r][v]), y);
+                    suma[r][v] = t;
+                }
+            }
+        }
+#pragma GCC unroll 4
+        for (std::size_t r = 0; r < MR; ++r) {
+            for (std::size_t v = 0; v < 2; ++v) {
+                _mm512_storeu_ps(s + r * ldc + j + v * 16, suma[r][v]);
+                _mm512_storeu_ps(k + r * ldc + j + v * 16, popr[r][v]);
+            }
+        }
+    }
+    gemm_f32_kahan_avx2_mr<MR>(kc, n - j, a, lda, b + j, ldb, s + j, k + j, ldc);
+}
+
+__attribute__((target("avx512f")))
+void gemm_f32_avx512(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                  const float* b, std::size_t ldb, float* c, std::size_t ldc) {
+    switch (mr) {
+    case 4: gemm_f32_avx512_mr<4>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 3: gemm_f32_avx512_mr<3>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 2: gemm_f32_avx512_mr<2>(kc, n, a, lda, b, ldb, c, ldc); break;
+    case 1: gemm_f32_avx512_mr<1>(kc, n, a, lda, b, ldb, c, ldc); break;
+    default: break;
+    }
+}
+
+__attribute__((target("avx512f")))
+void gemm_f32_kahan_avx512(std::size_t mr, std::size_t kc, std::size_t n, const float* a, std::size_t lda,
+                        const float* b, std::size_t ldb, float* s, float* k, std::size_t ldc) {
+    switch (mr) {
+    case 4: gemm_f32_kahan_avx512_mr<4>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 3: gemm_f32_kahan_avx512_mr<3>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 2: gemm_f32_kahan_avx512_mr<2>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    case 1: gemm_f32_kahan_avx512_mr<1>(kc, n, a, lda, b, ldb, s, k, ldc); break;
+    default: break;
+    }
+}
+
+// Calkowitoliczbowe intrinsics AVX-512 w GCC 12 przekazuja jako zrodlo
+// _mm512_undefined_epi32(), co -Wuninitialized zglasza falszywie
+// (GCC PR 105593); wynik nie zalezy od tego rejestru
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+/// @brief Mlodsze i starsze 32 bity iloczynow a * m na 16 liniach
+__attribute__((target("avx512f")))
+inline void philox_mulhilo_avx512(__m512i a, __m512i m, __m512i& lo, __m512i& hi) {
+    const __m512i p = _mm512_mul_epu32(a, m);                         // linie parzyste
+    const __m512i q = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), m);  // linie nieparzyste
+    lo = _mm512_mask_blend_epi32(0xAAAA, p, _mm512_slli_epi64(q, 32));
+    hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(p, 32), q);
+}
+
+/// @brief 16 blokow Philox4x32-10 o licznikach l .. l + 15 zapisanych po kolei do w
+__attribute__((target("avx512f")))
+void philox16_avx512(std::uint64_t l, std::uint64_t strumien, std::uint64_t klucz, std::uint64_t* w) {
+    const __m512i m0 = _mm512_set1_epi32(static_cast<int>(philox_m0));
+    const __m512i m1 = _mm512_set1_epi32(static_cast<int>(philox_m1));
+    __m512i c0 = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(l))),
+                                  _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    __m512i c1 = _mm512_set1_epi32(static_cast<int>(l >> 32));
+    __m512i c2 = _mm512_set1_epi32(static_cast<int>(strumien));
+    __m512i c3 = _mm512_set1_epi32(static_cast<int>(strumien >> 32));
+    std::uint32_t k0 = static_cast<std::uint32_t>(klucz), k1 = static_cast<std::uint32_t>(klucz >> 32);
+    for (int r = 0; r < 10; ++r) {
+        if (r) {
+            k0 += philox_w0;
+            k1 += philox_w1;
+        }
+        __m512i lo0, hi0, lo1, hi1;
+        philox_mulhilo_avx512(c0, m0, lo0, hi0);
+        philox_mulhilo_avx512(c2, m1, lo1, hi1);
+        c0 = _mm512_xor_si512(_mm512_xor_si512(hi1, c1), _mm512_set1_epi32(static_cast<int>(k0)));
+        c2 = _mm512_xor_si512(_mm512_xor_si512(hi0, c3), _mm512_set1_epi32(static_cast<int>(k1)));
+        c1 = lo1;
+        c3 = lo0;
+    }
+    // p, q, r, t: bloki 0|4|8|12, 1|5|9|13, 2|6|10|14, 3|7|11|15 w cwiartkach
+    const __m512i a = _mm512_unpacklo_epi32(c0, c1), b = _mm512_unpackhi_epi32(c0, c1);
+    const __m512i x = _mm512_unpacklo_epi32(c2, c3), y = _mm512_unpackhi_epi32(c2, c3);
+    const __m512i p = _mm512_unpacklo_epi64(a, x), q = _mm512_unpackhi_epi64(a, x);
+    const __m512i r = _mm512_unpacklo_epi64(b, y), t = _mm512_unpackhi_epi64(b, y);
+    const __m512i u = _mm512_shuffle_i64x2(p, q, _MM_SHUFFLE(2, 0, 2, 0));  // 0, 8, 1, 9
+    const __m512i v = _mm512_shuffle_i64x2(p, q, _MM_SHUFFLE(3, 1, 3, 1));  // 4, 12, 5, 13
+    const __m512i e = _mm512_shuffle_i64x2(r, t, _MM_SHUFFLE(2, 0, 2, 0));  // 2, 10, 3, 11
+    const __m512i f = _mm512_shuffle_i64x2(r, t, _MM_SHUFFLE(3, 1, 3, 1));  // 6, 14, 7, 15
+    _mm512_storeu_si512(w, _mm512_shuffle_i64x2(u, e, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm512_storeu_si512(w + 8, _mm512_shuffle_i64x2(v, f, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm512_storeu_si512(w + 16, _mm512_shuffle_i64x2(u, e, _MM_SHUFFLE(3, 1, 3, 1)));
+    _mm512_storeu_si512(w + 24, _mm512_shuffle_i64x2(v, f, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+#pragma GCC diagnostic pop
+
+/**
+ * @brief Philox4x32-10 dla 16 bloków naraz
+ *
+ * Połówki iloczynów składa maskowany VPBLENDMD, a na końcu bloki są
+ * ustawiane po kolei transpozycją 128-bitowych ćwiartek (VSHUFI64X2).
+ */
+__attribute__((target("avx512f")))
+void philox_avx512(std::size_t n, std::uint64_t licznik, std::uint64_t strumien,
+                   std::uint64_t klucz, std::uint64_t* out) {
+    philox_grupami<16>(n, licznik, strumien, klucz, out, [&](std::uint64_t l, std::uint64_t* w) {
+        philox16_avx512(l, strumien, klucz, w);
+    });
+}
+
+const simd_kernels jadra_avx512 = {
+    isa::avx512, "avx512", 8, 16, gemm_micro_avx512, batch_gemm_avx512,
+    add_avx512, sub_avx512, adds_avx512, muls_avx512, rsubs_avx512,
+    eq_avx512, gt_avx512, lt_avx512,
+    // 512-bitowy VPMADDWD wymaga AVX-512BW, ktorego poziom avx512 nie zaklada
+    gemm_i8_avx2,
+    axpy_avx512, axpy_f32_avx512, gemm_f32_avx512, gemm_f32_kahan_avx512,
+    // Transpozycja jest ograniczona przepustowoscia pamieci, kafelki ymm w zupelnosci wystarczaja
+    transpose_b64_avx2, transpose_b32_avx2,
+    philox_avx512
+};
+
+#endif // MATRIX_X86_SIMD
+
+/**
+ * @brief Wybiera najszerszy zestaw instrukcji dostępny na tym procesorze
+ *
+ * Korzysta z `__builtin_cpu_supports` (CPUID + XGETBV, więc uwzględnia
+ * także to, czy system operacyjny zapisuje rejestry AVX przy przełączaniu
+ * kontekstu). Zmienna `MATRIX_ISA` może jedynie obniżyć poziom -
+ * żądanie instrukcji, których procesor nie ma, jest ignorowane.
+ */
+const simd_kernels& wybierz_jadra() noexcept {
+    const simd_kernels* najlepsze = &jadra_scalar;
+#ifdef MATRIX_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) najlepsze = &jadra_sse2;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        najlepsze = &jadra_avx2;
+        // tablica avx512 wywoluje tez jadra AVX2+FMA (gemm_i8, transpozycja)
+        if (__builtin_cpu_supports("avx512f")) najlepsze = &jadra_avx512;
+    }
+#endif
+    if (const char* wymuszone = std::getenv("MATRIX_ISA")) {
+        const simd_kernels* wszystkie[] = {
+            &jadra_scalar,
+#ifdef MATRIX_X86_SIMD
+            &jadra_sse2, &jadra_avx2, &jadra_avx512,
+#endif
+        };
+        for (const simd_kernels* k : wszystkie) {
+            if (std::strcmp(k->nazwa, wymuszone) == 0 && k->poziom <= najlepsze->poziom) {
+                najlepsze = k;
+            }
+        }
+    }
+    return *najlepsze;
+}
+
+/// Wybór wykonywany podczas inicjalizacji statycznej, czyli przy starcie programu.
+[[maybe_unused]] const simd_kernels& jadra_startowe = kernels();
+
+} // namespace
+
+const simd_kernels& kernels() noexcept {
+    static const simd_kernels& wybrane = wybierz_jadra();
+    return wybrane;
+}
+
+} // namespace detail
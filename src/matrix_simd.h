@@ -0,0 +1,141 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// @file matrix_simd.h
+/// @brief Jadra SIMD wybierane w czasie wykonania na podstawie CPUID
+///
+/// Biblioteka jest kompilowana bez flag `-march`, aby jeden plik wykonywalny
+/// dzialal na kazdym procesorze x86-64. Wersje jader dla SSE2, AVX2+FMA
+/// i AVX-512 sa kompilowane obok siebie (atrybut `target`), a przy starcie
+/// programu wybierany jest najszerszy zestaw instrukcji obslugiwany przez CPU.
+/// Zmienna srodowiskowa `MATRIX_ISA` (scalar, sse2, avx2, avx512) pozwala
+/// wymusic slabszy wariant, np. przy porownywaniu wynikow.
+
+/// Warianty x86 (atrybut `target`, intrinsics) sa kompilowane tylko dla GCC
+/// i Clang na x86; na innych architekturach zostaja jadra skalarne.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIX_X86_SIMD 1
+#endif
+
+namespace detail {
+
+/// @brief Zestaw instrukcji uzywany przez jadra
+enum class isa { scalar, sse2, avx2, avx512 };
+
+/// @brief Tablica wskaznikow na jadra dla jednego zestawu instrukcji
+struct simd_kernels {
+    /// @brief Zestaw instrukcji tej tablicy
+    isa poziom;
+
+    /// @brief Nazwa zestawu instrukcji (do diagnostyki)
+    const char* nazwa;
+
+    /// @brief Liczba wierszy kafelka mikro-jadra GEMM
+    std::size_t mr;
+
+    /// @brief Liczba kolumn kafelka mikro-jadra GEMM
+    std::size_t nr;
+
+    /// @brief Mikro-jadro GEMM: C[mr x nr] += A_pack[mr x kc] * B_pack[kc x nr]
+    void (*gemm_micro)(std::size_t kc, const double* a_pack, const double* b_pack,
+                       double* c, std::ptrdiff_t rsc);
+
+    /// @brief Wsadowe mnozenie malych macierzy: C[g] = A[g] * B[g] dla g < count
+    /// Macierze wsadu leza kolejno w pamieci, kazda wierszami bez odstepow.
+    /// Wymaga m, n, k <= simd_batch_max.
+    void (*batch_gemm)(std::size_t count, std::size_t m, std::size_t n, std::size_t k,
+                       const double* a, const double* b, double* c);
+
+    /// @brief out[i] = a[i] + b[i]
+    void (*add)(std::size_t n, const double* a, const double* b, double* out);
+
+    /// @brief out[i] = a[i] - b[i]
+    void (*sub)(std::size_t n, const double* a, const double* b, double* out);
+
+    /// @brief out[i] = a[i] + s
+    void (*add_scalar)(std::size_t n, const double* a, double s, double* out);
+
+    /// @brief out[i] = a[i] * s
+    void (*mul_scalar)(std::size_t n, const double* a, double s, double* out);
+
+    /// @brief out[i] = s - a[i]
+    void (*rsub_scalar)(std::size_t n, const double* a, double s, double* out);
+
+    /// @brief Prawda, jesli a[i] == b[i] dla kazdego i
+    bool (*all_eq)(std::size_t n, const double* a, const double* b);
+
+    /// @brief Prawda, jesli zaden element nie spelnia a[i] <= b[i]
+    bool (*all_gt)(std::size_t n, const double* a, const double* b);
+
+    /// @brief Prawda, jesli zaden element nie spelnia a[i] >= b[i]
+    bool (*all_lt)(std::size_t n, const double* a, const double* b);
+
+    /// @brief Iloczyn int8: C[mr x n] += A[mr x kp par] * B[kp par x n] (mr <= simd_i8_mr)
+    /// Wspolny wymiar jest podzielony na pary; a[r * lda + q] zawiera dwa elementy
+    /// wiersza r macierzy A jako int16 (mlodsza polowa - A[r][2q], starsza -
+    /// A[r][2q + 1]), a wiersz q bufora b (co ldb elementow) - przeplecione pary
+    /// (B[2q][j], B[2q + 1][j]), jak dla instrukcji PMADDWD.
+    void (*gemm_i8)(std::size_t mr, std::size_t kp, std::size_t n,
+                    const std::int32_t* a, std::size_t lda,
+                    const std::int16_t* b, std::size_t ldb,
+                    std::int32_t* c, std::ptrdiff_t rsc);
+
+    /// @brief c[i] += a * b[i] (z FMA, jesli dostepne)
+    void (*axpy)(std::size_t n, double a, const double* b, double* c);
+
+    /// @brief c[i] += a * b[i] na liczbach float (z FMA, jesli dostepne)
+    void (*axpy_f32)(std::size_t n, float a, const float* b, float* c);
+
+    /// @brief Iloczyn float: C[mr x n] += A[mr x kc] * B[kc x n] (mr <= simd_f32_mr)
+    /// Kazdy element C jest sumowany kolejno po wspolnym wymiarze, a akumulatory
+    /// pozostaja w rejestrach przez cale kc. Wiersze A, B i C sa co lda, ldb, ldc.
+    void (*gemm_f32)(std::size_t mr, std::size_t kc, std::size_t n,
+                     const float* a, std::size_t lda, const float* b, std::size_t ldb,
+                     float* c, std::size_t ldc);
+
+    /// @brief Jak gemm_f32, z sumowaniem Kahana: S += A * B, K - poprawki (wiersze co ldc)
+    void (*gemm_f32_kahan)(std::size_t mr, std::size_t kc, std::size_t n,
+                           const float* a, std::size_t lda, const float* b, std::size_t ldb,
+                           float* s, float* k, std::size_t ldc);
+
+    /// @brief Transpozycja bloku elementow 8-bajtowych: b[j * ldb + i] = a[i * lda + j]
+    /// dla i < rows, j < cols (lda, ldb w elementach). Elementy sa kopiowane
+    /// bitowo, wiec to samo jadro sluzy dla double i int64. Pelne kafelki
+    /// sa transponowane w rejestrach. Bloki nie moga sie nakladac.
+    void (*transpose_b64)(std::size_t rows, std::size_t cols,
+                          const void* a, std::size_t lda, void* b, std::size_t ldb);
+
+    /// @brief Jak transpose_b64 dla elementow 4-bajtowych (float, int32)
+    void (*transpose_b32)(std::size_t rows, std::size_t cols,
+                          const void* a, std::size_t lda, void* b, std::size_t ldb);
+
+    /// @brief Generator licznikowy Philox4x32-10 dla n kolejnych blokow
+    /// Blok i ma licznik (licznik + i, strumien) i klucz `klucz`; jego slowa
+    /// w0..w3 trafiaja do out[2i] = w1:w0 i out[2i + 1] = w3:w2. Wynik
+    /// zalezy tylko od argumentow, wiec kazdy fragment strumienia mozna
+    /// wygenerowac niezaleznie (na dowolnym watku).
+    void (*philox)(std::size_t n, std::uint64_t licznik, std::uint64_t strumien,
+                   std::uint64_t klucz, std::uint64_t* out);
+};
+
+/// @brief Maksymalne mr sposrod wszystkich mikro-jader (rozmiar buforow brzegowych)
+constexpr std::size_t simd_mr_max = 8;
+
+/// @brief Maksymalne nr sposrod wszystkich mikro-jader (rozmiar buforow brzegowych)
+constexpr std::size_t simd_nr_max = 16;
+
+/// @brief Maksymalna liczba wierszy A przetwarzanych naraz przez gemm_i8
+constexpr std::size_t simd_i8_mr = 4;
+
+/// @brief Maksymalna liczba wierszy A przetwarzanych naraz przez gemm_f32 i gemm_f32_kahan
+constexpr std::size_t simd_f32_mr = 4;
+
+/// @brief Maksymalny wymiar macierzy obslugiwany przez batch_gemm
+constexpr std::size_t simd_batch_max = 8;
+
+/// @brief Zwraca jadra wybrane dla biezacego procesora
+/// Wybor odbywa sie raz, przy starcie programu.
+const simd_kernels& kernels() noexcept;
+
+} // namespace detail
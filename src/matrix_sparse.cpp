@@ -0,0 +1,607 @@
+#include "../include/sparse_matrix.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+using index_type = sparse_matrix::index_type;
+
+/// @brief Rzuca wyjatek, jesli wymiar poboczny nie miesci sie w index_type
+void sprawdz_wymiar(std::size_t rows, std::size_t cols, sparse_format f) {
+    const std::size_t poboczny = f == sparse_format::csr ? cols : rows;
+    if (poboczny > std::numeric_limits<index_type>::max())
+        throw std::runtime_error("Wymiar macierzy rzadkiej przekracza zakres indeksów");
+}
+
+/// @brief Srednia liczba elementow w wierszu (kolumnie) jako praca dla parallel_rows
+std::size_t na_wiersz(std::size_t nnz, std::size_t wiersze) noexcept {
+    return wiersze ? nnz / wiersze + 1 : 1;
+}
+
+/**
+ * @brief Buduje macierz rzadką w dwóch przebiegach po wymiarze głównym
+ *
+ * Pierwszy przebieg, `policz(r)`, zwraca liczbę elementów wiersza r; po sumie
+ * prefiksowej znane jest położenie każdego wiersza w tablicach wyniku, więc
+ * drugi przebieg, `wypelnij(r, indeksy, wartosci)`, zapisuje wiersze
+ * niezależnie. Oba przebiegi są dzielone między wątki puli.
+ *
+ * @param praca praca na wiersz (dla thread_pool::parallel_rows)
+ */
+template <typename Policz, typename Wypelnij>
+sparse_matrix zbuduj(std::size_t rows, std::size_t cols, sparse_format f, std::size_t praca,
+                     Policz policz, Wypelnij wypelnij) {
+    const std::size_t glowny = f == sparse_format::csr ? rows : cols;
+    std::vector<std::size_t> wskazniki(glowny + 1, 0);
+    thread_pool::instance().parallel_rows(glowny, praca, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t r = r0; r < r1; ++r) wskazniki[r + 1] = policz(r);
+    });
+    std::partial_sum(wskazniki.begin(), wskazniki.end(), wskazniki.begin());
+
+    std::vector<index_type> indeksy(wskazniki.back());
+    std::vector<double> wartosci(wskazniki.back());
+    thread_pool::instance().parallel_rows(glowny, praca, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t r = r0; r < r1; ++r) {
+            wypelnij(r, indeksy.data() + wskazniki[r], wartosci.data() + wskazniki[r]);
+        }
+    });
+    return sparse_matrix(rows, cols, std::move(wskazniki), std::move(indeksy), std::move(wartosci), f);
+}
+
+/**
+ * @brief Element po elemencie dla dwóch macierzy w tym samym formacie
+ *
+ * Indeksy w wierszu są posortowane, więc wiersze są scalane jednym
+ * przejściem dwoma wskaźnikami. Dla `suma` wynik ma elementy obu struktur
+ * (brakujący operand to zero), w przeciwnym razie - tylko wspólne.
+ */
+template <bool suma, typename F>
+sparse_matrix scal(const sparse_matrix& A, const sparse_matrix& B, F f) {
+    const auto& pa = A.pointers();
+    const auto& ia = A.indices();
+    const auto& va = A.values();
+    const auto& pb = B.pointers();
+    const auto& ib = B.indices();
+    const auto& vb = B.values();
+
+    // Przejscie po wierszu r; zapisz(indeks, wartosc) dla kazdego elementu wyniku
+    auto przejdz = [&](std::size_t r, auto zapisz) {
+        std::size_t p = pa[r], q = pb[r];
+        const std::size_t pk = pa[r + 1], qk = pb[r + 1];
+        while (p < pk && q < qk) {
+            if (ia[p] == ib[q]) {
+                zapisz(ia[p], f(va[p], vb[q]));
+                ++p;
+                ++q;
+            } else if (ia[p] < ib[q]) {
+                if (suma) zapisz(ia[p], f(va[p], 0.0));
+                ++p;
+            } else {
+                if (suma) zapisz(ib[q], f(0.0, vb[q]));
+                ++q;
+            }
+        }
+        if (suma) {
+            for (; p < pk; ++p) zapisz(ia[p], f(va[p], 0.0));
+            for (; q < qk; ++q) zapisz(ib[q], f(0.0, vb[q]));
+        }
+    };
+    return zbuduj(A.get_rows(), A.get_cols(), A.format(), na_wiersz(A.nnz() + B.nnz(), pa.size() - 1),
+                  [&](std::size_t r) {
+                      std::size_t n = 0;
+                      przejdz(r, [&](index_type, double) { ++n; });
+                      return n;
+                  },
+                  [&](std::size_t r, index_type* indeksy, double* wartosci) {
+                      przejdz(r, [&](index_type j, double v) {
+                          *indeksy++ = j;
+                          *wartosci++ = v;
+                      });
+                  });
+}
+
+/// @brief B w formacie A (bez kopii, jesli formaty sa zgodne)
+const sparse_matrix& w_formacie(const sparse_matrix& A, const sparse_matrix& B, sparse_matrix& bufor) {
+    if (B.format() == A.format()) return B;
+    bufor = A.format() == sparse_format::csr ? B.to_csr() : B.to_csc();
+    return bufor;
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor macierzy zerowej
+ *
+ * @throw std::runtime_error jeśli wymiar poboczny przekracza zakres index_type
+ */
+sparse_matrix::sparse_matrix(std::size_t r, std::size_t c, sparse_format f)
+    : rows(r), cols(c), uklad(f) {
+    sprawdz_wymiar(rows, cols, uklad);
+    wskazniki.assign(glowny() + 1, 0);
+}
+
+/**
+ * @brief Konstruktor z gotowych tablic
+ *
+ * Sprawdza w O(nnz), że wskaźniki są niemalejące i zgodne z długością
+ * tablic, a indeksy w wierszu (kolumnie) ściśle rosnące i mniejsze od
+ * wymiaru pobocznego. Pozostałe operacje polegają na tych warunkach.
+ *
+ * @throw std::runtime_error jeśli tablice nie opisują poprawnej macierzy
+ */
+sparse_matrix::sparse_matrix(std::size_t r, std::size_t c, std::vector<std::size_t> w,
+                             std::vector<index_type> i, std::vector<double> v, sparse_format f)
+    : rows(r), cols(c), uklad(f), wskazniki(std::move(w)), indeksy(std::move(i)), wartosci(std::move(v)) {
+    sprawdz_wymiar(rows, cols, uklad);
+    const std::size_t poboczny = uklad == sparse_format::csr ? cols : rows;
+    bool poprawna = wskazniki.size() == glowny() + 1 && wskazniki.front() == 0 &&
+                    wskazniki.back() == indeksy.size() && indeksy.size() == wartosci.size();
+    for (std::size_t k = 0; poprawna && k < glowny(); ++k) {
+        const std::size_t p0 = wskazniki[k], p1 = wskazniki[k + 1];
+        poprawna = p0 <= p1 && p1 <= indeksy.size();
+        for (std::size_t p = p0; poprawna && p < p1; ++p) {
+            poprawna = indeksy[p] < poboczny && (p == p0 || indeksy[p - 1] < indeksy[p]);
+        }
+    }
+    if (!poprawna)
+        throw std::runtime_error("Nieprawidłowa struktura macierzy rzadkiej");
+}
+
+/**
+ * @brief Konstruktor z macierzy gęstej
+ *
+ * Wiersze są przeglądane dwa razy (liczenie i zapis), równolegle. Format
+ * CSC powstaje z CSR przez przestaw(), aby czytać macierz gęstą wierszami.
+ *
+ * @complexity O(n × m)
+ */
+sparse_matrix::sparse_matrix(const matrix& m, sparse_format f) {
+    const std::size_t n = m.get_cols();
+    sparse_matrix csr = zbuduj(m.get_rows(), n, sparse_format::csr, n,
+        [&](std::size_t i) {
+            const double* x = m.row_ptr(i);
+            std::size_t ile = 0;
+            for (std::size_t j = 0; j < n; ++j) ile += x[j] != 0.0;
+            return ile;
+        },
+        [&](std::size_t i, index_type* indeksy, double* wartosci) {
+            const double* x = m.row_ptr(i);
+            for (std::size_t j = 0; j < n; ++j) {
+                if (x[j] != 0.0) {
+                    *indeksy++ = static_cast<index_type>(j);
+                    *wartosci++ = x[j];
+                }
+            }
+        });
+    *this = f == sparse_format::csr ? std::move(csr) : csr.przestaw();
+}
+
+/**
+ * @brief Konstruktor z listy elementów
+ *
+ * Elementy są rozkładane kubełkowo według wymiaru głównego, a każdy
+ * wiersz (kolumna) sortowany stabilnie według indeksu pobocznego;
+ * powtórzenia sumowane są w kolejności podania.
+ *
+ * @throw std::runtime_error jeśli indeks elementu wykracza poza wymiary
+ *
+ * @complexity O(nnz × log(nnz wiersza))
+ *
+ * @example
+ * @code
+ * // Graf skierowany 0 -> 1, 1 -> 2, 2 -> 0
+ * sparse_matrix G(3, 3, {{0, 1, 1.0}, {1, 2, 1.0}, {2, 0, 1.0}});
+ * std::vector<double> y = G * std::vector<double>{1.0, 2.0, 3.0};  // {2, 3, 1}
+ * @endcode
+ */
+sparse_matrix::sparse_matrix(std::size_t r, std::size_t c, const std::vector<sparse_entry>& elementy,
+                             sparse_format f) {
+    sprawdz_wymiar(r, c, f);
+    const bool csr = f == sparse_format::csr;
+    const std::size_t glowny = csr ? r : c;
+    std::vector<std::size_t> poczatki(glowny + 1, 0);
+    for (const sparse_entry& e : elementy) {
+        if (e.row >= r || e.col >= c)
+            throw std::runtime_error("Indeks elementu poza zakresem macierzy");
+        ++poczatki[(csr ? e.row : e.col) + 1];
+    }
+    std::partial_sum(poczatki.begin(), poczatki.end(), poczatki.begin());
+
+    std::vector<std::pair<index_type, double>> pary(elementy.size());
+    std::vector<std::size_t> wolne(poczatki.begin(), poczatki.end() - 1);
+    for (const sparse_entry& e : elementy) {
+        const std::size_t glowna = csr ? e.row : e.col;
+        pary[wolne[glowna]++] = {static_cast<index_type>(csr ? e.col : e.row), e.value};
+    }
+
+    auto pierwszy = [](const std::pair<index_type, double>& a, const std::pair<index_type, double>& b) {
+        return a.first < b.first;
+    };
+    *this = zbuduj(r, c, f, na_wiersz(elementy.size(), glowny),
+        [&](std::size_t k) {
+            auto p0 = pary.begin() + poczatki[k], p1 = pary.begin() + poczatki[k + 1];
+            std::stable_sort(p0, p1, pierwszy);
+            std::size_t ile = 0;
+            for (auto p = p0; p != p1; ++p) ile += p == p0 || (p - 1)->first != p->first;
+            return ile;
+        },
+        [&](std::size_t k, index_type* indeksy, double* wartosci) {
+            for (std::size_t p = poczatki[k]; p < poczatki[k + 1]; ++p) {
+                if (p > poczatki[k] && pary[p - 1].first == pary[p].first) {
+                    wartosci[-1] += pary[p].second;
+                } else {
+                    *indeksy++ = pary[p].first;
+                    *wartosci++ = pary[p].second;
+                }
+            }
+        });
+}
+
+/**
+ * @brief Element (i, j)
+ *
+ * @complexity O(log(nnz wiersza))
+ */
+double sparse_matrix::operator()(std::size_t i, std::size_t j) const noexcept {
+    const bool csr = uklad == sparse_format::csr;
+    const std::size_t k = csr ? i : j;
+    const index_type szukany = static_cast<index_type>(csr ? j : i);
+    auto p0 = indeksy.begin() + wskazniki[k], p1 = indeksy.begin() + wskazniki[k + 1];
+    auto p = std::lower_bound(p0, p1, szukany);
+    return p != p1 && *p == szukany ? wartosci[p - indeksy.begin()] : 0.0;
+}
+
+/**
+ * @brief Ta sama macierz w przeciwnym formacie
+ *
+ * Sortowanie kubełkowe według indeksu pobocznego: wiersze źródła
+ * przeglądane są po kolei, więc indeksy w każdym kubełku powstają
+ * już posortowane.
+ *
+ * @complexity O(nnz + n + m)
+ */
+sparse_matrix sparse_matrix::przestaw() const {
+    const sparse_format cel = uklad == sparse_format::csr ? sparse_format::csc : sparse_format::csr;
+    const std::size_t poboczny = uklad == sparse_format::csr ? cols : rows;
+    std::vector<std::size_t> w(poboczny + 1, 0);
+    for (index_type j : indeksy) ++w[j + 1];
+    std::partial_sum(w.begin(), w.end(), w.begin());
+
+    std::vector<index_type> i(nnz());
+    std::vector<double> v(nnz());
+    std::vector<std::size_t> wolne(w.begin(), w.end() - 1);
+    for (std::size_t k = 0; k < glowny(); ++k) {
+        for (std::size_t p = wskazniki[k]; p < wskazniki[k + 1]; ++p) {
+            const std::size_t cel_p = wolne[indeksy[p]]++;
+            i[cel_p] = static_cast<index_type>(k);
+            v[cel_p] = wartosci[p];
+        }
+    }
+    return sparse_matrix(rows, cols, std::move(w), std::move(i), std::move(v), cel);
+}
+
+/// @brief Ta sama macierz w formacie CSR
+sparse_matrix sparse_matrix::to_csr() const {
+    return uklad == sparse_format::csr ? *this : przestaw();
+}
+
+/// @brief Ta sama macierz w formacie CSC
+sparse_matrix sparse_matrix::to_csc() const {
+    return uklad == sparse_format::csc ? *this : przestaw();
+}
+
+/**
+ * @brief Macierz transponowana
+ *
+ * @complexity O(nnz) - kopia tablic bez przestawiania
+ */
+sparse_matrix sparse_matrix::transpose() const {
+    sparse_matrix t = *this;
+    std::swap(t.rows, t.cols);
+    t.uklad = uklad == sparse_format::csr ? sparse_format::csc : sparse_format::csr;
+    return t;
+}
+
+/**
+ * @brief Zamiana na macierz gęstą
+ *
+ * @complexity O(n × m + nnz)
+ */
+matrix sparse_matrix::to_matrix() const {
+    matrix wynik(rows, cols);
+    const bool csr = uklad == sparse_format::csr;
+    // Rownolegle po wymiarze glownym: kazdy element wyniku zapisuje jeden watek
+    thread_pool::instance().parallel_rows(glowny(), na_wiersz(nnz(), glowny()), [&](std::size_t k0, std::size_t k1) {
+        for (std::size_t k = k0; k < k1; ++k) {
+            for (std::size_t p = wskazniki[k]; p < wskazniki[k + 1]; ++p) {
+                if (csr) wynik(k, indeksy[p]) = wartosci[p];
+                else     wynik(indeksy[p], k) = wartosci[p];
+            }
+        }
+    });
+    return wynik;
+}
+
+/// @brief Mnożenie przez skalar w miejscu
+sparse_matrix& sparse_matrix::operator*=(double s) noexcept {
+    detail::kernels().mul_scalar(wartosci.size(), wartosci.data(), s, wartosci.data());
+    return *this;
+}
+
+/**
+ * @brief Iloczyn macierzy rzadkiej i wektora - A * x
+ *
+ * - CSR: każdy wątek liczy iloczyny skalarne swojego zakresu wierszy;
+ * - CSC: kolumny dzielone są między wątki, każdy sumuje do własnego wektora
+ *   częściowego, a wektory są potem dodawane równolegle po wierszach.
+ *
+ * @throw std::runtime_error jeśli x.size() != A.cols
+ *
+ * @complexity O(nnz + n)
+ */
+std::vector<double> operator*(const sparse_matrix& A, const std::vector<double>& x) {
+    if (A.get_cols() != x.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const auto& w = A.pointers();
+    const auto& idx = A.indices();
+    const auto& val = A.values();
+    const std::size_t m = A.get_rows(), n = A.get_cols();
+    std::vector<double> y(m, 0.0);
+    thread_pool& pula = thread_pool::instance();
+
+    if (A.format() == sparse_format::csr) {
+        pula.parallel_rows(m, na_wiersz(A.nnz(), m), [&](std::size_t r0, std::size_t r1) {
+            for (std::size_t i = r0; i < r1; ++i) {
+                double s = 0.0;
+                for (std::size_t p = w[i]; p < w[i + 1]; ++p) s += val[p] * x[idx[p]];
+                y[i] = s;
+            }
+        });
+        return y;
+    }
+
+    auto rozrzuc = [&](std::size_t j0, std::size_t j1, double* cel) {
+        for (std::size_t j = j0; j < j1; ++j) {
+            for (std::size_t p = w[j]; p < w[j + 1]; ++p) cel[idx[p]] += val[p] * x[j];
+        }
+    };
+    if (!pula.should_parallelize(A.nnz() + m)) {
+        rozrzuc(0, n, y.data());
+        return y;
+    }
+    const std::size_t watki = pula.get_threads();
+    std::vector<double> czesciowe(watki * m, 0.0);
+    pula.parallel_for(watki, [&](std::size_t t) {
+        rozrzuc(n * t / watki, n * (t + 1) / watki, czesciowe.data() + t * m);
+    });
+    pula.parallel_rows(m, watki, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t t = 0; t < watki; ++t) {
+            const double* z = czesciowe.data() + t * m;
+            for (std::size_t i = r0; i < r1; ++i) y[i] += z[i];
+        }
+    });
+    return y;
+}
+
+/**
+ * @brief Iloczyn macierzy rzadkiej i gęstej - A * B
+ *
+ * Wiersz i wyniku to suma wierszy B przemnożonych przez niezerowe A(i, p)
+ * (axpy jądrem SIMD), liczona równolegle po wierszach. Macierz CSC jest
+ * najpierw zamieniana na CSR (O(nnz)).
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ *
+ * @complexity O(nnz(A) × B.cols)
+ */
+matrix operator*(const sparse_matrix& A, const matrix& B) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    sparse_matrix bufor;
+    const sparse_matrix& a = A.format() == sparse_format::csr ? A : (bufor = A.to_csr());
+    const auto& w = a.pointers();
+    const auto& idx = a.indices();
+    const auto& val = a.values();
+    const std::size_t m = a.get_rows(), n = B.get_cols();
+    const auto& jadra = detail::kernels();
+
+    matrix wynik(m, n);
+    thread_pool::instance().parallel_rows(m, na_wiersz(a.nnz(), m) * n, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            double* c = wynik.row_ptr(i);
+            for (std::size_t p = w[i]; p < w[i + 1]; ++p) jadra.axpy(n, val[p], B.row_ptr(idx[p]), c);
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn macierzy gęstej i rzadkiej - A * B
+ *
+ * Równolegle po wierszach A:
+ * - B w CSR: wiersze B przemnożone przez A(i, p) rozrzucane są do wiersza i wyniku;
+ * - B w CSC: C(i, j) to iloczyn skalarny wiersza i macierzy A z kolumną j macierzy B.
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ *
+ * @complexity O(A.rows × (nnz(B) + B.cols))
+ */
+matrix operator*(const matrix& A, const sparse_matrix& B) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const auto& w = B.pointers();
+    const auto& idx = B.indices();
+    const auto& val = B.values();
+    const std::size_t m = A.get_rows(), n = B.get_cols();
+    const bool csr = B.format() == sparse_format::csr;
+
+    matrix wynik(m, n);
+    thread_pool::instance().parallel_rows(m, B.nnz() + n, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* a = A.row_ptr(i);
+            double* c = wynik.row_ptr(i);
+            if (csr) {
+                for (std::size_t p = 0; p < B.get_rows(); ++p) {
+                    for (std::size_t q = w[p]; q < w[p + 1]; ++q) c[idx[q]] += a[p] * val[q];
+                }
+            } else {
+                for (std::size_t j = 0; j < n; ++j) {
+                    double s = 0.0;
+                    for (std::size_t q = w[j]; q < w[j + 1]; ++q) s += a[idx[q]] * val[q];
+                    c[j] = s;
+                }
+            }
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn macierzy rzadkich - A * B (algorytm Gustavsona)
+ *
+ * Oba operandy są sprowadzane do CSR. Wiersz i wyniku to suma wierszy B
+ * wskazanych przez elementy wiersza i macierzy A; kolumny zbierane są
+ * w gęstym akumulatorze wątku ze znacznikami odwiedzin (bez zerowania
+ * między wierszami - znacznik to numer przebiegu). Pierwszy przebieg
+ * liczy elementy wierszy wyniku, drugi sumuje wartości i sortuje indeksy.
+ *
+ * @throw std::runtime_error jeśli A.cols != B.rows
+ *
+ * @complexity O(liczba iloczynów A(i, p) · B(p, j) + nnz(C) log)
+ *
+ * @example
+ * @code
+ * sparse_matrix G2 = G * G;  // ścieżki długości 2 w grafie
+ * @endcode
+ */
+sparse_matrix operator*(const sparse_matrix& A, const sparse_matrix& B) {
+    if (A.get_cols() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    sparse_matrix bufor_a, bufor_b;
+    const sparse_matrix& a = A.format() == sparse_format::csr ? A : (bufor_a = A.to_csr());
+    const sparse_matrix& b = B.format() == sparse_format::csr ? B : (bufor_b = B.to_csr());
+    const auto& wa = a.pointers();
+    const auto& ia = a.indices();
+    const auto& va = a.values();
+    const auto& wb = b.pointers();
+    const auto& ib = b.indices();
+    const auto& vb = b.values();
+    const std::size_t m = a.get_rows(), k = a.get_cols(), n = b.get_cols();
+
+    struct akumulator {
+        std::vector<std::size_t> znacznik;
+        std::vector<double> suma;
+        std::size_t przebieg = 0;
+    };
+    auto przygotuj = [n]() -> akumulator& {
+        thread_local akumulator acc;
+        if (acc.znacznik.size() < n) {
+            acc.znacznik.resize(n, 0);
+            acc.suma.resize(n);
+        }
+        ++acc.przebieg;
+        return acc;
+    };
+
+    return zbuduj(m, n, sparse_format::csr, na_wiersz(a.nnz(), m) * na_wiersz(b.nnz(), k),
+        [&](std::size_t i) {
+            akumulator& acc = przygotuj();
+            std::size_t ile = 0;
+            for (std::size_t p = wa[i]; p < wa[i + 1]; ++p) {
+                for (std::size_t q = wb[ia[p]]; q < wb[ia[p] + 1]; ++q) {
+                    if (acc.znacznik[ib[q]] != acc.przebieg) {
+                        acc.znacznik[ib[q]] = acc.przebieg;
+                        ++ile;
+                    }
+                }
+            }
+            return ile;
+        },
+        [&](std::size_t i, index_type* indeksy, double* wartosci) {
+            akumulator& acc = przygotuj();
+            index_type* koniec = indeksy;
+            for (std::size_t p = wa[i]; p < wa[i + 1]; ++p) {
+                const double x = va[p];
+                for (std::size_t q = wb[ia[p]]; q < wb[ia[p] + 1]; ++q) {
+                    const index_type j = ib[q];
+                    if (acc.znacznik[j] != acc.przebieg) {
+                        acc.znacznik[j] = acc.przebieg;
+                        acc.suma[j] = x * vb[q];
+                        *koniec++ = j;
+                    } else {
+                        acc.suma[j] += x * vb[q];
+                    }
+                }
+            }
+            std::sort(indeksy, koniec);
+            for (index_type* j = indeksy; j != koniec; ++j) *wartosci++ = acc.suma[*j];
+        });
+}
+
+/**
+ * @brief Suma macierzy rzadkich
+ *
+ * Operand w innym formacie niż A jest najpierw przestawiany. Elementy,
+ * które zsumowały się do zera, pozostają zapamiętane.
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają
+ *
+ * @complexity O(nnz(A) + nnz(B))
+ */
+sparse_matrix operator+(const sparse_matrix& A, const sparse_matrix& B) {
+    if (A.get_rows() != B.get_rows() || A.get_cols() != B.get_cols())
+        throw std::runtime_error("Nieprawidłowe wymiary dla dodawania");
+    sparse_matrix bufor;
+    return scal<true>(A, w_formacie(A, B, bufor), [](double x, double y) { return x + y; });
+}
+
+/**
+ * @brief Różnica macierzy rzadkich
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają
+ *
+ * @complexity O(nnz(A) + nnz(B))
+ */
+sparse_matrix operator-(const sparse_matrix& A, const sparse_matrix& B) {
+    if (A.get_rows() != B.get_rows() || A.get_cols() != B.get_cols())
+        throw std::runtime_error("Nieprawidłowe wymiary dla odejmowania");
+    sparse_matrix bufor;
+    return scal<true>(A, w_formacie(A, B, bufor), [](double x, double y) { return x - y; });
+}
+
+/// @brief Macierz przeciwna
+sparse_matrix operator-(sparse_matrix A) {
+    A *= -1.0;
+    return A;
+}
+
+/// @brief Mnożenie przez skalar
+sparse_matrix operator*(sparse_matrix A, double s) {
+    A *= s;
+    return A;
+}
+
+/// @brief Mnożenie przez skalar
+sparse_matrix operator*(double s, sparse_matrix A) {
+    A *= s;
+    return A;
+}
+
+/**
+ * @brief Iloczyn Hadamarda macierzy rzadkich
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają
+ *
+ * @complexity O(nnz(A) + nnz(B))
+ */
+sparse_matrix hadamard(const sparse_matrix& A, const sparse_matrix& B) {
+    if (A.get_rows() != B.get_rows() || A.get_cols() != B.get_cols())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+    sparse_matrix bufor;
+    return scal<false>(A, w_formacie(A, B, bufor), [](double x, double y) { return x * y; });
+}
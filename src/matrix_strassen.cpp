@@ -0,0 +1,164 @@
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+
+namespace detail {
+
+namespace {
+
+/// @brief Funkcja jadra element po elemencie: out = a (op) b
+using jadro_ew = void (*)(std::size_t, const double*, const double*, double*);
+
+/// @brief Odstep wierszy bufora roboczego: kolumny zaokraglone do linii cache
+std::size_t wyrownaj(std::size_t kolumny) noexcept {
+    return (kolumny + 7) / 8 * 8;
+}
+
+/**
+ * @brief out = a (op) b dla bloków rows × cols o dowolnych odstępach wierszy
+ *
+ * Wiersze bloków są ciągłe, więc każdy wiersz to jedno wywołanie jądra SIMD.
+ * `out` może być jednym z operandów.
+ */
+void ew(jadro_ew f, std::size_t rows, std::size_t cols,
+        const double* a, std::ptrdiff_t rsa,
+        const double* b, std::ptrdiff_t rsb,
+        double* out, std::ptrdiff_t rso) {
+    thread_pool::instance().parallel_rows(rows, cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            f(cols, a + i * rsa, b + i * rsb, out + i * rso);
+        }
+    });
+}
+
+/**
+ * @brief Rozmiar przestrzeni roboczej dla wszystkich poziomów rekurencji
+ *
+ * Każdy poziom potrzebuje dwóch buforów: X (m/2 × max(k/2, n/2)) na sumy
+ * ćwiartek A oraz iloczyn P1, i Y (k/2 × n/2) na sumy ćwiartek B.
+ * Suma po poziomach nie przekracza 1/3 rozmiaru operandów.
+ */
+std::size_t rozmiar_roboczy(std::size_t m, std::size_t n, std::size_t k, std::size_t prog) noexcept {
+    std::size_t suma = 0;
+    while (std::min({m, n, k}) > prog && std::min({m, n, k}) >= 2) {
+        m /= 2;
+        n /= 2;
+        k /= 2;
+        suma += m * wyrownaj(std::max(k, n)) + k * wyrownaj(n);
+    }
+    return suma;
+}
+
+/**
+ * @brief Jeden poziom Strassena-Winograda: C = A * B
+ *
+ * Kolejność 22 kroków pochodzi z pracy Boyer, Dumas, Pernet, Zhou
+ * "Memory efficient scheduling of Strassen-Winograd's matrix multiplication
+ * algorithm" (ISSAC 2009): siedem iloczynów ćwiartek i piętnaście
+ * dodawań korzysta tylko z ćwiartek C i dwóch buforów X, Y.
+ */
+void winograd(std::size_t m, std::size_t n, std::size_t k,
+              const double* a, std::ptrdiff_t rsa,
+              const double* b, std::ptrdiff_t rsb,
+              double* c, std::ptrdiff_t rsc,
+              std::size_t prog, double* ws) {
+    if (std::min({m, n, k}) <= prog || std::min({m, n, k}) < 2) {
+        gemm(m, n, k, 1.0, a, rsa, 1, b, rsb, 1, 0.0, c, rsc);
+        return;
+    }
+
+    const simd_kernels& jadra = kernels();
+    const jadro_ew add = jadra.add, sub = jadra.sub;
+
+    const std::size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+    const double* a11 = a;
+    const double* a12 = a + k2;
+    const double* a21 = a + m2 * rsa;
+    const double* a22 = a21 + k2;
+    const double* b11 = b;
+    const double* b12 = b + n2;
+    const double* b21 = b + k2 * rsb;
+    const double* b22 = b21 + n2;
+    double* c11 = c;
+    double* c12 = c + n2;
+    double* c21 = c + m2 * rsc;
+    double* c22 = c21 + n2;
+
+    const std::ptrdiff_t ldx = static_cast<std::ptrdiff_t>(wyrownaj(std::max(k2, n2)));
+    const std::ptrdiff_t ldy = static_cast<std::ptrdiff_t>(wyrownaj(n2));
+    double* x = ws;
+    double* y = x + m2 * ldx;
+    double* dalej = y + k2 * ldy;
+
+    auto iloczyn = [&](const double* l, std::ptrdiff_t rsl, const double* r, std::ptrdiff_t rsr,
+                       double* out, std::ptrdiff_t rso) {
+        winograd(m2, n2, k2, l, rsl, r, rsr, out, rso, prog, dalej);
+    };
+
+    ew(sub, m2, k2, a11, rsa, a21, rsa, x, ldx);        //  1. S3 = A11 - A21
+    ew(sub, k2, n2, b22, rsb, b12, rsb, y, ldy);        //  2. T3 = B22 - B12
+    iloczyn(x, ldx, y, ldy, c21, rsc);                  //  3. P7 = S3 * T3
+    ew(add, m2, k2, a21, rsa, a22, rsa, x, ldx);        //  4. S1 = A21 + A22
+    ew(sub, k2, n2, b12, rsb, b11, rsb, y, ldy);        //  5. T1 = B12 - B11
+    iloczyn(x, ldx, y, ldy, c22, rsc);                  //  6. P5 = S1 * T1
+    ew(sub, m2, k2, x, ldx, a11, rsa, x, ldx);          //  7. S2 = S1 - A11
+    ew(sub, k2, n2, b22, rsb, y, ldy, y, ldy);          //  8. T2 = B22 - T1
+    iloczyn(x, ldx, y, ldy, c12, rsc);                  //  9. P6 = S2 * T2
+    ew(sub, m2, k2, a12, rsa, x, ldx, x, ldx);          // 10. S4 = A12 - S2
+    iloczyn(x, ldx, b22, rsb, c11, rsc);                // 11. P3 = S4 * B22
+    iloczyn(a11, rsa, b11, rsb, x, ldx);                // 12. P1 = A11 * B11
+    ew(add, m2, n2, x, ldx, c12, rsc, c12, rsc);        // 13. U2 = P1 + P6
+    ew(add, m2, n2, c12, rsc, c21, rsc, c21, rsc);      // 14. U3 = U2 + P7
+    ew(add, m2, n2, c12, rsc, c22, rsc, c12, rsc);      // 15. U4 = U2 + P5
+    ew(add, m2, n2, c21, rsc, c22, rsc, c22, rsc);      // 16. U7 = U3 + P5 -> C22
+    ew(add, m2, n2, c12, rsc, c11, rsc, c12, rsc);      // 17. U5 = U4 + P3 -> C12
+    ew(sub, k2, n2, y, ldy, b21, rsb, y, ldy);          // 18. T4 = T2 - B21
+    iloczyn(a22, rsa, y, ldy, c11, rsc);                // 19. P4 = A22 * T4
+    ew(sub, m2, n2, c21, rsc, c11, rsc, c21, rsc);      // 20. U6 = U3 - P4 -> C21
+    iloczyn(a12, rsa, b21, rsb, c11, rsc);              // 21. P2 = A12 * B21
+    ew(add, m2, n2, x, ldx, c11, rsc, c11, rsc);        // 22. U1 = P1 + P2 -> C11
+
+    // Nieparzyste wymiary: poprawki klasycznym algorytmem dla odcietego wiersza/kolumny
+    const std::size_t M = 2 * m2, N = 2 * n2, K = 2 * k2;
+    if (K != k) {
+        gemm(M, N, 1, 1.0, a + K, rsa, 1, b + K * rsb, rsb, 1, 1.0, c, rsc);
+    }
+    if (N != n) {
+        gemm(M, 1, k, 1.0, a, rsa, 1, b + N, rsb, 1, 0.0, c + N, rsc);
+    }
+    if (M != m) {
+        gemm(1, n, k, 1.0, a + M * rsa, rsa, 1, b, rsb, 1, 0.0, c + M * rsc, rsc);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Mnożenie metodą Strassena-Winograda: C = A * B
+ *
+ * Każdy poziom rekurencji zastępuje 8 mnożeń ćwiartek siedmioma
+ * (kosztem 15 dodawań), co daje złożoność O(n^2.807). Iloczyny na dnie
+ * rekurencji liczone są blokowym, wielowątkowym gemm(), a dodawania
+ * ćwiartek jądrami SIMD.
+ *
+ * Przestrzeń robocza jest lokalna dla wątku, alokowana jednorazowo na
+ * rozmiar potrzebny wszystkim poziomom i wielokrotnie używana.
+ *
+ * @complexity O(n^2.807) dla n > prog_przejscia
+ */
+void gemm_strassen(std::size_t m, std::size_t n, std::size_t k,
+                   const double* a, std::ptrdiff_t rsa,
+                   const double* b, std::ptrdiff_t rsb,
+                   double* c, std::ptrdiff_t rsc,
+                   std::size_t prog_przejscia) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+    thread_local bufor_roboczy przestrzen;
+    const std::size_t prog = std::max<std::size_t>(prog_przejscia, 1);
+    double* ws = przestrzen.zapewnij(std::max<std::size_t>(rozmiar_roboczy(m, n, k, prog), 1));
+    winograd(m, n, k, a, rsa, b, rsb, c, rsc, prog, ws);
+}
+
+} // namespace detail
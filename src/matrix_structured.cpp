@@ -0,0 +1,779 @@
+#include "../include/structured_matrix.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+/// @brief Rzuca wyjatek, jesli macierz gesta nie jest kwadratowa
+void wymagaj_kwadratowej(const matrix& m) {
+    if (m.get_rows() != m.get_cols())
+        throw std::runtime_error("Macierz musi być kwadratowa");
+}
+
+/// @brief Liczba wierszy kafelka wyniku w syrk() i bloku wierszy w iloczynie S * M
+constexpr std::size_t kafel_wierszy = detail::gemm_mc;
+
+/// @brief Liczba kolumn kafelka wyniku w syrk()
+constexpr std::size_t kafel_kolumn = 4 * detail::gemm_mc;
+
+/// @brief Ponizej tej dlugosci wiersza petla jest szybsza niz wywolanie jadra SIMD
+constexpr std::size_t krotki_wiersz = 8;
+
+/// @brief dst[j] += a * src[j] dla j < m
+inline void dodaj_wiersz(const detail::simd_kernels& jadra, std::size_t m, double a,
+                         const double* src, double* dst) {
+    if (m < krotki_wiersz) {
+        for (std::size_t j = 0; j < m; ++j) dst[j] += a * src[j];
+    } else {
+        jadra.axpy(m, a, src, dst);
+    }
+}
+
+/**
+ * @brief Rozkład LU macierzy pasmowej z wyborem elementu głównego (jak LAPACK gbtrf)
+ *
+ * Zamiana wierszy przesuwa górne pasmo o kl przekątnych, więc wiersz i
+ * zajmuje kolumny i - kl .. i + kl + ku. Mnożniki eliminacji zapisywane są
+ * w miejscu eliminowanych elementów; późniejsze zamiany dotyczą tylko
+ * kolumn na prawo od nich, więc zostają w swoich wierszach.
+ */
+struct rozklad_pasmowy {
+    std::size_t n, kl, ku, szerokosc;
+    std::vector<double> lu;
+    std::vector<std::size_t> piwoty;
+
+    double& operator()(std::size_t i, std::size_t j) { return lu[i * szerokosc + j + kl - i]; }
+    double operator()(std::size_t i, std::size_t j) const { return lu[i * szerokosc + j + kl - i]; }
+
+    explicit rozklad_pasmowy(const banded_matrix& A)
+        : n(A.size()), kl(A.lower()), ku(A.upper()), szerokosc(2 * A.lower() + A.upper() + 1),
+          lu(n * szerokosc, 0.0), piwoty(n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t j0 = i > kl ? i - kl : 0, j1 = std::min(n, i + ku + 1);
+            for (std::size_t j = j0; j < j1; ++j) (*this)(i, j) = A(i, j);
+        }
+        const auto& jadra = detail::kernels();
+        for (std::size_t c = 0; c < n; ++c) {
+            const std::size_t ostatni = std::min(n - 1, c + kl);
+            const std::size_t koniec = std::min(n, c + kl + ku + 1);
+            std::size_t p = c;
+            for (std::size_t r = c + 1; r <= ostatni; ++r) {
+                if (std::fabs((*this)(r, c)) > std::fabs((*this)(p, c))) p = r;
+            }
+            if ((*this)(p, c) == 0.0)
+                throw std::runtime_error("Macierz jest osobliwa");
+            piwoty[c] = p;
+            if (p != c) {
+                for (std::size_t j = c; j < koniec; ++j) std::swap((*this)(c, j), (*this)(p, j));
+            }
+            for (std::size_t r = c + 1; r <= ostatni; ++r) {
+                const double l = (*this)(r, c) / (*this)(c, c);
+                (*this)(r, c) = l;
+                dodaj_wiersz(jadra, koniec - c - 1, -l, &(*this)(c, c + 1), &(*this)(r, c + 1));
+            }
+        }
+    }
+
+    /// @brief Rozwiazanie w miejscu dla m kolumn prawej strony (wiersze x co ldx)
+    void rozwiaz(double* x, std::size_t ldx, std::size_t m) const {
+        const auto& jadra = detail::kernels();
+        for (std::size_t c = 0; c < n; ++c) {
+            double* xc = x + c * ldx;
+            if (piwoty[c] != c) std::swap_ranges(xc, xc + m, x + piwoty[c] * ldx);
+            const std::size_t ostatni = std::min(n - 1, c + kl);
+            for (std::size_t r = c + 1; r <= ostatni; ++r) {
+                dodaj_wiersz(jadra, m, -(*this)(r, c), xc, x + r * ldx);
+            }
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            double* xi = x + i * ldx;
+            const std::size_t koniec = std::min(n, i + kl + ku + 1);
+            for (std::size_t j = i + 1; j < koniec; ++j) {
+                dodaj_wiersz(jadra, m, -(*this)(i, j), x + j * ldx, xi);
+            }
+            const double u = (*this)(i, i);
+            for (std::size_t j = 0; j < m; ++j) xi[j] /= u;
+        }
+    }
+};
+
+/**
+ * @brief Podstawianie dla macierzy trójkątnej w miejscu: T * X = B
+ *
+ * Wiersz i rozwiązania to (B_i - suma T(i, p) · X_p) / T(i, i) po już
+ * obliczonych wierszach p; sumy liczone są jako axpy na m kolumnach.
+ */
+void podstaw(const triangular_matrix& T, double* x, std::size_t ldx, std::size_t m) {
+    const auto& jadra = detail::kernels();
+    const std::size_t n = T.size();
+    const bool dolna = T.kind() == triangle::lower;
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t i = dolna ? k : n - 1 - k;
+        const double* t = T.packed_row(i) - T.row_begin(i);
+        double* xi = x + i * ldx;
+        const std::size_t p0 = dolna ? 0 : i + 1, p1 = dolna ? i : n;
+        for (std::size_t p = p0; p < p1; ++p) dodaj_wiersz(jadra, m, -t[p], x + p * ldx, xi);
+        for (std::size_t j = 0; j < m; ++j) xi[j] /= t[i];
+    }
+}
+
+/// @brief Rzuca wyjatek, jesli T ma zero na przekatnej
+void wymagaj_nieosobliwej(const triangular_matrix& T) {
+    for (std::size_t i = 0; i < T.size(); ++i) {
+        if (T(i, i) == 0.0)
+            throw std::runtime_error("Macierz jest osobliwa");
+    }
+}
+
+/// @brief Rzuca wyjatek, jesli macierze trojkatne maja rozne wymiary lub rodzaje
+void wymagaj_zgodnych(const triangular_matrix& A, const triangular_matrix& B, const char* komunikat) {
+    if (A.size() != B.size())
+        throw std::runtime_error(komunikat);
+    if (A.kind() != B.kind())
+        throw std::runtime_error("Niezgodne rodzaje macierzy trójkątnych");
+}
+
+/// @brief Suma lub roznica pasm o szerokosciach dopasowanych do szerszego
+banded_matrix polacz(const banded_matrix& A, const banded_matrix& B, double znak) {
+    const std::size_t n = A.size();
+    banded_matrix C(n, std::max(A.lower(), B.lower()), std::max(A.upper(), B.upper()));
+    for (const banded_matrix* X : {&A, &B}) {
+        const double s = X == &A ? 1.0 : znak;
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t j0 = i > X->lower() ? i - X->lower() : 0, j1 = std::min(n, i + X->upper() + 1);
+            for (std::size_t j = j0; j < j1; ++j) C(i, j) += s * (*X)(i, j);
+        }
+    }
+    return C;
+}
+
+} // namespace
+
+/**
+ * @brief Przekątna macierzy gęstej
+ *
+ * @throw std::runtime_error jeśli m nie jest kwadratowa
+ */
+diagonal_matrix::diagonal_matrix(const matrix& m) : d(m.get_rows()) {
+    wymagaj_kwadratowej(m);
+    for (std::size_t i = 0; i < d.size(); ++i) d[i] = m(i, i);
+}
+
+/**
+ * @brief Zamiana na macierz gęstą
+ *
+ * @complexity O(n²) - zerowanie wyniku
+ */
+matrix diagonal_matrix::to_matrix() const {
+    matrix wynik(d.size(), d.size());
+    for (std::size_t i = 0; i < d.size(); ++i) wynik(i, i) = d[i];
+    return wynik;
+}
+
+/// @brief Macierz pasmowa zerowa
+banded_matrix::banded_matrix(std::size_t rozmiar, std::size_t dolne, std::size_t gorne)
+    : n(rozmiar), kl(dolne), ku(gorne), pasmo(rozmiar * (dolne + gorne + 1), 0.0) {}
+
+/**
+ * @brief Pasmo macierzy gęstej
+ *
+ * @throw std::runtime_error jeśli m nie jest kwadratowa
+ *
+ * @complexity O(n × (kl + ku))
+ */
+banded_matrix::banded_matrix(const matrix& m, std::size_t dolne, std::size_t gorne)
+    : banded_matrix(m.get_rows(), dolne, gorne) {
+    wymagaj_kwadratowej(m);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j0 = i > kl ? i - kl : 0, j1 = std::min(n, i + ku + 1);
+        for (std::size_t j = j0; j < j1; ++j) (*this)(i, j) = m(i, j);
+    }
+}
+
+/// @brief Zamiana na macierz gęstą
+matrix banded_matrix::to_matrix() const {
+    matrix wynik(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j0 = i > kl ? i - kl : 0, j1 = std::min(n, i + ku + 1);
+        for (std::size_t j = j0; j < j1; ++j) wynik(i, j) = (*this)(i, j);
+    }
+    return wynik;
+}
+
+/// @brief Macierz trójkątna zerowa
+triangular_matrix::triangular_matrix(std::size_t rozmiar, triangle r)
+    : n(rozmiar), rodzaj(r), dane(rozmiar * (rozmiar + 1) / 2, 0.0) {}
+
+/**
+ * @brief Trójkąt macierzy gęstej
+ *
+ * @throw std::runtime_error jeśli m nie jest kwadratowa
+ *
+ * @example
+ * @code
+ * matrix m(4, 4);
+ * m.pod_przekatna();
+ * triangular_matrix L(m, triangle::lower);  // 10 liczb zamiast 16
+ * @endcode
+ */
+triangular_matrix::triangular_matrix(const matrix& m, triangle r) : triangular_matrix(m.get_rows(), r) {
+    wymagaj_kwadratowej(m);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::copy(m.row_ptr(i) + row_begin(i), m.row_ptr(i) + row_end(i), dane.begin() + poczatek(i));
+    }
+}
+
+/// @brief Zamiana na macierz gęstą
+matrix triangular_matrix::to_matrix() const {
+    matrix wynik(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::copy(packed_row(i), packed_row(i) + (row_end(i) - row_begin(i)), wynik.row_ptr(i) + row_begin(i));
+    }
+    return wynik;
+}
+
+/// @brief Iloczyn D * x
+std::vector<double> operator*(const diagonal_matrix& D, const std::vector<double>& x) {
+    if (D.size() != x.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    std::vector<double> y(x.size());
+    for (std::size_t i = 0; i < y.size(); ++i) y[i] = D[i] * x[i];
+    return y;
+}
+
+/**
+ * @brief Iloczyn D * M - wiersz i macierzy M mnożony przez D[i]
+ *
+ * @complexity O(n × M.cols)
+ */
+matrix operator*(const diagonal_matrix& D, const matrix& M) {
+    if (D.size() != M.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t cols = M.get_cols();
+    const auto& jadra = detail::kernels();
+    matrix wynik(M.get_rows(), cols, bez_zerowania);
+    thread_pool::instance().parallel_rows(D.size(), cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) jadra.mul_scalar(cols, M.row_ptr(i), D[i], wynik.row_ptr(i));
+    });
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn M * D - kolumna j macierzy M mnożona przez D[j]
+ *
+ * @complexity O(M.rows × n)
+ */
+matrix operator*(const matrix& M, const diagonal_matrix& D) {
+    if (M.get_cols() != D.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t cols = M.get_cols();
+    const double* d = D.diagonal().data();
+    matrix wynik(M.get_rows(), cols, bez_zerowania);
+    thread_pool::instance().parallel_rows(M.get_rows(), cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* m = M.row_ptr(i);
+            double* w = wynik.row_ptr(i);
+            for (std::size_t j = 0; j < cols; ++j) w[j] = m[j] * d[j];
+        }
+    });
+    return wynik;
+}
+
+/// @brief Iloczyn macierzy diagonalnych
+diagonal_matrix operator*(const diagonal_matrix& A, const diagonal_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    return diagonal_matrix(A * B.diagonal());
+}
+
+/// @brief Suma macierzy diagonalnych
+diagonal_matrix operator+(const diagonal_matrix& A, const diagonal_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla dodawania");
+    std::vector<double> d(A.size());
+    detail::kernels().add(d.size(), A.diagonal().data(), B.diagonal().data(), d.data());
+    return diagonal_matrix(std::move(d));
+}
+
+/// @brief Różnica macierzy diagonalnych
+diagonal_matrix operator-(const diagonal_matrix& A, const diagonal_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla odejmowania");
+    std::vector<double> d(A.size());
+    detail::kernels().sub(d.size(), A.diagonal().data(), B.diagonal().data(), d.data());
+    return diagonal_matrix(std::move(d));
+}
+
+/**
+ * @brief Rozwiązanie układu D * x = b
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają lub D[i] == 0
+ */
+std::vector<double> solve(const diagonal_matrix& D, const std::vector<double>& b) {
+    if (D.size() != b.size())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+    std::vector<double> x(b.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        if (D[i] == 0.0)
+            throw std::runtime_error("Macierz jest osobliwa");
+        x[i] = b[i] / D[i];
+    }
+    return x;
+}
+
+/**
+ * @brief Rozwiązanie układów D * X = B
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają lub D[i] == 0
+ */
+matrix solve(const diagonal_matrix& D, const matrix& B) {
+    if (D.size() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+    std::vector<double> odwrotnosci(D.size());
+    for (std::size_t i = 0; i < D.size(); ++i) {
+        if (D[i] == 0.0)
+            throw std::runtime_error("Macierz jest osobliwa");
+        odwrotnosci[i] = 1.0 / D[i];
+    }
+    return diagonal_matrix(std::move(odwrotnosci)) * B;
+}
+
+/**
+ * @brief Iloczyn A * x macierzy pasmowej i wektora
+ *
+ * @complexity O(n × (kl + ku))
+ */
+std::vector<double> operator*(const banded_matrix& A, const std::vector<double>& x) {
+    if (A.size() != x.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = A.size(), kl = A.lower(), ku = A.upper();
+    std::vector<double> y(n);
+    thread_pool::instance().parallel_rows(n, kl + ku + 1, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* a = A.band_row(i) + kl - i;  // a[j] = A(i, j)
+            const std::size_t j0 = i > kl ? i - kl : 0, j1 = std::min(n, i + ku + 1);
+            double s = 0.0;
+            for (std::size_t j = j0; j < j1; ++j) s += a[j] * x[j];
+            y[i] = s;
+        }
+    });
+    return y;
+}
+
+/**
+ * @brief Iloczyn A * M macierzy pasmowej i gęstej
+ *
+ * Wiersz i wyniku to suma co najwyżej kl + ku + 1 wierszy M (axpy).
+ *
+ * @complexity O(n × (kl + ku) × M.cols)
+ */
+matrix operator*(const banded_matrix& A, const matrix& M) {
+    if (A.size() != M.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = A.size(), kl = A.lower(), ku = A.upper(), cols = M.get_cols();
+    const auto& jadra = detail::kernels();
+    matrix wynik(n, cols);
+    thread_pool::instance().parallel_rows(n, (kl + ku + 1) * cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* a = A.band_row(i) + kl - i;
+            const std::size_t j0 = i > kl ? i - kl : 0, j1 = std::min(n, i + ku + 1);
+            for (std::size_t j = j0; j < j1; ++j) dodaj_wiersz(jadra, cols, a[j], M.row_ptr(j), wynik.row_ptr(i));
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn macierzy pasmowych
+ *
+ * Wiersz i wyniku to suma wierszy pasma B przemnożonych przez elementy
+ * wiersza i macierzy A; każdy z nich jest ciągłym fragmentem wiersza
+ * pasma wyniku.
+ *
+ * @complexity O(n × (A.kl + A.ku + 1) × (B.kl + B.ku + 1))
+ */
+banded_matrix operator*(const banded_matrix& A, const banded_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = A.size();
+    const auto& jadra = detail::kernels();
+    banded_matrix C(n, A.lower() + B.lower(), A.upper() + B.upper());
+    thread_pool::instance().parallel_rows(n, (A.lower() + A.upper() + 1) * (B.lower() + B.upper() + 1),
+                                          [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const std::size_t p0 = i > A.lower() ? i - A.lower() : 0, p1 = std::min(n, i + A.upper() + 1);
+            for (std::size_t p = p0; p < p1; ++p) {
+                const std::size_t j0 = p > B.lower() ? p - B.lower() : 0, j1 = std::min(n, p + B.upper() + 1);
+                dodaj_wiersz(jadra, j1 - j0, A(i, p), B.band_row(p) + j0 + B.lower() - p, &C(i, j0));
+            }
+        }
+    });
+    return C;
+}
+
+/// @brief Suma macierzy pasmowych
+banded_matrix operator+(const banded_matrix& A, const banded_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla dodawania");
+    return polacz(A, B, 1.0);
+}
+
+/// @brief Różnica macierzy pasmowych
+banded_matrix operator-(const banded_matrix& A, const banded_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla odejmowania");
+    return polacz(A, B, -1.0);
+}
+
+/**
+ * @brief Rozwiązanie układu A * x = b dla macierzy pasmowej
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają lub A jest osobliwa
+ *
+ * @complexity O(n × kl × (kl + ku))
+ *
+ * @example
+ * @code
+ * banded_matrix A(n, 1, 1);  // trójprzekątniowa
+ * for (std::size_t i = 0; i < n; ++i) {
+ *     A(i, i) = 2.0;
+ *     if (i > 0) A(i, i - 1) = -1.0;
+ *     if (i + 1 < n) A(i, i + 1) = -1.0;
+ * }
+ * std::vector<double> x = solve(A, b);  // O(n)
+ * @endcode
+ */
+std::vector<double> solve(const banded_matrix& A, const std::vector<double>& b) {
+    if (A.size() != b.size())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+    std::vector<double> x = b;
+    rozklad_pasmowy(A).rozwiaz(x.data(), 1, 1);
+    return x;
+}
+
+/**
+ * @brief Rozwiązanie układów A * X = B dla macierzy pasmowej
+ *
+ * Rozkład liczony jest raz, a kolumny prawej strony dzielone między wątki
+ * (każdy wątek rozwiązuje swój zakres kolumn).
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają lub A jest osobliwa
+ *
+ * @complexity O(n × kl × (kl + ku) × (1 + B.cols))
+ */
+matrix solve(const banded_matrix& A, const matrix& B) {
+    if (A.size() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+    const rozklad_pasmowy lu(A);
+    matrix X = B;
+    thread_pool::instance().parallel_rows(B.get_cols(), A.size() * (2 * A.lower() + A.upper() + 1),
+                                          [&](std::size_t c0, std::size_t c1) {
+        lu.rozwiaz(X.data.get() + c0, X.get_stride(), c1 - c0);
+    });
+    return X;
+}
+
+/**
+ * @brief Iloczyn T * x macierzy trójkątnej i wektora
+ *
+ * @complexity O(n² / 2)
+ */
+std::vector<double> operator*(const triangular_matrix& T, const std::vector<double>& x) {
+    if (T.size() != x.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = T.size();
+    std::vector<double> y(n);
+    thread_pool::instance().parallel_rows(n, n / 2 + 1, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* t = T.packed_row(i) - T.row_begin(i);
+            double s = 0.0;
+            for (std::size_t j = T.row_begin(i); j < T.row_end(i); ++j) s += t[j] * x[j];
+            y[i] = s;
+        }
+    });
+    return y;
+}
+
+/**
+ * @brief Iloczyn T * M macierzy trójkątnej i gęstej
+ *
+ * @complexity O(n² / 2 × M.cols)
+ */
+matrix operator*(const triangular_matrix& T, const matrix& M) {
+    if (T.size() != M.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = T.size(), cols = M.get_cols();
+    const auto& jadra = detail::kernels();
+    matrix wynik(n, cols);
+    thread_pool::instance().parallel_rows(n, (n / 2 + 1) * cols, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* t = T.packed_row(i) - T.row_begin(i);
+            for (std::size_t p = T.row_begin(i); p < T.row_end(i); ++p) {
+                dodaj_wiersz(jadra, cols, t[p], M.row_ptr(p), wynik.row_ptr(i));
+            }
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn macierzy trójkątnych tego samego rodzaju
+ *
+ * Wiersz i wyniku to suma upakowanych wierszy B przemnożonych przez
+ * elementy wiersza i macierzy A; dla macierzy dolnych wiersz p macierzy B
+ * to kolumny 0..p, dla górnych p..n-1 - w obu przypadkach ciągły fragment
+ * wiersza wyniku.
+ *
+ * @throw std::runtime_error jeśli wymiary lub rodzaje się nie zgadzają
+ *
+ * @complexity O(n³ / 6)
+ */
+triangular_matrix operator*(const triangular_matrix& A, const triangular_matrix& B) {
+    wymagaj_zgodnych(A, B, "Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = A.size();
+    const auto& jadra = detail::kernels();
+    triangular_matrix C(n, A.kind());
+    thread_pool::instance().parallel_rows(n, n * n / 6 + 1, [&](std::size_t r0, std::size_t r1) {
+        for (std::size_t i = r0; i < r1; ++i) {
+            const double* a = A.packed_row(i) - A.row_begin(i);
+            double* ci = &C(i, C.row_begin(i)) - C.row_begin(i);  // ci[j] = C(i, j)
+            for (std::size_t p = A.row_begin(i); p < A.row_end(i); ++p) {
+                dodaj_wiersz(jadra, B.row_end(p) - B.row_begin(p), a[p], B.packed_row(p), ci + B.row_begin(p));
+            }
+        }
+    });
+    return C;
+}
+
+/// @brief Suma macierzy trójkątnych tego samego rodzaju
+triangular_matrix operator+(const triangular_matrix& A, const triangular_matrix& B) {
+    wymagaj_zgodnych(A, B, "Nieprawidłowe wymiary dla dodawania");
+    triangular_matrix C(A.size(), A.kind());
+    detail::kernels().add(C.packed().size(), A.packed().data(), B.packed().data(), C.packed().data());
+    return C;
+}
+
+/// @brief Różnica macierzy trójkątnych tego samego rodzaju
+triangular_matrix operator-(const triangular_matrix& A, const triangular_matrix& B) {
+    wymagaj_zgodnych(A, B, "Nieprawidłowe wymiary dla odejmowania");
+    triangular_matrix C(A.size(), A.kind());
+    detail::kernels().sub(C.packed().size(), A.packed().data(), B.packed().data(), C.packed().data());
+    return C;
+}
+
+/**
+ * @brief Rozwiązanie układu T * x = b
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają lub T ma zero na przekątnej
+ *
+ * @complexity O(n² / 2)
+ */
+std::vector<double> solve(const triangular_matrix& T, const std::vector<double>& b) {
+    if (T.size() != b.size())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+    wymagaj_nieosobliwej(T);
+    const std::size_t n = T.size();
+    const bool dolna = T.kind() == triangle::lower;
+    std::vector<double> x = b;
+    // Iloczyn skalarny wiersza z obliczonymi juz niewiadomymi
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t i = dolna ? k : n - 1 - k;
+        const double* t = T.packed_row(i) - T.row_begin(i);
+        double s = x[i];
+        for (std::size_t p = dolna ? 0 : i + 1; p < (dolna ? i : n); ++p) s -= t[p] * x[p];
+        x[i] = s / t[i];
+    }
+    return x;
+}
+
+/**
+ * @brief Rozwiązanie układów T * X = B
+ *
+ * Kolumny prawej strony dzielone są między wątki.
+ *
+ * @throw std::runtime_error jeśli wymiary się nie zgadzają lub T ma zero na przekątnej
+ *
+ * @complexity O(n² / 2 × B.cols)
+ */
+matrix solve(const triangular_matrix& T, const matrix& B) {
+    if (T.size() != B.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary macierzy");
+    wymagaj_nieosobliwej(T);
+    matrix X = B;
+    thread_pool::instance().parallel_rows(B.get_cols(), T.size() * T.size() / 2 + 1,
+                                          [&](std::size_t c0, std::size_t c1) {
+        podstaw(T, X.data.get() + c0, X.get_stride(), c1 - c0);
+    });
+    return X;
+}
+
+/**
+ * @brief Górny trójkąt macierzy gęstej
+ *
+ * @throw std::runtime_error jeśli m nie jest kwadratowa
+ */
+symmetric_matrix::symmetric_matrix(const matrix& m) : symmetric_matrix(m.get_rows()) {
+    wymagaj_kwadratowej(m);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::copy(m.row_ptr(i) + i, m.row_ptr(i) + n, dane.begin() + poczatek(i));
+    }
+}
+
+/// @brief Zamiana na macierz gęstą (oba trójkąty)
+matrix symmetric_matrix::to_matrix() const {
+    matrix wynik(n, n, bez_zerowania);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double* s = packed_row(i);
+        double* w = wynik.row_ptr(i);
+        std::copy(s, s + (n - i), w + i);
+        for (std::size_t j = i + 1; j < n; ++j) wynik(j, i) = s[j - i];
+    }
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn symetryczny A · Aᵀ (lub Aᵀ · A) - tylko górny trójkąt
+ *
+ * Górny trójkąt wyniku dzielony jest na kafelki kafel_wierszy × kafel_kolumn,
+ * zaczynające się najwcześniej od kolumny równej pierwszemu wierszowi bloku;
+ * kafelki pod przekątną nie są liczone wcale. Każdy kafelek liczony jest
+ * silnikiem detail::gemm_blocked() do bufora wątku (transpozycja operandu
+ * to zamiana kroków) i przepisywany do upakowanych wierszy. Liczone
+ * nadmiarowo są tylko połówki kafelków przekątnych, czyli ułamek
+ * kafel_wierszy / n pracy.
+ *
+ * @param A macierz źródłowa
+ * @param t trans::none - A · Aᵀ, trans::transpose - Aᵀ · A
+ *
+ * @return macierz symetryczna
+ *
+ * @complexity O(n² × k / 2)
+ *
+ * @example
+ * @code
+ * matrix X(100000, 50);                           // obserwacje w wierszach
+ * symmetric_matrix G = syrk(X, trans::transpose); // Xᵀ · X, 50 × 50
+ * @endcode
+ */
+symmetric_matrix syrk(const matrix& A, trans t) {
+    const bool tr = t == trans::transpose;
+    const std::size_t n = tr ? A.get_cols() : A.get_rows();
+    const std::size_t k = tr ? A.get_rows() : A.get_cols();
+    // X to operand lewy: X(i, p) = a[i * rsx + p * csx], a prawy to Xᵀ
+    const std::ptrdiff_t ld = static_cast<std::ptrdiff_t>(A.get_stride());
+    const std::ptrdiff_t rsx = tr ? 1 : ld, csx = tr ? ld : 1;
+    const double* a = A.data.get();
+    symmetric_matrix S(n);
+    if (n == 0 || k == 0) {
+        return S;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> kafle;
+    for (std::size_t i0 = 0; i0 < n; i0 += kafel_wierszy) {
+        for (std::size_t j0 = i0; j0 < n; j0 += kafel_kolumn) kafle.emplace_back(i0, j0);
+    }
+    thread_pool::instance().parallel_rows(kafle.size(), kafel_wierszy * kafel_kolumn * k, [&](std::size_t t0, std::size_t t1) {
+        thread_local detail::bufor_roboczy bufor;
+        for (std::size_t q = t0; q < t1; ++q) {
+            const auto [i0, j0] = kafle[q];
+            const std::size_t mb = std::min(kafel_wierszy, n - i0), nb = std::min(kafel_kolumn, n - j0);
+            double* c = bufor.zapewnij(mb * nb);
+            std::fill_n(c, mb * nb, 0.0);
+            detail::gemm_blocked(mb, nb, k, 1.0,
+                                 a + static_cast<std::ptrdiff_t>(i0) * rsx, rsx, csx,
+                                 a + static_cast<std::ptrdiff_t>(j0) * rsx, csx, rsx,
+                                 c, static_cast<std::ptrdiff_t>(nb));
+            for (std::size_t r = 0; r < mb; ++r) {
+                const std::size_t i = i0 + r, j = std::max(i, j0);
+                if (j < j0 + nb) {
+                    std::memcpy(&S(i, j), c + r * nb + (j - j0), (j0 + nb - j) * sizeof(double));
+                }
+            }
+        }
+    });
+    return S;
+}
+
+/**
+ * @brief Iloczyn S * x macierzy symetrycznej i wektora
+ *
+ * Upakowany wiersz i jest czytany raz i używany dwukrotnie: jako wiersz i
+ * (iloczyn skalarny do y[i]) i jako kolumna i (axpy do y[i+1..n)).
+ *
+ * @complexity O(n² / 2)
+ */
+std::vector<double> operator*(const symmetric_matrix& S, const std::vector<double>& x) {
+    if (S.size() != x.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = S.size();
+    const auto& jadra = detail::kernels();
+    std::vector<double> y(n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double* s = S.packed_row(i);
+        double suma = s[0] * x[i];
+        for (std::size_t j = i + 1; j < n; ++j) suma += s[j - i] * x[j];
+        y[i] += suma;
+        dodaj_wiersz(jadra, n - i - 1, x[i], s + 1, y.data() + i + 1);
+    }
+    return y;
+}
+
+/**
+ * @brief Iloczyn S * M macierzy symetrycznej i gęstej (SYMM)
+ *
+ * Bloki wierszy wyniku liczone są równolegle. Dla bloku I kolejne
+ * fragmenty S(I, P) po gemm_kc kolumn są rozpakowywane z obu połówek
+ * (element (i, p) z wiersza min(i, p)) do bufora wątku i mnożone przez
+ * wiersze P macierzy M silnikiem blokowym.
+ *
+ * @throw std::runtime_error jeśli S.size() != M.rows
+ *
+ * @complexity O(n² × M.cols)
+ */
+matrix operator*(const symmetric_matrix& S, const matrix& M) {
+    if (S.size() != M.get_rows())
+        throw std::runtime_error("Nieprawidłowe wymiary dla mnożenia");
+    const std::size_t n = S.size(), cols = M.get_cols();
+    const std::ptrdiff_t ldm = static_cast<std::ptrdiff_t>(M.get_stride());
+    matrix wynik(n, cols);
+    const std::size_t bloki = (n + kafel_wierszy - 1) / kafel_wierszy;
+    thread_pool::instance().parallel_rows(bloki, kafel_wierszy * n * cols, [&](std::size_t b0, std::size_t b1) {
+        thread_local detail::bufor_roboczy bufor;
+        double* blok = bufor.zapewnij(kafel_wierszy * detail::gemm_kc);
+        for (std::size_t b = b0; b < b1; ++b) {
+            const std::size_t i0 = b * kafel_wierszy, mb = std::min(kafel_wierszy, n - i0);
+            for (std::size_t p0 = 0; p0 < n; p0 += detail::gemm_kc) {
+                const std::size_t pb = std::min(detail::gemm_kc, n - p0);
+                for (std::size_t r = 0; r < mb; ++r) {
+                    for (std::size_t q = 0; q < pb; ++q) blok[r * pb + q] = S(i0 + r, p0 + q);
+                }
+                detail::gemm_blocked(mb, cols, pb, 1.0, blok, static_cast<std::ptrdiff_t>(pb), 1,
+                                     M.row_ptr(p0), ldm, 1, wynik.row_ptr(i0), static_cast<std::ptrdiff_t>(wynik.get_stride()));
+            }
+        }
+    });
+    return wynik;
+}
+
+/// @brief Suma macierzy symetrycznych
+symmetric_matrix operator+(const symmetric_matrix& A, const symmetric_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla dodawania");
+    symmetric_matrix C(A.size());
+    detail::kernels().add(C.packed().size(), A.packed().data(), B.packed().data(), C.packed().data());
+    return C;
+}
+
+/// @brief Różnica macierzy symetrycznych
+symmetric_matrix operator-(const symmetric_matrix& A, const symmetric_matrix& B) {
+    if (A.size() != B.size())
+        throw std::runtime_error("Nieprawidłowe wymiary dla odejmowania");
+    symmetric_matrix C(A.size());
+    detail::kernels().sub(C.packed().size(), A.packed().data(), B.packed().data(), C.packed().data());
+    return C;
+}
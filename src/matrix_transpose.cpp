@@ -0,0 +1,233 @@
+#include "../include/matrix.h"
+#include "matrix_simd.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// @brief Blok, ponizej ktorego rekurencja konczy sie wywolaniem jadra (32 x 32 double = 8 KiB)
+constexpr std::size_t blok_rekurencji = 32;
+
+/// @brief Bok kafelka przydzielanego jednemu zadaniu puli watkow
+constexpr std::size_t kafel_watku = 256;
+
+/// @brief Bok kafelka przy transpozycji w miejscu (dwa kafelki i bufor mieszcza sie w L2)
+constexpr std::size_t kafel_w_miejscu = 64;
+
+/**
+ * @brief Transponuje mały blok jądrem wybranym według rozmiaru elementu
+ *
+ * Jądra SIMD kopiują bity, więc double i int64 korzystają z tego samego
+ * jądra 8-bajtowego, a float i int32 z 4-bajtowego. Pozostałe typy
+ * (int8) są przepisywane zwykłą pętlą.
+ */
+template <typename T>
+void transponuj_blok(std::size_t rows, std::size_t cols, const T* a, std::size_t lda,
+                     T* b, std::size_t ldb) {
+    if constexpr (sizeof(T) == 8) {
+        detail::kernels().transpose_b64(rows, cols, a, lda, b, ldb);
+    } else if constexpr (sizeof(T) == 4) {
+        detail::kernels().transpose_b32(rows, cols, a, lda, b, ldb);
+    } else {
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) {
+                b[j * ldb + i] = a[i * lda + j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rekurencyjna (cache-oblivious) transpozycja b = aᵀ
+ *
+ * Dzieli dłuższy wymiar na pół, aż blok zmieści się w L1; wtedy zarówno
+ * czytane wiersze a, jak i zapisywane wiersze b są w cache niezależnie
+ * od jego rozmiaru, a liczba stron TLB dotykanych naraz pozostaje mała.
+ * Punkt podziału jest wyrównany do 8 elementów, żeby jądra SIMD
+ * dostawały pełne kafelki.
+ */
+template <typename T>
+void transponuj_rekurencyjnie(std::size_t rows, std::size_t cols, const T* a, std::size_t lda,
+                              T* b, std::size_t ldb) {
+    if (rows <= blok_rekurencji && cols <= blok_rekurencji) {
+        transponuj_blok(rows, cols, a, lda, b, ldb);
+        return;
+    }
+    if (rows >= cols) {
+        const std::size_t h = rows / 2 / 8 * 8;
+        transponuj_rekurencyjnie(h, cols, a, lda, b, ldb);
+        transponuj_rekurencyjnie(rows - h, cols, a + h * lda, lda, b + h, ldb);
+    } else {
+        const std::size_t h = cols / 2 / 8 * 8;
+        transponuj_rekurencyjnie(rows, h, a, lda, b, ldb);
+        transponuj_rekurencyjnie(rows, cols - h, a + h, lda, b + h * ldb, ldb);
+    }
+}
+
+/**
+ * @brief Transpozycja b = aᵀ podzielona na kafelki między wątki puli
+ *
+ * Każdy kafelek kafel_watku × kafel_watku jest transponowany rekurencyjnie
+ * przez jeden wątek; kafelki wyniku są rozłączne, więc nie ma synchronizacji.
+ */
+template <typename T>
+void transponuj(std::size_t rows, std::size_t cols, const T* a, std::size_t lda,
+                T* b, std::size_t ldb) {
+    auto& pula = thread_pool::instance();
+    const std::size_t kafle_r = (rows + kafel_watku - 1) / kafel_watku;
+    const std::size_t kafle_c = (cols + kafel_watku - 1) / kafel_watku;
+    if (kafle_r * kafle_c < 2 || !pula.should_parallelize(rows * cols)) {
+        transponuj_rekurencyjnie(rows, cols, a, lda, b, ldb);
+        return;
+    }
+    pula.parallel_for(kafle_r * kafle_c, [&](std::size_t t) {
+        const std::size_t i0 = (t / kafle_c) * kafel_watku;
+        const std::size_t j0 = (t % kafle_c) * kafel_watku;
+        transponuj_rekurencyjnie(std::min(kafel_watku, rows - i0), std::min(kafel_watku, cols - j0),
+                                 a + i0 * lda + j0, lda, b + j0 * ldb + i0, ldb);
+    });
+}
+
+} // namespace
+
+/**
+ * @brief Dokonuje transpozycji macierzy w miejscu (in-place)
+ *
+ * Macierz kwadratowa jest dzielona na kafelki kafel_w_miejscu ×
+ * kafel_w_miejscu. Para kafelków (I, J) i (J, I) jest zamieniana przez
+ * bufor: (I, J)ᵀ trafia do bufora, (J, I)ᵀ bezpośrednio na miejsce
+ * (I, J), a bufor na miejsce (J, I); kafelki przekątne przechodzą przez
+ * bufor i wracają na swoje miejsce. Każdy kafelek jest transponowany
+ * jądrem SIMD w rejestrach, a pary kafelków są rozdzielane między wątki.
+ * W odróżnieniu od zamiany data[i][j] z data[j][i] element po elemencie
+ * żadna pętla nie przechodzi po kolumnie całej macierzy.
+ *
+ * Macierz prostokątna jest transponowana do nowego bufora i przejmuje
+ * go, więc zmienia wymiary na cols × rows.
+ *
+ * Gdy transpozycja jest tylko czytana (mnożenie, wyrażenie, odczyt
+ * elementów), lepiej użyć widoku transpose(), który nie przenosi danych.
+ *
+ * @return referencja na bieżącą macierz (transponowaną)
+ *
+ * @post element na pozycji [i][j] zawiera wartość która była na [j][i]
+ * @complexity O(rows · cols)
+ *
+ * @example
+ * @code
+ * matrix m(3, 3);
+ * m.wstaw(0, 1, 5).wstaw(1, 0, 3);
+ * m.dowroc();  // m[0][1] = 3, m[1][0] = 5
+ *
+ * matrix p(2, 5);
+ * p.dowroc();  // p ma teraz wymiary 5 × 2
+ * @endcode
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::dowroc() {
+    if (rows != cols) {
+        *this = transpose().to_matrix();
+        return *this;
+    }
+
+    const std::size_t n = get_rows();
+    const std::size_t ld = stride;
+    const std::size_t kafle = (n + kafel_w_miejscu - 1) / kafel_w_miejscu;
+    std::vector<std::pair<std::size_t, std::size_t>> pary;
+    pary.reserve(kafle * (kafle + 1) / 2);
+    for (std::size_t I = 0; I < kafle; ++I) {
+        for (std::size_t J = I; J < kafle; ++J) {
+            pary.emplace_back(I * kafel_w_miejscu, J * kafel_w_miejscu);
+        }
+    }
+
+    T* const d = data.get();
+    auto zamien_pare = [&](std::size_t t) {
+        thread_local std::vector<T> bufor;
+        if (bufor.size() < kafel_w_miejscu * kafel_w_miejscu) {
+            bufor.resize(kafel_w_miejscu * kafel_w_miejscu);
+        }
+        const std::size_t i0 = pary[t].first, j0 = pary[t].second;
+        const std::size_t h = std::min(kafel_w_miejscu, n - i0);
+        const std::size_t w = std::min(kafel_w_miejscu, n - j0);
+        T* ij = d + i0 * ld + j0;
+        T* ji = d + j0 * ld + i0;
+
+        // bufor = (I, J)^T, wymiary w x h
+        transponuj_blok(h, w, ij, ld, bufor.data(), kafel_w_miejscu);
+        if (i0 != j0) {
+            transponuj_blok(w, h, ji, ld, ij, ld);
+        }
+        for (std::size_t r = 0; r < w; ++r) {
+            std::memcpy(ji + r * ld, bufor.data() + r * kafel_w_miejscu, h * sizeof(T));
+        }
+    };
+
+    auto& pula = thread_pool::instance();
+    if (pary.size() < 2 || !pula.should_parallelize(n * n)) {
+        for (std::size_t t = 0; t < pary.size(); ++t) zamien_pare(t);
+    } else {
+        pula.parallel_for(pary.size(), zamien_pare);
+    }
+    return *this;
+}
+
+/**
+ * @brief Blokowa transpozycja b = aᵀ dla kopii widoków transponowanych
+ *
+ * Rekurencyjny podział na bloki mieszczące się w L1 (cache-oblivious),
+ * bloki transponowane w rejestrach SIMD (SSE2 / AVX2 wybierane przy
+ * starcie), duże macierze dzielone na kafelki między wątki puli.
+ *
+ * @param rows liczba wierszy a
+ * @param cols liczba kolumn a
+ * @param a źródło (wiersze co lda elementów)
+ * @param lda krok wiersza a
+ * @param b cel cols × rows (wiersze co ldb elementów)
+ * @param ldb krok wiersza b
+ */
+template <typename T>
+void detail::transpose_copy(std::size_t rows, std::size_t cols, const T* a, std::size_t lda,
+                            T* b, std::size_t ldb) {
+    transponuj(rows, cols, a, lda, b, ldb);
+}
+
+/**
+ * @brief Transpozycja zapisywana do istniejącej macierzy: B = Aᵀ
+ *
+ * Bufor B jest używany ponownie, gdy ma już wymiary wyniku, więc
+ * w pętli nie ma alokacji. Gdy B i A są tą samą macierzą, wykonywana
+ * jest transpozycja w miejscu (dowroc()).
+ *
+ * @param B macierz wynikowa (dopasowywana do A.cols × A.rows)
+ * @param A macierz transponowana
+ *
+ * @return referencja na B
+ */
+template <typename T>
+basic_matrix<T>& transpose_into(basic_matrix<T>& B, const basic_matrix<T>& A) {
+    if (&B == &A) {
+        return B.dowroc();
+    }
+    if (B.get_rows() != A.get_cols() || B.get_cols() != A.get_rows()) {
+        B = basic_matrix<T>(A.get_cols(), A.get_rows(), bez_zerowania);
+    }
+    transponuj(A.get_rows(), A.get_cols(), A.data.get(), A.stride, B.data.get(), B.stride);
+    return B;
+}
+
+// Jawne konkretyzacje transpozycji
+#define MATRIX_KONKRETYZUJ_TRANSPOZYCJE(T)                                              \
+    template basic_matrix<T>& basic_matrix<T>::dowroc();                                \
+    template void detail::transpose_copy(std::size_t, std::size_t, const T*, std::size_t, \
+                                         T*, std::size_t);                              \
+    template basic_matrix<T>& transpose_into(basic_matrix<T>&, const basic_matrix<T>&);
+
+MATRIX_KONKRETYZUJ_TRANSPOZYCJE(double)
+MATRIX_KONKRETYZUJ_TRANSPOZYCJE(float)
+MATRIX_KONKRETYZUJ_TRANSPOZYCJE(std::int8_t)
+MATRIX_KONKRETYZUJ_TRANSPOZYCJE(std::int32_t)
+MATRIX_KONKRETYZUJ_TRANSPOZYCJE(std::int64_t)
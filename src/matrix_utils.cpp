@@ -1,8 +1,7 @@
 #include "../include/matrix.h"
-#include <cstdlib>
-#include <ctime>
 #include <cstring>
 #include <stdexcept>
+#include <algorithm>
 
 using namespace std;
 
@@ -34,8 +33,9 @@ using namespace std;
  * 
  * @see pokaz()
  */
-matrix& matrix::wstaw(int x, int y, int wartosc) {
-    data[x][y] = wartosc;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::wstaw(int x, int y, int wartosc) {
+    (*this)(x, y) = wartosc;
     return *this;
 }
 
@@ -65,125 +65,9 @@ matrix& matrix::wstaw(int x, int y, int wartosc) {
  * 
  * @see wstaw()
  */
-int matrix::pokaz(int x, int y) {
-    return data[x][y];
-}
-
-/**
- * @brief Dokonuje transpozycji macierzy w miejscu (in-place)
- * 
- * Transponuje macierz zamieniając wiersze z kolumnami.
- * Operacja jest przeprowadzana w miejscu (nie tworzy nowej macierzy).
- * Wymaga macierzy kwadratowej (rows == cols).
- * 
- * @return referencja na bieżącą macierz (transponowaną)
- * 
- * @throw std::runtime_error jeśli macierz nie jest kwadratowa
- * 
- * @pre rows == cols (macierz kwadratowa)
- * @post element na pozycji [i][j] zawiera wartość które była na [j][i]
- * @complexity O(n²) gdzie n = rows = cols
- * 
- * @example
- * @code
- * matrix m(3, 3);
- * m.wstaw(0, 1, 5).wstaw(1, 0, 3);
- * m.dowroc();  // m[0][1] = 3, m[1][0] = 5
- * @endcode
- * 
- * @warning Wymaga macierzy kwadratowej! Dla macierzy prostokątnych
- *          rzuca wyjątek std::runtime_error
- * 
- * @note Optymalizacja: pętla j rozpoczyna się od i+1, aby uniknąć
- *       podwójnego zamieniania
- */
-matrix& matrix::dowroc() {
-    if (rows != cols) {
-        throw std::runtime_error("Transpozycja in-place wymaga macierzy kwadratowej");
-    }
-    
-    for (int i = 0; i < rows; ++i) {
-        for (int j = i + 1; j < cols; ++j) {
-            double temp = data[i][j];
-            data[i][j] = data[j][i];
-            data[j][i] = temp;
-        }
-    }
-    return *this;
-}
-
-/**
- * @brief Wypełnia macierz losowymi cyframi 0-9
- * 
- * Generuje losowe wartości z zakresu [0, 9] dla wszystkich elementów macierzy.
- * Używa generatora liczb losowych std::rand() z ziarnem czasowym.
- * 
- * @return referencja na bieżącą macierz (wypełnioną)
- * 
- * @post każdy element macierzy zawiera losową wartość z zakresu [0, 9]
- * @complexity O(n × m) gdzie n = rows, m = cols
- * 
- * @example
- * @code
- * matrix m(3, 3);
- * m.losuj();  // macierz zawiera losowe cyfry 0-9
- * @endcode
- * 
- * @warning Używa std::rand() - nie jest to generator o dobrych właściwościach
- *          statystycznych. Dla poważnych zastosowań użyj std::mt19937
- * 
- * @note Ziarna losowe są ustawiane przy każdym wywołaniu (time(0)),
- *       co może spowolnić program jeśli jest wywoływane wielokrotnie
- * 
- * @deprecated Rozważ użycie <random> zamiast rand()
- */
-matrix& matrix::losuj() {
-    srand(time(0));
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            data[i][j] = rand() % 10;
-        }
-    }
-    return *this;
-}
-
-/**
- * @brief Losuje `x` par współrzędnych i wstawia losowe cyfry
- * 
- * Wybiera `x` losowych pozycji w macierzy i wstawia w nich losowe cyfry 0-9.
- * Pozycje mogą się powtarzać (losowanie ze zwracaniem).
- * 
- * @param x liczba pozycji do wylosowania i wypełnienia
- * 
- * @return referencja na bieżącą macierz (zmodyfikowaną)
- * 
- * @post co najwyżej `x` losowych elementów zawiera losowe wartości z [0, 9]
- * @complexity O(x)
- * 
- * @example
- * @code
- * matrix m(5, 5, 0.0);
- * m.losuj(10);  // wypełni co najwyżej 10 losowych pozycji
- * @endcode
- * 
- * @note Liczba faktycznie zmienionych elementów może być mniejsza niż `x`
- *       ze względu na losowe powtórzenia pozycji
- * 
- * @warning Używa std::rand() - zobacz losuj() dla szczegółów
- * 
- * @deprecated Rozważ użycie <random> zamiast rand()
- * 
- * @see losuj()
- */
-matrix& matrix::losuj(int x) {
-    srand(time(0));
-    for (int i = 0; i < x; ++i) {
-        int row = rand() % rows;
-        int col = rand() % cols;
-        int value = rand() % 10;
-        data[row][col] = value;
-    }
-    return *this;
+template <typename T>
+int basic_matrix<T>::pokaz(int x, int y) {
+    return (*this)(x, y);
 }
 
 /**
@@ -218,18 +102,17 @@ matrix& matrix::losuj(int x) {
  * 
  * @see diagonalna_k()
  */
-matrix& matrix::diagonalna(int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::diagonalna(int* t) {
     // Wyzeruj całą macierz
     for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            data[i][j] = 0;
-        }
+        std::fill_n(row_ptr(i), cols, T(0));
     }
     
     // Wstaw wartości na głównej przekątnej
     int minDim = (rows < cols) ? rows : cols;
     for (int i = 0; i < minDim; ++i) {
-        data[i][i] = t[i];
+        (*this)(i, i) = t[i];
     }
     return *this;
 }
@@ -280,12 +163,11 @@ matrix& matrix::diagonalna(int* t) {
  * 
  * @see diagonalna()
  */
-matrix& matrix::diagonalna_k(int k, int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::diagonalna_k(int k, int* t) {
     // Wyzeruj całą macierz
     for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            data[i][j] = 0;
-        }
+        std::fill_n(row_ptr(i), cols, T(0));
     }
     
     if (k >= 0) {
@@ -293,7 +175,7 @@ matrix& matrix::diagonalna_k(int k, int* t) {
         for (int i = 0; i < rows; ++i) {
             int j = i + k;
             if (j < cols) {
-                data[i][j] = t[i];
+                (*this)(i, j) = t[i];
             }
         }
     } else {
@@ -301,7 +183,7 @@ matrix& matrix::diagonalna_k(int k, int* t) {
         int absk = -k;
         for (int i = absk; i < rows; ++i) {
             int j = i - absk;
-            data[i][j] = t[i - absk];
+            (*this)(i, j) = t[i - absk];
         }
     }
     return *this;
@@ -336,9 +218,10 @@ matrix& matrix::diagonalna_k(int k, int* t) {
  * 
  * @see wiersz()
  */
-matrix& matrix::kolumna(int x, int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::kolumna(int x, int* t) {
     for (int i = 0; i < rows; ++i) {
-        data[i][x] = t[i];
+        (*this)(i, x) = t[i];
     }
     return *this;
 }
@@ -372,9 +255,10 @@ matrix& matrix::kolumna(int x, int* t) {
  * 
  * @see kolumna()
  */
-matrix& matrix::wiersz(int y, int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::wiersz(int y, int* t) {
     for (int j = 0; j < cols; ++j) {
-        data[y][j] = t[j];
+        (*this)(y, j) = t[j];
     }
     return *this;
 }
@@ -405,14 +289,12 @@ matrix& matrix::wiersz(int y, int* t) {
  * 
  * @see pod_przekatna(), nad_przekatna()
  */
-matrix& matrix::przekatna() {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::przekatna() {
     for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            if (i == j) {
-                data[i][j] = 1;
-            } else {
-                data[i][j] = 0;
-            }
+        std::fill_n(row_ptr(i), cols, T(0));
+        if (i < cols) {
+            (*this)(i, i) = 1;
         }
     }
     return *this;
@@ -441,15 +323,12 @@ matrix& matrix::przekatna() {
  * 
  * @see nad_przekatna(), przekatna()
  */
-matrix& matrix::pod_przekatna() {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::pod_przekatna() {
     for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            if (i > j) {
-                data[i][j] = 1;
-            } else {
-                data[i][j] = 0;
-            }
-        }
+        const int jedynki = std::min(i, cols);
+        std::fill_n(row_ptr(i), jedynki, T(1));
+        std::fill_n(row_ptr(i) + jedynki, cols - jedynki, T(0));
     }
     return *this;
 }
@@ -477,15 +356,12 @@ matrix& matrix::pod_przekatna() {
  * 
  * @see pod_przekatna(), przekatna()
  */
-matrix& matrix::nad_przekatna() {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::nad_przekatna() {
     for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            if (i < j) {
-                data[i][j] = 1;
-            } else {
-                data[i][j] = 0;
-            }
-        }
+        const int zera = std::min(i + 1, cols);
+        std::fill_n(row_ptr(i), zera, T(0));
+        std::fill_n(row_ptr(i) + zera, cols - zera, T(1));
     }
     return *this;
 }
@@ -517,15 +393,35 @@ matrix& matrix::nad_przekatna() {
  * 
  * @see przekatna(), pod_przekatna(), nad_przekatna()
  */
-matrix& matrix::szachownica() {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::szachownica() {
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < cols; ++j) {
             if ((i + j) % 2 == 0) {
-                data[i][j] = 0;
+                (*this)(i, j) = 0;
             } else {
-                data[i][j] = 1;
+                (*this)(i, j) = 1;
             }
         }
     }
     return *this;
 }
+
+// Jawne konkretyzacje składowych zdefiniowanych w tym pliku
+#define MATRIX_KONKRETYZUJ_NARZEDZIA(T)                                   \
+    template basic_matrix<T>& basic_matrix<T>::wstaw(int, int, int);      \
+    template int basic_matrix<T>::pokaz(int, int);                        \
+    template basic_matrix<T>& basic_matrix<T>::diagonalna(int*);          \
+    template basic_matrix<T>& basic_matrix<T>::diagonalna_k(int, int*);   \
+    template basic_matrix<T>& basic_matrix<T>::kolumna(int, int*);        \
+    template basic_matrix<T>& basic_matrix<T>::wiersz(int, int*);         \
+    template basic_matrix<T>& basic_matrix<T>::przekatna();               \
+    template basic_matrix<T>& basic_matrix<T>::pod_przekatna();           \
+    template basic_matrix<T>& basic_matrix<T>::nad_przekatna();           \
+    template basic_matrix<T>& basic_matrix<T>::szachownica();
+
+MATRIX_KONKRETYZUJ_NARZEDZIA(double)
+MATRIX_KONKRETYZUJ_NARZEDZIA(float)
+MATRIX_KONKRETYZUJ_NARZEDZIA(std::int8_t)
+MATRIX_KONKRETYZUJ_NARZEDZIA(std::int32_t)
+MATRIX_KONKRETYZUJ_NARZEDZIA(std::int64_t)
@@ -0,0 +1,255 @@
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// @brief Domyślny próg pracy: poniżej ~128 tys. operacji budzenie wątków się nie opłaca
+constexpr std::size_t domyslny_prog = std::size_t{1} << 17;
+
+/// @brief Numer miejsca bieżącego wątku w puli (-1 poza pulą)
+thread_local int numer_watku = -1;
+
+/**
+ * @brief Kolejka zadań jednego wątku: ciągły zakres indeksów [lo, hi)
+ *
+ * Właściciel pobiera zadania z początku zakresu, złodziej odcina
+ * połowę z końca. Zakres chroniony jest własnym muteksem, więc wątki
+ * rywalizują tylko przy kradzieży.
+ */
+struct kolejka {
+    std::mutex m;
+    std::size_t lo = 0;
+    std::size_t hi = 0;
+};
+
+std::size_t domyslna_liczba_watkow() {
+    if (const char* env = std::getenv("MATRIX_THREADS")) {
+        const long n = std::strtol(env, nullptr, 10);
+        if (n > 0) return static_cast<std::size_t>(n);
+    }
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw ? hw : 1;
+}
+
+} // namespace
+
+struct thread_pool::impl {
+    /// Zmieniane przez set_threads() pod zadanie_m, czytane bez blokady
+    std::atomic<std::size_t> watki{1};
+    std::atomic<std::size_t> prog{domyslny_prog};
+
+    std::vector<std::thread> robotnicy;
+    std::unique_ptr<kolejka[]> kolejki;
+
+    /// Tylko jedno zadanie naraz; kolejne wywołania wykonują się szeregowo
+    std::mutex zadanie_m;
+
+    std::mutex m;
+    std::condition_variable start_cv;
+    std::condition_variable koniec_cv;
+    std::size_t pokolenie = 0;
+    std::size_t aktywni = 0;
+    bool stop = false;
+
+    void (*fn)(void*, std::size_t) = nullptr;
+    void* ctx = nullptr;
+    std::exception_ptr blad;
+
+    /// @brief Pobiera zadanie z własnej kolejki albo kradnie od innego wątku
+    bool pobierz(std::size_t ja, std::size_t& zadanie) {
+        const std::size_t w = watki.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(kolejki[ja].m);
+            if (kolejki[ja].lo < kolejki[ja].hi) {
+                zadanie = kolejki[ja].lo++;
+                return true;
+            }
+        }
+        for (std::size_t d = 1; d < w; ++d) {
+            kolejka& ofiara = kolejki[(ja + d) % w];
+            std::size_t lo, hi;
+            {
+                std::lock_guard<std::mutex> lock(ofiara.m);
+                if (ofiara.lo >= ofiara.hi) continue;
+                const std::size_t srodek = ofiara.lo + (ofiara.hi - ofiara.lo) / 2;
+                lo = srodek;
+                hi = ofiara.hi;
+                ofiara.hi = srodek;
+            }
+            std::lock_guard<std::mutex> lock(kolejki[ja].m);
+            kolejki[ja].lo = lo + 1;
+            kolejki[ja].hi = hi;
+            zadanie = lo;
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Wykonuje zadania, dopóki w żadnej kolejce nic nie zostało
+    void pracuj(std::size_t ja) {
+        std::size_t zadanie;
+        while (pobierz(ja, zadanie)) {
+            try {
+                fn(ctx, zadanie);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m);
+                if (!blad) blad = std::current_exception();
+            }
+        }
+    }
+
+    void petla_robotnika(std::size_t ja) {
+        numer_watku = static_cast<int>(ja);
+        std::size_t widziane = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                start_cv.wait(lock, [&] { return stop || pokolenie != widziane; });
+                if (stop) return;
+                widziane = pokolenie;
+            }
+            pracuj(ja);
+            std::lock_guard<std::mutex> lock(m);
+            if (--aktywni == 0) koniec_cv.notify_one();
+        }
+    }
+
+    void uruchom_robotnikow() {
+        kolejki = std::make_unique<kolejka[]>(watki);
+        stop = false;
+        pokolenie = 0;
+        for (std::size_t i = 1; i < watki; ++i) {
+            robotnicy.emplace_back(&impl::petla_robotnika, this, i);
+        }
+    }
+
+    void zatrzymaj_robotnikow() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        start_cv.notify_all();
+        for (auto& t : robotnicy) t.join();
+        robotnicy.clear();
+    }
+};
+
+thread_pool::thread_pool() : p(std::make_unique<impl>()) {
+    p->watki = domyslna_liczba_watkow();
+}
+
+thread_pool::~thread_pool() {
+    p->zatrzymaj_robotnikow();
+}
+
+/**
+ * @brief Globalna pula wątków biblioteki
+ *
+ * Obiekt statyczny funkcji - tworzony przy pierwszym użyciu,
+ * niszczony (z dołączeniem wątków) przy zakończeniu programu.
+ */
+thread_pool& thread_pool::instance() {
+    static thread_pool pula;
+    return pula;
+}
+
+/**
+ * @brief Zmienia liczbę wątków puli
+ *
+ * Czeka na zakończenie bieżącego zadania, zatrzymuje robotników;
+ * nowi zostaną uruchomieni przy następnym równoległym wywołaniu.
+ * Wywołanie z wnętrza zadania puli czekałoby na zakończenie samego
+ * siebie (i dołączało własny wątek), dlatego jest odrzucane.
+ *
+ * @param n liczba wątków łącznie z wywołującym (0 - hardware_concurrency())
+ * @throw std::runtime_error jeśli wywołanie pochodzi z wnętrza zadania puli
+ */
+void thread_pool::set_threads(std::size_t n) {
+    if (numer_watku >= 0)
+        throw std::runtime_error("Nie można zmienić liczby wątków z wnętrza zadania puli");
+    std::lock_guard<std::mutex> lock(p->zadanie_m);
+    p->zatrzymaj_robotnikow();
+    p->watki = n ? n : domyslna_liczba_watkow();
+}
+
+std::size_t thread_pool::get_threads() const noexcept {
+    return p->watki.load(std::memory_order_relaxed);
+}
+
+void thread_pool::set_serial_cutoff(std::size_t work) noexcept {
+    p->prog.store(work, std::memory_order_relaxed);
+}
+
+std::size_t thread_pool::get_serial_cutoff() const noexcept {
+    return p->prog.load(std::memory_order_relaxed);
+}
+
+bool thread_pool::should_parallelize(std::size_t work) const noexcept {
+    return get_threads() > 1 && numer_watku < 0 && work >= get_serial_cutoff();
+}
+
+/**
+ * @brief Rozdziela n zadań między wątki puli i czeka na ich wykonanie
+ *
+ * Zadania są dzielone na równe, ciągłe zakresy (po jednym na wątek),
+ * a nierównomierność obciążenia wyrównuje kradzież zadań. Gdy pula
+ * wykonuje już inne zadanie albo wywołanie jest zagnieżdżone,
+ * zadania wykonywane są szeregowo w wątku wywołującym.
+ *
+ * @param n liczba zadań
+ * @param fn funkcja zadania
+ * @param ctx kontekst przekazywany do fn
+ *
+ * @throw pierwszy wyjątek rzucony przez którekolwiek zadanie
+ */
+void thread_pool::run(std::size_t n, void (*fn)(void*, std::size_t), void* ctx) {
+    std::unique_lock<std::mutex> zadanie(p->zadanie_m, std::defer_lock);
+    if (n < 2 || get_threads() < 2 || numer_watku >= 0 || !zadanie.try_lock()) {
+        for (std::size_t i = 0; i < n; ++i) fn(ctx, i);
+        return;
+    }
+    // Pod zadanie_m liczba watkow juz sie nie zmieni
+    const std::size_t w = get_threads();
+    if (w < 2) {
+        for (std::size_t i = 0; i < n; ++i) fn(ctx, i);
+        return;
+    }
+    if (p->robotnicy.empty()) {
+        p->uruchom_robotnikow();
+    }
+
+    for (std::size_t i = 0; i < w; ++i) {
+        std::lock_guard<std::mutex> lock(p->kolejki[i].m);
+        p->kolejki[i].lo = n * i / w;
+        p->kolejki[i].hi = n * (i + 1) / w;
+    }
+    {
+        std::lock_guard<std::mutex> lock(p->m);
+        p->fn = fn;
+        p->ctx = ctx;
+        p->blad = nullptr;
+        p->aktywni = w - 1;
+        ++p->pokolenie;
+    }
+    p->start_cv.notify_all();
+
+    numer_watku = 0;
+    p->pracuj(0);
+    numer_watku = -1;
+
+    std::exception_ptr blad;
+    {
+        std::unique_lock<std::mutex> lock(p->m);
+        p->koniec_cv.wait(lock, [&] { return p->aktywni == 0; });
+        blad = p->blad;
+    }
+    if (blad) std::rethrow_exception(blad);
+}
@@ -0,0 +1,94 @@
+#include "test.h"
+#include "../include/thread_pool.h"
+#include "../src/matrix_simd.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+int bledy_przypadku = 0;
+
+} // namespace
+
+std::vector<test::przypadek>& test::rejestr() {
+    static std::vector<przypadek> r;
+    return r;
+}
+
+void test::zglos(const char* plik, int linia, const char* warunek) {
+    std::printf("  %s:%d: %s\n", plik, linia, warunek);
+    ++bledy_przypadku;
+}
+
+matrix test::losowa(std::size_t rows, std::size_t cols, std::uint64_t ziarno, double lo, double hi) {
+    std::mt19937_64 g(ziarno);
+    std::uniform_real_distribution<double> d(lo, hi);
+    matrix m(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) m(i, j) = d(g);
+    }
+    return m;
+}
+
+matrix test::naiwny_iloczyn(const_matrix_view A, const_matrix_view B) {
+    matrix C(A.get_rows(), B.get_cols());
+    for (std::size_t i = 0; i < A.get_rows(); ++i) {
+        for (std::size_t j = 0; j < B.get_cols(); ++j) {
+            double s = 0.0;
+            for (std::size_t p = 0; p < A.get_cols(); ++p) s += A(i, p) * B(p, j);
+            C(i, j) = s;
+        }
+    }
+    return C;
+}
+
+double test::max_roznica(const_matrix_view A, const_matrix_view B) {
+    if (A.get_rows() != B.get_rows() || A.get_cols() != B.get_cols()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double e = 0.0;
+    for (std::size_t i = 0; i < A.get_rows(); ++i) {
+        for (std::size_t j = 0; j < A.get_cols(); ++j) {
+            const double d = std::fabs(A(i, j) - B(i, j));
+            e = d > e || std::isnan(d) ? d : e;
+        }
+    }
+    return e;
+}
+
+/**
+ * @brief Wykonuje wszystkie przypadki (lub te, których nazwa zawiera argv[1])
+ *
+ * Próg pracy szeregowej jest obniżany do zera, żeby przy MATRIX_THREADS > 1
+ * także małe macierze testowe przechodziły przez ścieżki równoległe.
+ *
+ * @return 0, jeśli wszystkie asercje są spełnione, 1 w przeciwnym razie
+ */
+int main(int argc, char** argv) {
+    auto& pula = thread_pool::instance();
+    pula.set_serial_cutoff(0);
+    std::printf("isa: %s, watki: %zu\n", detail::kernels().nazwa, pula.get_threads());
+
+    int nieudane = 0, wykonane = 0;
+    for (const auto& p : test::rejestr()) {
+        if (argc > 1 && !std::strstr(p.nazwa, argv[1])) continue;
+        bledy_przypadku = 0;
+        try {
+            p.f();
+        } catch (const std::exception& e) {
+            std::printf("  nieoczekiwany wyjatek: %s\n", e.what());
+            ++bledy_przypadku;
+        }
+        ++wykonane;
+        if (bledy_przypadku) {
+            ++nieudane;
+            std::printf("BLAD %s\n", p.nazwa);
+        }
+    }
+    std::printf("%d/%d przypadkow poprawnych\n", wykonane - nieudane, wykonane);
+    return nieudane ? 1 : 0;
+}
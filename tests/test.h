@@ -0,0 +1,69 @@
+#pragma once
+#include "../include/matrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @file test.h
+/// @brief Minimalny zestaw testow: rejestracja przypadkow, asercje, wzorce naiwne
+///
+/// Kazdy plik tests/test_*.cpp definiuje przypadki makrem TEST; program
+/// testowy (tests/main.cpp) wykonuje je wszystkie i konczy sie kodem 1,
+/// jesli ktorakolwiek asercja zawiodla. Wyniki jader SIMD, silnika GEMM
+/// i puli watkow sa porownywane z prostymi petlami, wiec ten sam program
+/// uruchamiany pod kazda wartoscia MATRIX_ISA i MATRIX_THREADS
+/// (`./run.sh test`) sprawdza wszystkie warianty.
+
+namespace test {
+
+/// @brief Przypadek testowy: nazwa i funkcja
+struct przypadek {
+    const char* nazwa;
+    void (*f)();
+};
+
+/// @brief Wszystkie zarejestrowane przypadki (w kolejnosci inicjalizacji plikow)
+std::vector<przypadek>& rejestr();
+
+/// @brief Rejestruje przypadek w konstruktorze obiektu statycznego
+struct rejestracja {
+    rejestracja(const char* nazwa, void (*f)()) { rejestr().push_back({nazwa, f}); }
+};
+
+/// @brief Zglasza niespelniona asercje (plik, linia, tekst warunku)
+void zglos(const char* plik, int linia, const char* warunek);
+
+/// @brief Macierz rows x cols o elementach jednostajnych z [lo, hi) (deterministyczna dla ziarna)
+matrix losowa(std::size_t rows, std::size_t cols, std::uint64_t ziarno, double lo = -1.0, double hi = 1.0);
+
+/// @brief Iloczyn potrojna petla (wzorzec dla wszystkich mnozen)
+matrix naiwny_iloczyn(const_matrix_view A, const_matrix_view B);
+
+/// @brief Najwieksza roznica elementow; nieskonczonosc przy roznych wymiarach
+double max_roznica(const_matrix_view A, const_matrix_view B);
+
+} // namespace test
+
+/// @brief Definiuje i rejestruje przypadek testowy
+#define TEST(nazwa)                                              \
+    static void nazwa();                                         \
+    static const test::rejestracja nazwa##_rejestracja(#nazwa, nazwa); \
+    static void nazwa()
+
+/// @brief Asercja - niespelniony warunek jest zglaszany, test trwa dalej
+#define SPRAWDZ(warunek)                                          \
+    do {                                                         \
+        if (!(warunek)) test::zglos(__FILE__, __LINE__, #warunek); \
+    } while (0)
+
+/// @brief Asercja, ze wyrazenie rzuca std::runtime_error
+#define SPRAWDZ_WYJATEK(wyrazenie)                                       \
+    do {                                                                \
+        bool rzucil_ = false;                                           \
+        try {                                                           \
+            (void)(wyrazenie);                                          \
+        } catch (const std::runtime_error&) {                           \
+            rzucil_ = true;                                             \
+        }                                                               \
+        if (!rzucil_) test::zglos(__FILE__, __LINE__, "wyjatek: " #wyrazenie); \
+    } while (0)
@@ -0,0 +1,127 @@
+#include "test.h"
+
+// Wyrazenia, ktorych wynik jest jednym z operandow w innym ukladzie
+// (transpozycja, przesuniety blok), porownywane z wynikiem liczonym na kopii.
+
+namespace {
+
+/// Macierz o elementach f(i, j) dla i < rows, j < cols
+template <typename F>
+matrix wedlug(std::size_t rows, std::size_t cols, F f) {
+    matrix m(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) m(i, j) = f(i, j);
+    }
+    return m;
+}
+
+} // namespace
+
+TEST(aliasing_transpozycja) {
+    // n > 8 - przebiegi wyrazen sa dluzsze niz blok transpozycji
+    for (std::size_t n : {1, 5, 8, 9, 17, 64, 300}) {
+        const matrix A0 = test::losowa(n, n, n);
+        const matrix symetryczna = wedlug(n, n, [&](std::size_t i, std::size_t j) { return A0(i, j) + A0(j, i); });
+
+        matrix A = A0;
+        A = A + A.transpose();
+        SPRAWDZ(test::max_roznica(A, symetryczna) == 0.0);
+
+        matrix B = A0;
+        B = B.transpose() * 2;
+        SPRAWDZ(test::max_roznica(B, wedlug(n, n, [&](std::size_t i, std::size_t j) { return 2 * A0(j, i); })) == 0.0);
+
+        matrix D = A0;
+        D.transpose() = D + 1;
+        SPRAWDZ(test::max_roznica(D, wedlug(n, n, [&](std::size_t i, std::size_t j) { return A0(j, i) + 1; })) == 0.0);
+
+        matrix E = A0;
+        E.view() += E.transpose();
+        SPRAWDZ(test::max_roznica(E, symetryczna) == 0.0);
+
+        // ten sam uklad - liczone w miejscu
+        matrix F = A0;
+        F = F * 3 - 1;
+        SPRAWDZ(test::max_roznica(F, wedlug(n, n, [&](std::size_t i, std::size_t j) { return A0(i, j) * 3 - 1; })) == 0.0);
+    }
+}
+
+TEST(aliasing_przesuniety_blok) {
+    for (std::size_t n : {2, 9, 70}) {
+        const matrix A0 = test::losowa(n, n, n + 100);
+        matrix G = A0;
+        G.block(0, 1, n, n - 1) = G.block(0, 0, n, n - 1) + 1;
+        matrix wzorzec = A0;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 1; j < n; ++j) wzorzec(i, j) = A0(i, j - 1) + 1;
+        }
+        SPRAWDZ(test::max_roznica(G, wzorzec) == 0.0);
+    }
+}
+
+TEST(aliasing_zmiana_wymiarow) {
+    // wynik niekwadratowy zmienia wymiary, a operand wskazuje na stary bufor
+    const matrix A0 = test::losowa(7, 13, 1);
+    matrix A = A0;
+    A = A.transpose() + 1;
+    SPRAWDZ(test::max_roznica(A, wedlug(13, 7, [&](std::size_t i, std::size_t j) { return A0(j, i) + 1; })) == 0.0);
+
+    matrix C = A0;
+    gemm_into(C, C, test::losowa(13, 4, 2));
+    SPRAWDZ(test::max_roznica(C, test::naiwny_iloczyn(A0, test::losowa(13, 4, 2))) <= 1e-14);
+}
+
+TEST(aliasing_gemm) {
+    const matrix A = test::losowa(20, 20, 4), B = test::losowa(20, 20, 5);
+    matrix C = A;
+    gemm(C, C, B);
+    SPRAWDZ(test::max_roznica(C, test::naiwny_iloczyn(A, B)) <= 1e-14);
+    C = A;
+    gemm(C, B, C.transpose());
+    SPRAWDZ(test::max_roznica(C, test::naiwny_iloczyn(B, A.transpose())) <= 1e-14);
+}
+
+TEST(konstrukcja_z_widoku) {
+    const matrix A = test::losowa(30, 20, 3);
+    matrix T = A.transpose();
+    SPRAWDZ(T == A.transpose() && T.get_rows() == 20);
+    matrix A2 = A;
+    matrix T2 = A2.transpose();
+    SPRAWDZ(T2 == A.transpose());
+    matrix Bk = A2.block(1, 2, 5, 6);
+    SPRAWDZ(Bk == A.block(1, 2, 5, 6));
+    Bk = A.row(4);
+    SPRAWDZ(Bk == A.row(4) && Bk.get_rows() == 1);
+
+    const matrix B = test::losowa(20, 20, 5);
+    matrix C(30, 20);
+    gemm(C, A, B.transpose());
+    SPRAWDZ(test::max_roznica(C, test::naiwny_iloczyn(A, B.transpose())) <= 1e-14);
+    SPRAWDZ(test::max_roznica(A * B.block(0, 0, 20, 20), A * B) <= 1e-14);
+    SPRAWDZ(A == A.view());
+}
+
+TEST(aliasing_kopia_przesunieta) {
+    // kopia miedzy nakladajacymi sie fragmentami tej samej macierzy
+    for (std::size_t n : {2, 9, 70}) {
+        const matrix A0 = test::losowa(n, n, n + 200);
+        matrix A = A0;
+        A.row_block(1, n - 1) = A.row_block(0, n - 1);
+        matrix B = A0;
+        B.col_block(0, n - 1) = B.col_block(1, n - 1);
+        matrix C = A0;
+        C.block(1, 1, n - 1, n - 1) = C.block(0, 0, n - 1, n - 1).transpose();
+        matrix D = A0;
+        D += D.transpose();
+        bool zgodne = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                zgodne = zgodne && A(i, j) == (i ? A0(i - 1, j) : A0(0, j));
+                zgodne = zgodne && B(i, j) == (j + 1 < n ? A0(i, j + 1) : A0(i, j));
+                zgodne = zgodne && C(i, j) == (i && j ? A0(j - 1, i - 1) : A0(i, j));
+                zgodne = zgodne && D(i, j) == A0(i, j) + A0(j, i);
+            }
+        }
+        SPRAWDZ(zgodne);
+    }
+}
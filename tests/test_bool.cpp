@@ -0,0 +1,72 @@
+#include "test.h"
+#include "../include/bool_matrix.h"
+#include <random>
+
+// Iloczyn logiczny i domkniecie przechodnie porownywane z petlami na bool.
+
+namespace {
+
+bool_matrix losowa_logiczna(std::size_t rows, std::size_t cols, double gestosc, std::uint64_t ziarno) {
+    std::mt19937_64 g(ziarno);
+    std::bernoulli_distribution d(gestosc);
+    bool_matrix m(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) m.set(i, j, d(g));
+    }
+    return m;
+}
+
+bool_matrix naiwny_iloczyn_logiczny(const bool_matrix& A, const bool_matrix& B) {
+    bool_matrix C(A.get_rows(), B.get_cols());
+    for (std::size_t i = 0; i < A.get_rows(); ++i) {
+        for (std::size_t j = 0; j < B.get_cols(); ++j) {
+            bool s = false;
+            for (std::size_t p = 0; !s && p < A.get_cols(); ++p) s = A(i, p) && B(p, j);
+            C.set(i, j, s);
+        }
+    }
+    return C;
+}
+
+} // namespace
+
+TEST(bool_iloczyn) {
+    for (std::size_t n : {1, 5, 63, 64, 65, 130, 257}) {
+        const bool_matrix A = losowa_logiczna(n, n + 7, 0.05, n), B = losowa_logiczna(n + 7, n + 1, 0.05, n + 1);
+        SPRAWDZ(A * B == naiwny_iloczyn_logiczny(A, B));
+    }
+    const bool_matrix A = losowa_logiczna(70, 70, 0.3, 1), B = losowa_logiczna(70, 70, 0.4, 2);
+    bool_matrix I = A, S = A, X = A;
+    I &= B;
+    S |= B;
+    X ^= B;
+    bool zgodne = true;
+    for (std::size_t i = 0; i < 70; ++i) {
+        for (std::size_t j = 0; j < 70; ++j) {
+            zgodne = zgodne && I(i, j) == (A(i, j) && B(i, j)) && S(i, j) == (A(i, j) || B(i, j)) &&
+                     X(i, j) == (A(i, j) != B(i, j)) && (~A)(i, j) == !A(i, j);
+        }
+    }
+    SPRAWDZ(zgodne);
+    SPRAWDZ(bool_matrix(A.to_matrix()) == A);
+}
+
+TEST(bool_domkniecie) {
+    for (std::size_t n : {1, 9, 64, 100, 200}) {
+        const bool_matrix A = losowa_logiczna(n, n, 1.5 / static_cast<double>(n), n);
+        // Warshall na bool jako wzorzec
+        bool_matrix W = A;
+        for (std::size_t k = 0; k < n; ++k) {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!W(i, k)) continue;
+                for (std::size_t j = 0; j < n; ++j) {
+                    if (W(k, j)) W.set(i, j, true);
+                }
+            }
+        }
+        const bool_matrix D = transitive_closure(A);
+        SPRAWDZ(D == W);
+        SPRAWDZ(D.count() >= A.count());
+    }
+    SPRAWDZ_WYJATEK(transitive_closure(bool_matrix(3, 4)));
+}
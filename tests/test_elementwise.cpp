@@ -0,0 +1,115 @@
+#include "test.h"
+#include <cstdint>
+
+// Dzialania element po elemencie (jadra SIMD, wyrazenia leniwe, widoki)
+// i transpozycja porownywane z pojedynczymi petlami.
+
+TEST(elementwise_operatory) {
+    for (std::size_t n : {1, 3, 7, 16, 33, 130}) {
+        const matrix A = test::losowa(n, n + 5, n), B = test::losowa(n, n + 5, n + 1000);
+        matrix wzorzec(n, n + 5);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n + 5; ++j) wzorzec(i, j) = 2.0 * A(i, j) - B(i, j) + 0.5;
+        }
+        matrix C = A;
+        C *= 2.0;
+        C -= B;
+        C += 0.5;
+        SPRAWDZ(test::max_roznica(C, wzorzec) <= 1e-15);
+        SPRAWDZ(test::max_roznica(matrix(2.0 * A - B + 0.5), wzorzec) <= 1e-15);
+        const matrix D = A * 2.0 - B + 0.5;
+        SPRAWDZ(test::max_roznica(D, wzorzec) <= 1e-15);
+        SPRAWDZ(D == D && !(D == A));
+    }
+    const matrix A = test::losowa(4, 5, 1);
+    SPRAWDZ_WYJATEK(matrix(A + test::losowa(5, 4, 2)));
+}
+
+TEST(elementwise_widoki) {
+    const matrix A = test::losowa(40, 50, 3);
+    matrix C(40, 50, 1.0);
+    C.block(5, 7, 20, 30) += A.block(0, 0, 20, 30);
+    C.row(3) = A.row(9);
+    C.col(45) *= -2.0;
+    matrix wzorzec(40, 50, 1.0);
+    for (std::size_t i = 0; i < 20; ++i) {
+        for (std::size_t j = 0; j < 30; ++j) wzorzec(i + 5, j + 7) += A(i, j);
+    }
+    for (std::size_t j = 0; j < 50; ++j) wzorzec(3, j) = A(9, j);
+    for (std::size_t i = 0; i < 40; ++i) wzorzec(i, 45) *= -2.0;
+    SPRAWDZ(test::max_roznica(C, wzorzec) == 0.0);
+
+    matrix D(50, 40);
+    D.view() = A.transpose();
+    for (std::size_t i = 0; i < 40; ++i) {
+        for (std::size_t j = 0; j < 50; ++j) SPRAWDZ(D(j, i) == A(i, j));
+    }
+}
+
+TEST(transpozycja) {
+    for (std::size_t r : {1, 2, 5, 8, 17, 64, 129, 300}) {
+        for (std::size_t c : {std::size_t(1), std::size_t(7), r, r + 9}) {
+            const matrix A = test::losowa(r, c, r * 31 + c);
+            matrix B;
+            transpose_into(B, A);
+            bool zgodna = B.get_rows() == c && B.get_cols() == r;
+            for (std::size_t i = 0; zgodna && i < r; ++i) {
+                for (std::size_t j = 0; j < c; ++j) zgodna = zgodna && B(j, i) == A(i, j);
+            }
+            SPRAWDZ(zgodna);
+
+            const matrix_f32 Af(A);
+            matrix_f32 Bf;
+            transpose_into(Bf, Af);
+            SPRAWDZ(Bf.get_rows() == c && Bf(c - 1, 0) == Af(0, c - 1));
+        }
+    }
+    // w miejscu, takze dla macierzy prostokatnej
+    matrix A = test::losowa(37, 90, 5);
+    const matrix kopia = A;
+    transpose_into(A, A);
+    SPRAWDZ(A.get_rows() == 90 && A.get_cols() == 37);
+    SPRAWDZ(A(89, 36) == kopia(36, 89) && A(1, 0) == kopia(0, 1));
+}
+
+TEST(transpozycja_w_miejscu) {
+    // kafle 64 x 64: rozmiary wokol granic jednego i dwoch kafli; n x (n + 3)
+    // przechodzi przez sciezke prostokatna z nowym buforem
+    for (std::size_t n : {1, 2, 7, 63, 64, 65, 127, 128, 129, 200}) {
+        for (std::size_t c : {n, n + 3}) {
+            const matrix A = test::losowa(n, c, n * 7 + c);
+            const matrix_f32 Af(A);
+            matrix B = A;
+            matrix_f32 Bf = Af;
+            SPRAWDZ(&B.dowroc() == &B && &Bf.dowroc() == &Bf);
+            bool zgodna = B.get_rows() == c && B.get_cols() == n && Bf.get_rows() == c && Bf.get_cols() == n;
+            for (std::size_t i = 0; zgodna && i < n; ++i) {
+                for (std::size_t j = 0; j < c; ++j) zgodna = zgodna && B(j, i) == A(i, j) && Bf(j, i) == Af(i, j);
+            }
+            SPRAWDZ(zgodna);
+            SPRAWDZ(B.dowroc() == A && Bf.dowroc() == Af);
+        }
+    }
+}
+
+TEST(elementwise_dodawanie_widokow) {
+    const matrix B = test::losowa(10, 12, 7), C = test::losowa(10, 12, 8);
+    matrix Bz = B;
+    matrix A = test::losowa(4, 4, 6);
+    const matrix A0 = A;
+    A += B.block(0, 0, 4, 4);
+    A -= Bz.row_block(0, 4).col_block(2, 4);
+    A += B.block(2, 3, 4, 4).transpose();
+    matrix wzorzec(4, 4);
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) wzorzec(i, j) = A0(i, j) + B(i, j) - B(i, j + 2) + B(j + 2, i + 3);
+    }
+    SPRAWDZ(test::max_roznica(A, wzorzec) <= 1e-15);
+
+    matrix D = B;
+    D += C * 2 - 1;
+    D -= B + C;
+    SPRAWDZ(test::max_roznica(D, matrix(C - 1)) <= 1e-15);
+    SPRAWDZ_WYJATEK(A += B.block(0, 0, 4, 5));
+    SPRAWDZ_WYJATEK(A -= B + C);
+}
@@ -0,0 +1,62 @@
+#include "test.h"
+#include "../include/fixed_matrix.h"
+
+// fixed_matrix: dzialania liczone w czasie kompilacji, iloczyny porownywane
+// z matrix::operator* i konwersje do / z matrix.
+
+namespace {
+
+constexpr matrix3 obrot{{0, -1, 0}, {1, 0, 0}, {0, 0, 1}};
+constexpr matrix3 przesuniecie{{1, 0, 2}, {0, 1, 3}, {0, 0, 1}};
+constexpr matrix3 jednostkowa{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+constexpr fixed_matrix<2, 3> prostokatna{{1, 2, 3}, {4, 5, 6}};
+
+constexpr matrix3 dowrocona(matrix3 m) { return m.dowroc(); }
+
+// static_assert wymaga, zeby iloczyny i sumy byly wyrazeniami stalymi
+static_assert(obrot * obrot * obrot * obrot == jednostkowa, "obrot o 90 stopni czterokrotnie");
+static_assert(przesuniecie * obrot == matrix3{{0, -1, 2}, {1, 0, 3}, {0, 0, 1}}, "iloczyn 3x3");
+static_assert(prostokatna * prostokatna.transponowana() == fixed_matrix<2, 2>{{14, 32}, {32, 77}},
+              "iloczyn prostokatny");
+static_assert(matrix4(1.0) * matrix4(2.0) == matrix4(8.0), "iloczyn 4x4");
+static_assert(obrot + przesuniecie - obrot == przesuniecie, "suma i roznica");
+static_assert(2.0 * obrot == obrot * 2.0 && (2.0 * obrot)(1, 0) == 2.0, "mnozenie przez skalar");
+static_assert(dowrocona(przesuniecie) == przesuniecie.transponowana(), "transpozycja w miejscu");
+static_assert(matrix4::size() == 16 && fixed_matrix<2, 3>::get_cols() == 3, "wymiary");
+
+template <std::size_t R, std::size_t K, std::size_t C>
+bool iloczyn_zgodny(std::uint64_t ziarno) {
+    const matrix A = test::losowa(R, K, ziarno), B = test::losowa(K, C, ziarno + 1);
+    const matrix W = (fixed_matrix<R, K>(A) * fixed_matrix<K, C>(B)).to_matrix();
+    // ta sama kolejnosc sumowania co matrix::operator*, wiec wyniki sa identyczne
+    return W == A * B && test::max_roznica(W, test::naiwny_iloczyn(A, B)) == 0.0;
+}
+
+} // namespace
+
+TEST(fixed_iloczyn) {
+    SPRAWDZ((iloczyn_zgodny<3, 3, 3>(1)));
+    SPRAWDZ((iloczyn_zgodny<4, 4, 4>(2)));
+    SPRAWDZ((iloczyn_zgodny<2, 5, 3>(3)));
+    SPRAWDZ((iloczyn_zgodny<7, 1, 6>(4)));
+    SPRAWDZ((iloczyn_zgodny<8, 9, 6>(5)));
+}
+
+TEST(fixed_konwersje) {
+    const matrix M = test::losowa(4, 4, 6);
+    const matrix4 F(M);
+    SPRAWDZ(F.to_matrix() == M);
+    SPRAWDZ(F(3, 1) == M(3, 1) && F.transponowana()(1, 3) == M(3, 1));
+    matrix4 G = F;
+    G.dowroc();
+    SPRAWDZ(G.to_matrix() == M.transpose());
+    SPRAWDZ((F + G).to_matrix() == matrix(M + M.transpose()));
+
+    const fixed_matrix<2, 5> P(test::losowa(2, 5, 7));
+    SPRAWDZ((fixed_matrix<2, 5>(P.to_matrix()) == P));
+
+    SPRAWDZ_WYJATEK(matrix4(test::losowa(4, 3, 8)));
+    SPRAWDZ_WYJATEK(matrix3(test::losowa(4, 3, 8)));
+    SPRAWDZ_WYJATEK((matrix3{{1, 2, 3}, {4, 5}}));
+    SPRAWDZ_WYJATEK((matrix3{{1, 2, 3}}));
+}
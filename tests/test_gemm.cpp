@@ -0,0 +1,194 @@
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Iloczyny porownywane z potrojna petla; tolerancja k * 1e-15 odpowiada
+// ograniczeniu k u |A| |B| dla elementow z [-1, 1).
+
+namespace {
+
+double tolerancja(std::size_t k) { return 1e-15 * static_cast<double>(k + 8); }
+
+template <typename T>
+basic_matrix<T> losowa_calkowita(std::size_t rows, std::size_t cols, std::uint64_t ziarno, int lo, int hi) {
+    std::mt19937_64 g(ziarno);
+    std::uniform_int_distribution<int> d(lo, hi);
+    basic_matrix<T> m(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) m(i, j) = static_cast<T>(d(g));
+    }
+    return m;
+}
+
+template <typename T>
+bool iloczyn_calkowity_zgodny(const basic_matrix<T>& A, const basic_matrix<T>& B) {
+    using W = akumulator_t<T>;
+    const basic_matrix<W> C = A * B;
+    if (C.get_rows() != A.get_rows() || C.get_cols() != B.get_cols()) return false;
+    for (std::size_t i = 0; i < A.get_rows(); ++i) {
+        for (std::size_t j = 0; j < B.get_cols(); ++j) {
+            W s = 0;
+            for (std::size_t p = 0; p < A.get_cols(); ++p) s += W(A(i, p)) * W(B(p, j));
+            if (C(i, j) != s) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(gemm_rozmiary_brzegowe) {
+    // rozmiary wokol krokow mikrojader (4, 6, 8, 16) i blokow pakowania
+    const std::size_t wymiary[] = {1, 2, 3, 5, 7, 8, 9, 15, 17, 31, 33, 65, 130};
+    std::uint64_t ziarno = 1;
+    for (std::size_t m : wymiary) {
+        for (std::size_t n : {std::size_t(1), std::size_t(6), std::size_t(13), m}) {
+            for (std::size_t k : {std::size_t(1), std::size_t(4), m + 3}) {
+                const matrix A = test::losowa(m, k, ziarno++), B = test::losowa(k, n, ziarno++);
+                SPRAWDZ(test::max_roznica(A * B, test::naiwny_iloczyn(A, B)) <= tolerancja(k));
+            }
+        }
+    }
+}
+
+TEST(gemm_duzy_nieparzysty) {
+    // przekracza bloki KC i MC, wiec obejmuje wszystkie petle silnika
+    const matrix A = test::losowa(301, 517, 11), B = test::losowa(517, 263, 12);
+    SPRAWDZ(test::max_roznica(A * B, test::naiwny_iloczyn(A, B)) <= tolerancja(517));
+}
+
+TEST(gemm_alpha_beta_transpozycje) {
+    const matrix A = test::losowa(37, 29, 21), B = test::losowa(29, 41, 22);
+    const matrix At = test::losowa(29, 37, 23), Bt = test::losowa(41, 29, 24);
+    const matrix C0 = test::losowa(37, 41, 25);
+    const matrix AtB = test::naiwny_iloczyn(At.transpose(), B), ABt = test::naiwny_iloczyn(A, Bt.transpose());
+
+    matrix C = C0;
+    gemm(C, A, B, 2.0, 0.5);
+    matrix oczekiwana = test::naiwny_iloczyn(A, B) * 2.0 + C0 * 0.5;
+    SPRAWDZ(test::max_roznica(C, oczekiwana) <= 4 * tolerancja(29));
+
+    C = C0;
+    gemm(C, At, Bt, 1.0, 0.0, trans::transpose, trans::transpose);
+    SPRAWDZ(test::max_roznica(C, test::naiwny_iloczyn(At.transpose(), Bt.transpose())) <= tolerancja(29));
+
+    SPRAWDZ(test::max_roznica(mul_tn(At, B), AtB) <= tolerancja(29));
+    SPRAWDZ(test::max_roznica(mul_nt(A, Bt), ABt) <= tolerancja(29));
+
+    matrix D;
+    gemm_into(D, At, B, trans::transpose);
+    SPRAWDZ(test::max_roznica(D, AtB) <= tolerancja(29));
+
+    // beta == 0 ignoruje NaN w C
+    C = matrix(37, 41, std::numeric_limits<double>::quiet_NaN());
+    gemm(C, A, B);
+    SPRAWDZ(test::max_roznica(C, test::naiwny_iloczyn(A, B)) <= tolerancja(29));
+
+    SPRAWDZ_WYJATEK(A * A);
+}
+
+TEST(gemm_widoki) {
+    const matrix A = test::losowa(70, 50, 31), B = test::losowa(50, 90, 32);
+    matrix C(100, 100, 7.0);
+    gemm(C.block(10, 5, 33, 47), A.block(3, 2, 33, 40), B.block(4, 20, 40, 47));
+    SPRAWDZ(test::max_roznica(C.block(10, 5, 33, 47),
+                              test::naiwny_iloczyn(A.block(3, 2, 33, 40), B.block(4, 20, 40, 47))) <= tolerancja(40));
+    SPRAWDZ(C(9, 5) == 7.0 && C(43, 5) == 7.0 && C(10, 4) == 7.0 && C(10, 52) == 7.0);
+
+    const matrix P = A.col(7) * B.row(3);
+    SPRAWDZ(test::max_roznica(P, test::naiwny_iloczyn(A.col(7), B.row(3))) == 0.0);
+    const matrix Q = A.transpose() * A;
+    SPRAWDZ(test::max_roznica(Q, test::naiwny_iloczyn(A.transpose(), A)) <= tolerancja(70));
+}
+
+TEST(strassen_rozmiary_nieparzyste) {
+    const std::size_t prog = get_strassen_crossover();
+    set_strassen_crossover(16);
+    const std::size_t wymiary[][3] = {{64, 64, 64}, {65, 67, 63}, {97, 33, 129}, {130, 71, 99}, {1, 80, 80}};
+    std::uint64_t ziarno = 41;
+    for (const auto& w : wymiary) {
+        const matrix A = test::losowa(w[0], w[1], ziarno++), B = test::losowa(w[1], w[2], ziarno++);
+        const matrix wzorzec = test::naiwny_iloczyn(A, B);
+        // ograniczenie normowe Strassena jest luzniejsze niz klasyczne
+        SPRAWDZ(test::max_roznica(multiply(A, B, mul_algo::strassen), wzorzec) <= 1e-11);
+        SPRAWDZ(test::max_roznica(multiply(A, B, mul_algo::classic), wzorzec) <= tolerancja(w[1]));
+        SPRAWDZ(test::max_roznica(multiply(A, B, mul_algo::automatic), wzorzec) <= 1e-11);
+    }
+    set_strassen_crossover(prog);
+}
+
+TEST(gemm_wsadowy) {
+    for (std::size_t m : {1, 3, 4, 8, 11}) {
+        for (std::size_t k : {0, 1, 2, 5, 8, 9}) {
+            const std::size_t n = m == 11 ? 3 : m, count = 37;
+            std::vector<double> a(count * m * k), b(count * k * n), c(count * m * n, 99.0);
+            std::mt19937_64 g(m * 100 + k);
+            std::uniform_real_distribution<double> d(-1.0, 1.0);
+            for (double& x : a) x = d(g);
+            for (double& x : b) x = d(g);
+            gemm_batched(count, m, n, k, a.data(), b.data(), c.data());
+            double e = 0.0;
+            for (std::size_t q = 0; q < count; ++q) {
+                for (std::size_t i = 0; i < m; ++i) {
+                    for (std::size_t j = 0; j < n; ++j) {
+                        double s = 0.0;
+                        for (std::size_t p = 0; p < k; ++p) s += a[q * m * k + i * k + p] * b[q * k * n + p * n + j];
+                        e = std::max(e, std::fabs(c[q * m * n + i * n + j] - s));
+                    }
+                }
+            }
+            // k == 0 daje macierze zerowe (poprzednia zawartosc C jest nadpisywana)
+            SPRAWDZ(e <= tolerancja(k));
+        }
+    }
+}
+
+TEST(gemm_lancuch) {
+    const matrix A = test::losowa(10, 40, 51), B = test::losowa(40, 5, 52), C = test::losowa(5, 30, 53);
+    const matrix D = test::losowa(30, 2, 54);
+    const matrix wzorzec = test::naiwny_iloczyn(test::naiwny_iloczyn(test::naiwny_iloczyn(A, B), C), D);
+    SPRAWDZ(test::max_roznica(multiply_chain({A, B, C, D}), wzorzec) <= 1e-12);
+    SPRAWDZ(test::max_roznica(multiply_chain({A}), A) == 0.0);
+    SPRAWDZ_WYJATEK(multiply_chain({A, A}));
+}
+
+TEST(gemm_calkowite) {
+    std::uint64_t ziarno = 61;
+    for (std::size_t n : {1, 5, 16, 33, 70}) {
+        const auto A8 = losowa_calkowita<std::int8_t>(n, n + 3, ziarno++, -128, 127);
+        const auto B8 = losowa_calkowita<std::int8_t>(n + 3, n + 1, ziarno++, -128, 127);
+        SPRAWDZ(iloczyn_calkowity_zgodny(A8, B8));
+        const auto A32 = losowa_calkowita<std::int32_t>(n, n, ziarno++, -100000, 100000);
+        SPRAWDZ(iloczyn_calkowity_zgodny(A32, A32));
+        const auto A64 = losowa_calkowita<std::int64_t>(n, 2, ziarno++, -1000, 1000);
+        const auto B64 = losowa_calkowita<std::int64_t>(2, n, ziarno++, -1000, 1000);
+        SPRAWDZ(iloczyn_calkowity_zgodny(A64, B64));
+    }
+    // najwieksze k, dla ktorego suma int8 miesci sie w int32: k * 128^2 < 2^31
+    const std::size_t k = 131071;
+    const matrix_i8 A(2, k, std::int8_t(-128)), B(k, 3, std::int8_t(-128));
+    SPRAWDZ(A * B == matrix_i32(2, 3, std::int32_t(k * 16384)));
+}
+
+TEST(gemm_float_akumulacja) {
+    const std::size_t k = 700;
+    const matrix A = test::losowa(23, k, 71), B = test::losowa(k, 19, 72);
+    const matrix wzorzec = test::naiwny_iloczyn(A, B);
+    const matrix_f32 Af(A), Bf(B);
+    // wzorzec liczony na wartosciach float, zeby mierzyc tylko blad sumowania
+    const matrix wzorzec_f = test::naiwny_iloczyn(matrix(Af), matrix(Bf));
+    const double u = 1.0 / (1 << 24);
+    const double granice[] = {k * u, 2 * u + 1e-12, 2 * u, 45 * u};
+    const acc_policy polityki[] = {acc_policy::f32, acc_policy::f64, acc_policy::kahan, acc_policy::pairwise};
+    for (int p = 0; p < 4; ++p) {
+        const matrix C(multiply(Af, Bf, polityki[p]));
+        // bledy wzgledem |A| |B| <= k; z zapasem dla sumy modulow
+        SPRAWDZ(test::max_roznica(C, wzorzec_f) <= granice[p] * k);
+    }
+    SPRAWDZ(test::max_roznica(matrix(Af * Bf), wzorzec_f) <= k * u * k);
+    SPRAWDZ(test::max_roznica(wzorzec_f, wzorzec) <= 1e-4);
+}
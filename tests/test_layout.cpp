@@ -0,0 +1,52 @@
+#include "test.h"
+#include "../include/layout_matrix.h"
+#include <algorithm>
+#include <cmath>
+
+// Wszystkie uklady pamieci musza dawac te same elementy i wyniki co matrix.
+
+namespace {
+
+const storage_layout uklady[] = {storage_layout::row_major, storage_layout::col_major, storage_layout::tiled};
+
+} // namespace
+
+TEST(layout_konwersje) {
+    // 300 nie jest wielokrotnoscia kafla, wiec kafle brzegowe sa niepelne
+    const matrix M = test::losowa(300, 141, 1);
+    for (storage_layout u : uklady) {
+        const layout_matrix L(M, u);
+        SPRAWDZ(L.to_matrix() == M);
+        SPRAWDZ(L(299, 140) == M(299, 140) && L(128, 127) == M(128, 127));
+        for (storage_layout v : uklady) SPRAWDZ(L.to_layout(v).to_matrix() == M);
+        SPRAWDZ(L == layout_matrix(M, storage_layout::row_major));
+    }
+}
+
+TEST(layout_dzialania) {
+    const matrix A = test::losowa(150, 130, 2), B = test::losowa(130, 270, 3), C = test::losowa(150, 130, 4);
+    const matrix AB = test::naiwny_iloczyn(A, B);
+    for (storage_layout u : uklady) {
+        const layout_matrix LA(A, u), LC(C, u);
+        for (storage_layout v : uklady) {
+            SPRAWDZ(test::max_roznica((LA * layout_matrix(B, v)).to_matrix(), AB) <= 1e-13);
+            SPRAWDZ(test::max_roznica((LA + layout_matrix(C, v)).to_matrix(), matrix(A + C)) == 0.0);
+        }
+        SPRAWDZ(test::max_roznica((LA - LC).to_matrix(), matrix(A - C)) == 0.0);
+        SPRAWDZ(test::max_roznica((2.0 * LA).to_matrix(), matrix(A * 2.0)) == 0.0);
+
+        const std::vector<double> w = LA.row_sums(), k = LA.col_sums();
+        double e = 0.0;
+        for (std::size_t i = 0; i < 150; ++i) {
+            double s = 0.0;
+            for (std::size_t j = 0; j < 130; ++j) s += A(i, j);
+            e = std::max(e, std::fabs(s - w[i]));
+        }
+        for (std::size_t j = 0; j < 130; ++j) {
+            double s = 0.0;
+            for (std::size_t i = 0; i < 150; ++i) s += A(i, j);
+            e = std::max(e, std::fabs(s - k[j]));
+        }
+        SPRAWDZ(e <= 1e-12);
+    }
+}
@@ -0,0 +1,39 @@
+#include "test.h"
+#include "../include/quantized_matrix.h"
+#include <cmath>
+
+// Kwantyzacja int8: blad zaokraglenia co najwyzej pol skali, a iloczyn
+// skwantowany rowny iloczynowi zdekwantyzowanych operandow.
+
+TEST(quantized_kwantyzacja) {
+    const matrix M = test::losowa(37, 70, 1, -3.0, 5.0);
+    for (quant_axis os : {quant_axis::per_row, quant_axis::per_col}) {
+        const quantized_matrix q = quantize(M, os);
+        const matrix D = dequantize(q);
+        bool zgodna = D.get_rows() == 37 && D.get_cols() == 70;
+        for (std::size_t i = 0; zgodna && i < 37; ++i) {
+            for (std::size_t j = 0; j < 70; ++j) {
+                const double s = q.scales()[os == quant_axis::per_row ? i : j];
+                zgodna = zgodna && std::fabs(D(i, j) - M(i, j)) <= 0.5 * s * (1 + 1e-12);
+            }
+        }
+        SPRAWDZ(zgodna);
+    }
+    // wiersz zerowy nie moze dawac dzielenia przez zero
+    const matrix Z(3, 4);
+    SPRAWDZ(dequantize(quantize(Z, quant_axis::per_row)) == Z);
+}
+
+TEST(quantized_iloczyn) {
+    for (std::size_t k : {1, 2, 7, 64, 257, 1000}) {
+        const matrix A = test::losowa(19, k, k), B = test::losowa(k, 33, k + 1);
+        const quantized_matrix qA = quantize(A, quant_axis::per_row), qB = quantize(B, quant_axis::per_col);
+        // akumulacja int32 jest dokladna, wiec roznica to tylko zaokraglenia skal
+        const matrix wzorzec = test::naiwny_iloczyn(dequantize(qA), dequantize(qB));
+        SPRAWDZ(test::max_roznica(qA * qB, wzorzec) <= 1e-13 * static_cast<double>(k));
+        // i pozostaje blisko iloczynu w double
+        SPRAWDZ(test::max_roznica(qA * qB, test::naiwny_iloczyn(A, B)) <= 0.02 * std::sqrt(static_cast<double>(k)));
+    }
+    const matrix A = test::losowa(4, 4, 1);
+    SPRAWDZ_WYJATEK(quantize(A, quant_axis::per_col) * quantize(A, quant_axis::per_col));
+}
@@ -0,0 +1,100 @@
+#include "test.h"
+#include "../include/counter_rng.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Generator Philox: wektory kontrolne Random123, powtarzalnosc wypelnien
+// niezalezna od ISA i liczby watkow, zgodnosc generate() z operator().
+
+namespace {
+
+using blok = std::array<std::uint32_t, 4>;
+
+/// Blok Philox4x32-10 dla klucza (k0, k1) i licznika (c0, c1, c2, c3)
+blok philox(std::uint32_t k0, std::uint32_t k1, const blok& c) {
+    philox_rng g(std::uint64_t(k1) << 32 | k0, std::uint64_t(c[3]) << 32 | c[2]);
+    g.set_position(std::uint64_t(c[1]) << 32 | c[0]);
+    return g();
+}
+
+/// FNV-1a na bitach elementow (odcisk wypelnienia)
+template <typename T>
+std::uint64_t odcisk(const basic_matrix<T>& m) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (std::size_t i = 0; i < m.get_rows(); ++i) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(m.row_ptr(i));
+        for (std::size_t b = 0; b < m.get_cols() * sizeof(T); ++b) h = (h ^ p[b]) * 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace
+
+TEST(philox_wektory_kontrolne) {
+    // kat_vectors z Random123 1.09 (philox4x32_10)
+    SPRAWDZ((philox(0, 0, {0, 0, 0, 0}) == blok{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    SPRAWDZ((philox(0xffffffff, 0xffffffff, {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}) ==
+             blok{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    SPRAWDZ((philox(0xa4093822, 0x299f31d0, {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}) ==
+             blok{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(philox_generate_zgodny) {
+    // przejscie mlodszego slowa licznika przez 2^32 w srodku wektora
+    for (std::uint64_t start : {std::uint64_t(0), std::uint64_t(0xfffffff0), ~std::uint64_t(0) - 20}) {
+        philox_rng g(0x123456789abcdefull, 42), h(0x123456789abcdefull, 42);
+        g.set_position(start);
+        h.set_position(start);
+        std::vector<std::uint64_t> w(2 * 61);
+        g.generate(w.data(), 61);
+        bool zgodny = g.position() == start + 61;
+        for (std::size_t b = 0; b < 61; ++b) {
+            const blok x = h();
+            zgodny = zgodny && w[2 * b] == (std::uint64_t(x[1]) << 32 | x[0]) &&
+                     w[2 * b + 1] == (std::uint64_t(x[3]) << 32 | x[2]);
+        }
+        SPRAWDZ(zgodny);
+    }
+}
+
+TEST(philox_wypelnienia_powtarzalne) {
+    // odciski z przebiegu MATRIX_ISA=scalar MATRIX_THREADS=1; kazda inna
+    // ISA i liczba watkow musi dac te same bity
+    philox_rng g(2024, 7);
+    matrix U(131, 77);
+    fill_uniform(U, g, -2.0, 3.0);
+    matrix N(64, 33);
+    fill_normal(N, g, 1.0, 0.5);
+    matrix_i32 I(50, 51);
+    fill_integers(I, g, -1000, 1000);
+    matrix_f32 F(17, 9);
+    fill_uniform(F, g);
+    SPRAWDZ(odcisk(U) == 0x668bf75f912385e4ull);
+    SPRAWDZ(odcisk(N) == 0x7e4ba53ea1518037ull);
+    SPRAWDZ(odcisk(I) == 0x3a922eb02c2227eeull);
+    SPRAWDZ(odcisk(F) == 0x1724b618870ece78ull);
+    SPRAWDZ(g.position() == (131 * 77 + 1) / 2 + 64 * 33 / 2 + (50 * 51 + 1) / 2 + (17 * 9 + 1) / 2);
+
+    // zakresy i momenty
+    double s = 0.0, s2 = 0.0;
+    bool w_zakresie = true;
+    for (std::size_t i = 0; i < U.get_rows(); ++i) {
+        for (std::size_t j = 0; j < U.get_cols(); ++j) w_zakresie = w_zakresie && U(i, j) >= -2.0 && U(i, j) < 3.0;
+    }
+    for (std::size_t i = 0; i < I.get_rows(); ++i) {
+        for (std::size_t j = 0; j < I.get_cols(); ++j) w_zakresie = w_zakresie && I(i, j) >= -1000 && I(i, j) <= 1000;
+    }
+    for (std::size_t i = 0; i < N.get_rows(); ++i) {
+        for (std::size_t j = 0; j < N.get_cols(); ++j) {
+            s += N(i, j);
+            s2 += N(i, j) * N(i, j);
+        }
+    }
+    const double n = 64.0 * 33.0, srednia = s / n, wariancja = s2 / n - srednia * srednia;
+    SPRAWDZ(w_zakresie);
+    SPRAWDZ(std::fabs(srednia - 1.0) < 0.05 && std::fabs(wariancja - 0.25) < 0.03);
+
+    SPRAWDZ_WYJATEK(fill_integers(I, g, 5, 4));
+}
@@ -0,0 +1,83 @@
+#include "test.h"
+#include "../include/semiring.h"
+#include <cmath>
+#include <limits>
+
+// Iloczyn w poliercieniu porownywany z potrojna petla na S::add / S::mul.
+
+namespace {
+
+template <typename S>
+matrix naiwny_iloczyn_w(const matrix& A, const matrix& B) {
+    matrix C(A.get_rows(), B.get_cols(), S::zero);
+    for (std::size_t i = 0; i < A.get_rows(); ++i) {
+        for (std::size_t j = 0; j < B.get_cols(); ++j) {
+            double s = S::zero;
+            for (std::size_t p = 0; p < A.get_cols(); ++p) s = S::add(s, S::mul(A(i, p), B(p, j)));
+            C(i, j) = s;
+        }
+    }
+    return C;
+}
+
+template <typename S>
+bool zgodny(const matrix& A, const matrix& B, double tol) {
+    const matrix C = multiply(A, B, S{}), W = naiwny_iloczyn_w<S>(A, B);
+    if (C.get_rows() != W.get_rows() || C.get_cols() != W.get_cols()) return false;
+    for (std::size_t i = 0; i < C.get_rows(); ++i) {
+        for (std::size_t j = 0; j < C.get_cols(); ++j) {
+            // nieskonczonosci (brak sciezki) musza sie zgadzac dokladnie
+            if (C(i, j) != W(i, j) && !(std::fabs(C(i, j) - W(i, j)) <= tol)) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(semiring_iloczyny) {
+    const double inf = std::numeric_limits<double>::infinity();
+    for (std::size_t n : {1, 3, 8, 17, 70, 300}) {
+        const matrix A = test::losowa(n, n + 2, n, 0.0, 10.0), B = test::losowa(n + 2, n + 5, n + 7, 0.0, 10.0);
+        matrix Ainf = A;
+        for (std::size_t i = 0; i < n; ++i) Ainf(i, (i * 7) % (n + 2)) = inf;
+        SPRAWDZ(zgodny<min_plus>(A, B, 0.0));
+        SPRAWDZ(zgodny<min_plus>(Ainf, B, 0.0));
+        SPRAWDZ(zgodny<max_plus>(A, B, 0.0));
+        SPRAWDZ(zgodny<plus_times>(A, B, 1e-13 * static_cast<double>(n + 2)));
+    }
+    SPRAWDZ_WYJATEK(multiply(test::losowa(3, 4, 1), test::losowa(3, 4, 2), min_plus{}));
+    // pusty wspolny wymiar daje zero polpierscienia
+    SPRAWDZ(multiply(matrix(3, 0), matrix(0, 4), min_plus{}) == matrix(3, 4, inf));
+}
+
+TEST(semiring_najkrotsze_sciezki) {
+    // kwadrat macierzy odleglosci w (min, +) skraca sciezki o jedna krawedz
+    const double inf = std::numeric_limits<double>::infinity();
+    const matrix D = {{0, 4, inf, inf}, {inf, 0, 1, inf}, {inf, inf, 0, 2}, {1, inf, inf, 0}};
+    const matrix D2 = multiply(D, D, min_plus{});
+    SPRAWDZ(D2(0, 2) == 5.0 && D2(1, 3) == 3.0 && D2(0, 3) == inf && D2(3, 1) == 5.0);
+}
+
+TEST(semiring_or_and) {
+    for (std::size_t n : {1, 7, 64, 130}) {
+        // elementy rozne od zera (takze ujemne) sa prawda
+        matrix A = test::losowa(n, n + 3, n), B = test::losowa(n + 3, n + 1, n + 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n + 3; ++j) A(i, j) = A(i, j) < 0.9 ? 0.0 : -2.5;
+        }
+        for (std::size_t i = 0; i < n + 3; ++i) {
+            for (std::size_t j = 0; j < n + 1; ++j) B(i, j) = B(i, j) < 0.8 ? 0.0 : 3.0;
+        }
+        matrix A01 = A, B01 = B;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n + 3; ++j) A01(i, j) = A(i, j) != 0.0;
+        }
+        for (std::size_t i = 0; i < n + 3; ++i) {
+            for (std::size_t j = 0; j < n + 1; ++j) B01(i, j) = B(i, j) != 0.0;
+        }
+        const matrix C = multiply(A, B, or_and{});
+        SPRAWDZ(C == naiwny_iloczyn_w<or_and>(A01, B01));
+    }
+    SPRAWDZ_WYJATEK(multiply(test::losowa(3, 4, 1), test::losowa(3, 4, 2), or_and{}));
+}
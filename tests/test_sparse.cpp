@@ -0,0 +1,69 @@
+#include "test.h"
+#include "../include/sparse_matrix.h"
+#include <random>
+#include <vector>
+
+// Macierze rzadkie porownywane z tymi samymi dzialaniami na macierzach gestych.
+
+namespace {
+
+matrix rzadka_gesta(std::size_t rows, std::size_t cols, double gestosc, std::uint64_t ziarno) {
+    matrix m = test::losowa(rows, cols, ziarno);
+    std::mt19937_64 g(ziarno + 1);
+    std::uniform_real_distribution<double> d(0.0, 1.0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (d(g) >= gestosc) m(i, j) = 0.0;
+        }
+    }
+    return m;
+}
+
+} // namespace
+
+TEST(sparse_konwersje) {
+    const matrix M = rzadka_gesta(37, 53, 0.1, 1);
+    for (auto f : {sparse_format::csr, sparse_format::csc}) {
+        const sparse_matrix S(M, f);
+        SPRAWDZ(S.to_matrix() == M);
+        SPRAWDZ(S.to_csr().to_matrix() == M && S.to_csc().to_matrix() == M);
+        SPRAWDZ(S.transpose().to_matrix() == M.transpose().to_matrix());
+        SPRAWDZ(S(3, 4) == M(3, 4));
+    }
+}
+
+TEST(sparse_iloczyny) {
+    const matrix M = rzadka_gesta(61, 45, 0.15, 2), N = rzadka_gesta(45, 70, 0.2, 3);
+    const matrix G = test::losowa(45, 9, 4), H = test::losowa(5, 61, 5);
+    for (auto f : {sparse_format::csr, sparse_format::csc}) {
+        const sparse_matrix S(M, f), T(N, f);
+        SPRAWDZ(test::max_roznica(S * G, test::naiwny_iloczyn(M, G)) <= 1e-14);
+        SPRAWDZ(test::max_roznica(H * S, test::naiwny_iloczyn(H, M)) <= 1e-14);
+        SPRAWDZ(test::max_roznica((S * T).to_matrix(), test::naiwny_iloczyn(M, N)) <= 1e-14);
+
+        std::vector<double> x(45);
+        for (std::size_t i = 0; i < x.size(); ++i) x[i] = G(i, 0);
+        const std::vector<double> y = S * x;
+        bool zgodny = y.size() == 61;
+        for (std::size_t i = 0; zgodny && i < 61; ++i) {
+            double s = 0.0;
+            for (std::size_t j = 0; j < 45; ++j) s += M(i, j) * x[j];
+            zgodny = std::fabs(y[i] - s) <= 1e-14;
+        }
+        SPRAWDZ(zgodny);
+    }
+    SPRAWDZ_WYJATEK(sparse_matrix(M) * sparse_matrix(M));
+}
+
+TEST(sparse_sumy) {
+    const matrix M = rzadka_gesta(30, 40, 0.2, 6), N = rzadka_gesta(30, 40, 0.2, 7);
+    const sparse_matrix S(M), T(N, sparse_format::csc);
+    SPRAWDZ(test::max_roznica((S + T).to_matrix(), matrix(M + N)) == 0.0);
+    SPRAWDZ(test::max_roznica((S - T).to_matrix(), matrix(M - N)) == 0.0);
+    SPRAWDZ(test::max_roznica((2.0 * S).to_matrix(), matrix(M * 2.0)) == 0.0);
+    matrix iloczyn(30, 40);
+    for (std::size_t i = 0; i < 30; ++i) {
+        for (std::size_t j = 0; j < 40; ++j) iloczyn(i, j) = M(i, j) * N(i, j);
+    }
+    SPRAWDZ(test::max_roznica(hadamard(S, T).to_matrix(), iloczyn) == 0.0);
+}
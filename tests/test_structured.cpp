@@ -0,0 +1,64 @@
+#include "test.h"
+#include "../include/structured_matrix.h"
+#include <cmath>
+
+// Rozwiazania ukladow strukturalnych sprawdzane przez residuum A X - B,
+// iloczyny - przez macierze geste.
+
+namespace {
+
+/// Macierz z dominujaca przekatna, wiec uklady sa dobrze uwarunkowane
+matrix dominujaca(std::size_t n, std::uint64_t ziarno) {
+    matrix m = test::losowa(n, n, ziarno);
+    for (std::size_t i = 0; i < n; ++i) m(i, i) += static_cast<double>(n) + 1.0;
+    return m;
+}
+
+} // namespace
+
+TEST(structured_solve) {
+    for (std::size_t n : {1, 2, 7, 33, 100}) {
+        const matrix B = test::losowa(n, 5, n + 1);
+        const matrix M = dominujaca(n, n);
+
+        for (triangle t : {triangle::lower, triangle::upper}) {
+            const triangular_matrix T(M, t);
+            const matrix X = solve(T, B);
+            SPRAWDZ(test::max_roznica(test::naiwny_iloczyn(T.to_matrix(), X), B) <= 1e-12);
+            SPRAWDZ(test::max_roznica(T * X, B) <= 1e-12);
+        }
+
+        const std::size_t kl = n > 3 ? 3 : 0, ku = n > 2 ? 1 : 0;
+        const banded_matrix P(M, kl, ku);
+        const matrix X = solve(P, B);
+        SPRAWDZ(test::max_roznica(test::naiwny_iloczyn(P.to_matrix(), X), B) <= 1e-12);
+
+        const diagonal_matrix D(M);
+        SPRAWDZ(test::max_roznica(test::naiwny_iloczyn(D.to_matrix(), solve(D, B)), B) <= 1e-14);
+    }
+}
+
+TEST(structured_iloczyny) {
+    const matrix M = test::losowa(40, 40, 9), G = test::losowa(40, 13, 10);
+    const banded_matrix P(M, 2, 5);
+    SPRAWDZ(test::max_roznica(P * G, test::naiwny_iloczyn(P.to_matrix(), G)) <= 1e-14);
+    SPRAWDZ(test::max_roznica((P * P).to_matrix(), test::naiwny_iloczyn(P.to_matrix(), P.to_matrix())) <= 1e-14);
+    const triangular_matrix L(M, triangle::lower), U(M, triangle::upper);
+    SPRAWDZ(test::max_roznica((L * L).to_matrix(), test::naiwny_iloczyn(L.to_matrix(), L.to_matrix())) <= 1e-13);
+    SPRAWDZ(test::max_roznica(U * G, test::naiwny_iloczyn(U.to_matrix(), G)) <= 1e-13);
+
+    const matrix A = test::losowa(30, 17, 11);
+    SPRAWDZ(test::max_roznica(syrk(A).to_matrix(), test::naiwny_iloczyn(A, A.transpose())) <= 1e-13);
+    SPRAWDZ(test::max_roznica(syrk(A, trans::transpose).to_matrix(),
+                              test::naiwny_iloczyn(A.transpose(), A)) <= 1e-13);
+    const symmetric_matrix S = syrk(A);
+    SPRAWDZ(test::max_roznica(S * test::losowa(30, 4, 12),
+                              test::naiwny_iloczyn(S.to_matrix(), test::losowa(30, 4, 12))) <= 1e-13);
+}
+
+TEST(structured_osobliwa) {
+    matrix M = dominujaca(5, 13);
+    M(2, 2) = 0.0;
+    SPRAWDZ_WYJATEK(solve(triangular_matrix(M, triangle::lower), test::losowa(5, 1, 14)));
+    SPRAWDZ_WYJATEK(solve(diagonal_matrix(M), test::losowa(5, 1, 14)));
+}
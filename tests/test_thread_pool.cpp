@@ -0,0 +1,31 @@
+#include "test.h"
+#include "../include/thread_pool.h"
+#include <atomic>
+#include <stdexcept>
+
+// Pula watkow: zmiana liczby watkow z zewnatrz i odrzucenie jej z wnetrza zadania.
+
+TEST(pula_set_threads) {
+    auto& pula = thread_pool::instance();
+    const std::size_t watki = pula.get_threads();
+    if (watki > 1) {
+        // z wnetrza zadania set_threads czekaloby na zakonczenie samego siebie
+        std::atomic<int> odrzucone{0};
+        pula.parallel_for(8, [&](std::size_t) {
+            try {
+                pula.set_threads(2);
+            } catch (const std::runtime_error&) {
+                ++odrzucone;
+            }
+        });
+        SPRAWDZ(odrzucone == 8 && pula.get_threads() == watki);
+    }
+
+    const matrix A = test::losowa(90, 70, 1), B = test::losowa(70, 80, 2);
+    const matrix wzorzec = test::naiwny_iloczyn(A, B);
+    for (std::size_t n : {std::size_t(3), std::size_t(1), watki}) {
+        pula.set_threads(n);
+        SPRAWDZ(pula.get_threads() == n);
+        SPRAWDZ(test::max_roznica(A * B, wzorzec) <= 1e-13);
+    }
+}